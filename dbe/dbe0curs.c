@@ -829,8 +829,12 @@ dbe_ret_t dbe_cursor_nextorprev_n(
                            vb);
         } else {
             ss_dassert(dbe_search_gettype(cursor) == DBE_SEARCH_DBE);
-            rc = DBE_ERR_FAILED;
-            ss_error;
+            dbe_trx_setflag(trx, TRX_FLAG_DTABLE);
+            rc = dbe_search_nextorprev_n(
+                    (dbe_search_t*)cursor,
+                    trx,
+                    nextp,
+                    vb);
         }
 
         switch (rc) {
@@ -222,6 +222,12 @@ bool                sqlsrv_isbackupservermode = FALSE;   /* Start the server wit
 #define DB_FORCEMERGEINTERVAL   (200 * 1024 * 1024)
 #define DB_MERGEFIXEDRATE       1
 
+/* Max number of online defragmentation candidates collected at a time. */
+#define DB_DEFRAG_MAXNODES      10000
+/* Max number of times a candidate is skipped because it is changed in
+   the current checkpoint. */
+#define DB_DEFRAG_MAXRETRY      2
+
 extern bool dbefile_diskless;
 extern long backup_blocksize;
 #ifdef DBE_BNODE_MISMATCHARRAY /* This needs more testimg. */
@@ -1016,6 +1022,9 @@ dbe_db_t* dbe_db_init(
         db->db_actiongate = su_gate_init(
                 SS_SEMNUM_DBE_DB_ACTIONGATE,
                 FALSE);
+        /* Action gate is entered shared on every row operation and
+           exclusively only by checkpoint, so use big reader mode. */
+        su_gate_setbigreader(db->db_actiongate);
         db->db_users = su_pa_init();
         db->db_nsearchsem = SsSemCreateLocal(SS_SEMNUM_DBE_DB_NSEARCH);
         db->db_nsearch = 0;
@@ -1033,6 +1042,13 @@ dbe_db_t* dbe_db_init(
         db->db_changed = FALSE;
         db->db_force_checkpoint = FALSE;
         db->db_final_checkpoint = 0;
+        db->db_defragactive = FALSE;
+        db->db_defragpos = SU_DADDR_NULL;
+        db->db_defragnodes = NULL;
+        db->db_defragmore = FALSE;
+        db->db_defragwaitcpnum = DBE_CPNUM_NULL;
+        db->db_defragnscanned = 0;
+        db->db_defragnmoved = 0;
         db->db_changedsem = SsSemCreateLocal(SS_SEMNUM_DBE_DB_CHANGED);
         db->db_dropcardinallist = NULL;
 
@@ -1866,6 +1882,9 @@ void dbe_db_done(dbe_db_t* db)
         if (db->db_dropcardinallist != NULL) {
             su_list_done(db->db_dropcardinallist);
         }
+        if (db->db_defragnodes != NULL) {
+            su_rbt_done(db->db_defragnodes);
+        }
         dbe_gobj_done(db->db_go);
 
         su_param_manager_save();
@@ -5099,6 +5118,15 @@ dbe_ret_t dbe_db_createcp_end(
         dbe_file_saveheaders(db->db_dbfile);
         DBE_CPMGR_CRASHPOINT(19);
 
+        /* Both headers now have the file size of the new checkpoint,
+         * so blocks cut off by dbe_fl_shrink can be removed from the file.
+         * A failed truncate only leaves unused blocks at the file end.
+         */
+        rc = dbe_fl_truncatefile(db->db_dbfile->f_indexfile->fd_freelist);
+        if (rc != SU_SUCCESS) {
+            ss_dprintf_1(("dbe_db_createcp_end:dbe_fl_truncatefile failed, rc=%d\n", rc));
+        }
+
         /* Delete earlier checkpoints
          */
         prev_cpnum = dbe_cpmgr_prevcheckpoint(db->db_cpmgr, cpnum - 1);
@@ -9429,6 +9457,7 @@ void dbe_db_getstat(
         dbe_dbstat_t* p_dbst)
 {
         dbe_cache_info_t cache_info;
+        dbe_fl_fragstat_t fragstat;
 
         CHK_DB(db);
         ss_dassert(p_dbst != NULL);
@@ -9436,6 +9465,10 @@ void dbe_db_getstat(
         dbe_cache_getinfo(
             db->db_dbfile->f_indexfile->fd_cache,
             &cache_info);
+        dbe_fl_getfragstat(
+            db->db_dbfile->f_indexfile->fd_freelist,
+            &fragstat,
+            FALSE);
 
         SsSemEnter(db->db_sem);
 
@@ -9461,6 +9494,8 @@ void dbe_db_getstat(
         p_dbst->dbst_ind_mergeact = (ulong)(db->db_indmerge != NULL || db->db_quickmerge != NULL);
         p_dbst->dbst_ind_filesize = dbe_db_getdbsize(db);
         p_dbst->dbst_ind_freesize = dbe_db_getdbfreesize(db);
+        p_dbst->dbst_ind_nearalloccnt = fragstat.fs_nnearalloc;
+        p_dbst->dbst_ind_faralloccnt = fragstat.fs_nfaralloc;
 
         if (db->db_dbfile->f_log == NULL) {
             /* Log is not used. */
@@ -9482,6 +9517,294 @@ void dbe_db_getstat(
         SsSemExit(db->db_sem);
 }
 
+/*##**********************************************************************\
+ *
+ *              dbe_db_defragstep
+ *
+ * Runs one step of online defragmentation. Permanent tree nodes at the
+ * end of the file are moved to the lowest free blocks of the file. The
+ * candidate nodes are collected by walking the permanent tree from its
+ * root, so blocks of other trees are never read as permanent tree
+ * nodes. The candidates are collected once per pass, at most
+ * DB_DEFRAG_MAXNODES highest addresses at a time, and kept in the
+ * database object between the steps. Each node is moved inside its own
+ * action with only the permanent tree locked, so user operations and
+ * checkpoints can run between nodes. Nodes that are changed in the
+ * current checkpoint are kept as candidates and tried again after the
+ * next checkpoint. The moved blocks become free after the next
+ * checkpoint, and the free blocks at the end of the file are cut off
+ * at the checkpoint after that.
+ *
+ * Parameters :
+ *
+ *      db - in, use
+ *              Database object.
+ *
+ *      maxblocks - in
+ *              Maximum number of tree nodes examined in this step.
+ *
+ *      p_nmoved - out
+ *              Number of nodes moved in this step.
+ *
+ * Return value :
+ *
+ *      DBE_RC_CONT       - more nodes to examine
+ *      DBE_RC_RETRY      - the remaining nodes are changed in the current
+ *                          checkpoint, continue after a checkpoint
+ *      DBE_RC_END        - nothing more can be moved towards the file start
+ *      DBE_ERR_DEFRAGACT - another defragmentation step is running
+ *      error code
+ *
+ * Comments :
+ *
+ *      Works only with a globally sorted free list. Other block types
+ *      than permanent tree nodes (BLOBs, Bonsai-tree, free list and
+ *      checkpoint blocks) are not moved.
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+dbe_ret_t dbe_db_defragstep(
+        dbe_db_t* db,
+        uint maxblocks,
+        ulong* p_nmoved)
+{
+        dbe_freelist_t* fl;
+        dbe_btree_t* permtree;
+        dbe_fl_shrinkstat_t ss;
+        su_rbt_t* nodes;
+        su_rbt_t* newnodes;
+        su_rbt_node_t* rbtn;
+        su_rbt_node_t* prevrbtn;
+        dbe_btree_relocnode_t* rn;
+        dbe_btree_relocnode_t searchrn;
+        su_daddr_t pos;
+        su_daddr_t addr;
+        su_daddr_t newaddr;
+        bool more;
+        uint nscanned = 0;
+        dbe_ret_t rc = DBE_RC_CONT;
+
+        CHK_DB(db);
+        ss_dprintf_1(("dbe_db_defragstep:maxblocks=%u\n", maxblocks));
+
+        *p_nmoved = 0;
+        fl = db->db_go->go_idxfd->fd_freelist;
+        permtree = dbe_index_getpermtree(db->db_index);
+
+        SsSemEnter(db->db_sem);
+        if (db->db_defragactive) {
+            SsSemExit(db->db_sem);
+            return(DBE_ERR_DEFRAGACT);
+        }
+        db->db_defragactive = TRUE;
+        nodes = db->db_defragnodes;
+        pos = db->db_defragpos;
+        more = db->db_defragmore;
+        SsSemExit(db->db_sem);
+
+        if (!dbe_db_setchanged(db, NULL)) {
+            rc = DBE_ERR_DBREADONLY;
+        }
+
+        while (rc == DBE_RC_CONT && nscanned < maxblocks) {
+            /* Next candidate at or below the scan position. */
+            rbtn = NULL;
+            if (nodes != NULL) {
+                if (pos == SU_DADDR_NULL) {
+                    rbtn = su_rbt_max(nodes, NULL);
+                } else {
+                    searchrn.rn_addr = pos;
+                    rbtn = su_rbt_search_atmost(nodes, &searchrn);
+                }
+            }
+            if (rbtn == NULL) {
+                if (nodes == NULL || more) {
+                    /* Collect the next candidates below the scan position.
+                     * The free list is read inside the action so that
+                     * a checkpoint cannot shrink the file meanwhile.
+                     */
+                    dbe_db_enteraction(db, NULL);
+                    if (!dbe_fl_getshrinkstat(fl, &ss)) {
+                        ss.ss_lastbusy = SU_DADDR_NULL;
+                    }
+                    if (ss.ss_lastbusy == SU_DADDR_NULL) {
+                        pos = SU_DADDR_NULL;
+                    } else if (pos == SU_DADDR_NULL || pos > ss.ss_lastbusy) {
+                        pos = ss.ss_lastbusy;
+                    }
+                    if (pos == SU_DADDR_NULL
+                        || ss.ss_firstfree == SU_DADDR_NULL
+                        || ss.ss_firstfree >= pos)
+                    {
+                        /* No free block below, the file is compact up
+                         * to here.
+                         */
+                        newnodes = dbe_btree_getrelocatenodes(permtree, 0, 0, 0);
+                    } else {
+                        newnodes = dbe_btree_getrelocatenodes(
+                                        permtree,
+                                        ss.ss_firstfree + 1,
+                                        pos,
+                                        DB_DEFRAG_MAXNODES);
+                    }
+                    dbe_db_exitaction(db, NULL);
+                    more = su_rbt_nelems(newnodes) == DB_DEFRAG_MAXNODES;
+                    if (nodes == NULL) {
+                        nodes = newnodes;
+                    } else {
+                        while ((rbtn = su_rbt_min(newnodes, NULL)) != NULL) {
+                            rn = su_rbt_delete_nodatadel(newnodes, rbtn);
+                            su_rbt_insert(nodes, rn);
+                        }
+                        su_rbt_done(newnodes);
+                    }
+                    if (pos == SU_DADDR_NULL) {
+                        rc = DBE_RC_END;
+                    }
+                } else if (su_rbt_nelems(nodes) == 0) {
+                    rc = DBE_RC_END;
+                } else if (db->db_defragwaitcpnum
+                           == dbe_counter_getcpnum(db->db_go->go_ctr))
+                {
+                    /* Only nodes changed in the current checkpoint left. */
+                    rc = DBE_RC_RETRY;
+                } else {
+                    /* Try the skipped nodes again from the top. */
+                    pos = SU_DADDR_NULL;
+                }
+                continue;
+            }
+
+            rn = su_rbtnode_getkey(rbtn);
+            addr = rn->rn_addr;
+            dbe_db_enteraction(db, NULL);
+            if (!dbe_fl_getshrinkstat(fl, &ss)
+                || ss.ss_firstfree == SU_DADDR_NULL
+                || ss.ss_firstfree >= addr)
+            {
+                dbe_db_exitaction(db, NULL);
+                /* No free block below this node, so none of the
+                 * candidates below it can be moved either.
+                 */
+                while ((prevrbtn = su_rbt_pred(nodes, rbtn)) != NULL) {
+                    su_rbt_delete(nodes, prevrbtn);
+                }
+                su_rbt_delete(nodes, rbtn);
+                more = FALSE;
+                continue;
+            }
+            rc = dbe_btree_relocatenode(permtree, rn, &newaddr);
+            if (rc == DBE_RC_RETRY) {
+                db->db_defragwaitcpnum = dbe_counter_getcpnum(db->db_go->go_ctr);
+            }
+            dbe_db_exitaction(db, NULL);
+            nscanned++;
+            pos = addr - 1;
+            switch (rc) {
+                case DBE_RC_RETRY:
+                    if (++rn->rn_nretry > DB_DEFRAG_MAXRETRY) {
+                        /* The node is changed in every checkpoint. */
+                        su_rbt_delete(nodes, rbtn);
+                    }
+                    rc = DBE_RC_CONT;
+                    break;
+                case DBE_RC_SUCC:
+                    su_rbt_delete(nodes, rbtn);
+                    if (newaddr != SU_DADDR_NULL) {
+                        ss_dprintf_2(("dbe_db_defragstep:%ld -> %ld\n",
+                                      (long)addr, (long)newaddr));
+                        (*p_nmoved)++;
+                        SS_PMON_ADD(SS_PMON_DBDEFRAGMOVE);
+                    }
+                    rc = DBE_RC_CONT;
+                    break;
+                default:
+                    break;
+            }
+        }
+        if (rc != DBE_RC_CONT && rc != DBE_RC_RETRY) {
+            /* The pass is over, the next step starts a new one. */
+            if (nodes != NULL) {
+                su_rbt_done(nodes);
+                nodes = NULL;
+            }
+            pos = SU_DADDR_NULL;
+            more = FALSE;
+        }
+
+        SsSemEnter(db->db_sem);
+        db->db_defragnodes = nodes;
+        db->db_defragpos = pos;
+        db->db_defragmore = more;
+        db->db_defragnscanned += nscanned;
+        db->db_defragnmoved += *p_nmoved;
+        db->db_defragactive = FALSE;
+        SsSemExit(db->db_sem);
+
+        return(rc);
+}
+
+/*##**********************************************************************\
+ *
+ *              dbe_db_getdefragstat
+ *
+ * Stores online defragmentation progress into *p_dfs.
+ *
+ * Parameters :
+ *
+ *      db - in
+ *              Database object.
+ *
+ *      p_dfs - out
+ *              Defragmentation progress is stored into *p_dfs.
+ *
+ * Return value :
+ *
+ * Comments :
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+void dbe_db_getdefragstat(
+        dbe_db_t* db,
+        dbe_defragstat_t* p_dfs)
+{
+        dbe_fl_shrinkstat_t ss;
+        dbe_fl_fragstat_t fragstat;
+
+        CHK_DB(db);
+
+        memset(p_dfs, 0, sizeof(dbe_defragstat_t));
+        dbe_fl_getfragstat(
+            db->db_go->go_idxfd->fd_freelist,
+            &fragstat,
+            TRUE);
+        p_dfs->dfs_freeranges = fragstat.fs_nranges;
+        p_dfs->dfs_freemaxrange = fragstat.fs_maxrange;
+        p_dfs->dfs_supported = dbe_fl_getshrinkstat(
+                                    db->db_go->go_idxfd->fd_freelist,
+                                    &ss);
+        if (p_dfs->dfs_supported) {
+            p_dfs->dfs_filesize = ss.ss_filesize;
+            p_dfs->dfs_lastbusy = ss.ss_lastbusy;
+            p_dfs->dfs_firstfree = ss.ss_firstfree;
+            p_dfs->dfs_freeblocks = (ulong)ss.ss_freeblocks;
+            p_dfs->dfs_nshrunk = ss.ss_nshrunk;
+        }
+
+        SsSemEnter(db->db_sem);
+        p_dfs->dfs_active = db->db_defragactive;
+        p_dfs->dfs_scanpos = db->db_defragpos == SU_DADDR_NULL
+                             ? p_dfs->dfs_lastbusy
+                             : db->db_defragpos;
+        p_dfs->dfs_nscanned = db->db_defragnscanned;
+        p_dfs->dfs_nmoved = db->db_defragnmoved;
+        SsSemExit(db->db_sem);
+}
+
 #endif /* SS_LIGHT */
 
 #ifndef SS_NOLOGGING
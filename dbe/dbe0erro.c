@@ -598,6 +598,8 @@ copy or netcopy command"
       "Unknown encryption algorithm." },
 { DBE_ERR_NOTMYSQLDATABASEFILE, SU_RCTYPE_FATAL,    "DBE_ERR_NOTMYSQLDATABASEFILE",
     "Database is not created using solidDB for MySQL. Cannot open database." },
+{ DBE_ERR_DEFRAGACT,            SU_RCTYPE_ERROR,    "DBE_ERR_DEFRAGACT",
+      "Defragmentation is already active." },
 
 { MME_ERR_VALUE_TOO_LARGE,   SU_RCTYPE_ERROR,  "MME_ERR_VALUE_TOO_LARGE",
       "New row value too large for M-table." },
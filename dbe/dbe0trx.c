@@ -237,6 +237,24 @@ typedef struct {
         bool            wchk_escalated;
 } trx_writecheck_t;
 
+/* Check records of all types are allocated with the same size. Records
+ * released at the end of a transaction are kept in trx->trx_chkcache
+ * and reused for any check type in the next transaction that uses the
+ * same transaction buffer.
+ */
+typedef union trx_chkrec_un trx_chkrec_t;
+
+union trx_chkrec_un {
+        trx_keycheck_t      cr_kchk;
+#ifndef SS_NOTRXREADCHECK
+        trx_readcheck_t     cr_rchk;
+#endif /* SS_NOTRXREADCHECK */
+        trx_writecheck_t    cr_wchk;
+        trx_chkrec_t*       cr_next;    /* Next record in trx_chkcache. */
+};
+
+#define TRX_CHKCACHE_MAXLEN     256
+
 typedef struct {
         dbe_trxid_t gs_stmttrxid;
         bool        gs_delaystmtcommit;
@@ -288,7 +306,7 @@ static void trx_addreadcheck_nomutex(
  *
  * See also :
  */
-static void keychk_done(void* data)
+static void keychk_release(void* data)
 {
         trx_keycheck_t* kchk = data;
 
@@ -302,7 +320,12 @@ static void keychk_done(void* data)
         }
         dynvtpl_free(&kchk->kchk_rangemin);
         dynvtpl_free(&kchk->kchk_rangemax);
-        SsMemFree(kchk);
+}
+
+static void keychk_done(void* data)
+{
+        keychk_release(data);
+        SsMemFree(data);
 }
 
 #ifndef SS_NOTRXREADCHECK
@@ -325,7 +348,7 @@ static void keychk_done(void* data)
  *
  * See also :
  */
-static void readchk_done(void* data)
+static void readchk_release(void* data)
 {
         trx_readcheck_t* rchk = data;
 
@@ -333,7 +356,12 @@ static void readchk_done(void* data)
 
         rs_pla_done(rchk->rchk_cd, rchk->rchk_plan);
         dynvtpl_free(&rchk->rchk_lastkey);
-        SsMemFree(rchk);
+}
+
+static void readchk_done(void* data)
+{
+        readchk_release(data);
+        SsMemFree(data);
 }
 #endif /* SS_NOTRXREADCHECK */
 
@@ -356,7 +384,7 @@ static void readchk_done(void* data)
  *
  * See also :
  */
-static void writechk_done(void* data)
+static void writechk_release(void* data)
 {
         trx_writecheck_t* wchk = data;
 
@@ -367,7 +395,138 @@ static void writechk_done(void* data)
         }
         dynvtpl_free(&wchk->wchk_minkey);
         dynvtpl_free(&wchk->wchk_maxkey);
-        SsMemFree(wchk);
+}
+
+static void writechk_done(void* data)
+{
+        writechk_release(data);
+        SsMemFree(data);
+}
+
+/*#***********************************************************************\
+ *
+ *              trx_chkrec_alloc
+ *
+ * Allocates memory for a read, write or key check record. A record
+ * is taken from the check record cache of the transaction if there
+ * is one. Records are released with the check list delete function
+ * or put back to the cache by trx_chklist_done.
+ *
+ * Parameters :
+ *
+ *      trx - in out, use
+ *              Transaction handle.
+ *
+ * Return value - give :
+ *
+ *      Uninitialized check record.
+ *
+ * Comments :
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+static void* trx_chkrec_alloc(dbe_trx_t* trx)
+{
+        trx_chkrec_t* cr;
+
+        cr = trx->trx_chkcache;
+        if (cr != NULL) {
+            ss_dassert(trx->trx_chkcachelen > 0);
+            trx->trx_chkcache = cr->cr_next;
+            trx->trx_chkcachelen--;
+            SS_PMON_ADD(SS_PMON_TRXCHKREUSE);
+        } else {
+            ss_dassert(trx->trx_chkcachelen == 0);
+            cr = SsMemAlloc(sizeof(trx_chkrec_t));
+            SS_PMON_ADD(SS_PMON_TRXCHKALLOC);
+        }
+        return(cr);
+}
+
+/*#***********************************************************************\
+ *
+ *              trx_chkcache_done
+ *
+ * Releases all check records in the check record cache of the
+ * transaction.
+ *
+ * Parameters :
+ *
+ *      trx - in out, use
+ *              Transaction handle.
+ *
+ * Return value :
+ *
+ * Comments :
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+static void trx_chkcache_done(dbe_trx_t* trx)
+{
+        trx_chkrec_t* cr;
+
+        while ((cr = trx->trx_chkcache) != NULL) {
+            trx->trx_chkcache = cr->cr_next;
+            SsMemFree(cr);
+        }
+        trx->trx_chkcachelen = 0;
+}
+
+/*#***********************************************************************\
+ *
+ *              trx_chklist_done
+ *
+ * Releases a check list at the end of the transaction. If the
+ * transaction buffer is kept for the next transaction, the check
+ * records are put to the check record cache instead of freeing them.
+ *
+ * Parameters :
+ *
+ *      trx - in out, use
+ *              Transaction handle.
+ *
+ *      list - in out, use
+ *              Check list.
+ *
+ *      release - in
+ *              Function that releases the contents of a check record.
+ *
+ *      keep - in
+ *              If TRUE, records are cached for the next transaction.
+ *
+ * Return value :
+ *
+ * Comments :
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+static void trx_chklist_done(
+        dbe_trx_t* trx,
+        su_list_t* list,
+        void (*release)(void* data),
+        bool keep)
+{
+        su_list_node_t* node;
+        trx_chkrec_t* cr;
+
+        while ((node = su_list_first(list)) != NULL) {
+            cr = su_list_remove_nodatadel(list, node);
+            (*release)(cr);
+            if (keep && trx->trx_chkcachelen < TRX_CHKCACHE_MAXLEN) {
+                cr->cr_next = trx->trx_chkcache;
+                trx->trx_chkcache = cr;
+                trx->trx_chkcachelen++;
+            } else {
+                SsMemFree(cr);
+            }
+        }
+        su_list_donebuf(list);
 }
 
 /*#***********************************************************************\
@@ -429,11 +588,14 @@ static void trx_freemem(dbe_trx_t* trx, bool istrxbuf, bool issoft)
             trx->trx_mmll = NULL;
         }
 
-        su_list_donebuf(&trx->trx_writechklist);
-        su_list_donebuf(&trx->trx_keychklist);
+        trx_chklist_done(trx, &trx->trx_writechklist, writechk_release, istrxbuf && issoft);
+        trx_chklist_done(trx, &trx->trx_keychklist, keychk_release, istrxbuf && issoft);
 #ifndef SS_NOTRXREADCHECK
-        su_list_donebuf(&trx->trx_readchklist);
+        trx_chklist_done(trx, &trx->trx_readchklist, readchk_release, istrxbuf && issoft);
 #endif /* SS_NOTRXREADCHECK */
+        if (!(istrxbuf && issoft)) {
+            trx_chkcache_done(trx);
+        }
 
         if (trx->trx_chksearch != NULL) {
             dbe_indvld_donebuf(trx->trx_chksearch);
@@ -1559,6 +1721,44 @@ static dbe_ret_t trx_validate_key_advance(
 
 #ifndef SS_NOTRXREADCHECK
 
+/*#***********************************************************************\
+ *
+ *              trx_readcheck_sortcmp
+ *
+ * Compare function used to sort read checks into key order before
+ * read set validation. The range start v-tuple begins with the key id,
+ * so checks are ordered first by key and then by key value.
+ *
+ * Parameters :
+ *
+ *      p1 - in
+ *              Pointer to the first read check pointer.
+ *
+ *      p2 - in
+ *              Pointer to the second read check pointer.
+ *
+ * Return value :
+ *
+ *      < 0, 0, > 0 as in qsort
+ *
+ * Limitations  :
+ *
+ * Globals used :
+ */
+static int SS_CDECL trx_readcheck_sortcmp(const void* p1, const void* p2)
+{
+        trx_readcheck_t* rchk1 = *(trx_readcheck_t**)p1;
+        trx_readcheck_t* rchk2 = *(trx_readcheck_t**)p2;
+        vtpl_t* vtpl1;
+        vtpl_t* vtpl2;
+        bool closed;
+
+        rs_pla_get_range_start(rchk1->rchk_cd, rchk1->rchk_plan, &vtpl1, &closed);
+        rs_pla_get_range_start(rchk2->rchk_cd, rchk2->rchk_plan, &vtpl2, &closed);
+
+        return(vtpl_compare(vtpl1, vtpl2));
+}
+
 /*#***********************************************************************\
  *
  *              trx_validate_read_init
@@ -1597,6 +1797,11 @@ static void trx_validate_read_init(
             /* There is a time range to validate.
              */
             ss_dprintf_4(("trx_validate_read_init:there is a time range\n"));
+            /* Checks are independent of each other, so validate them
+             * in key order. Consecutive searches then hit the same
+             * index leaves that are already in the cache.
+             */
+            su_list_sort(&trx->trx_readchklist, trx_readcheck_sortcmp);
             vi->vr_.node = su_list_first(&trx->trx_readchklist);
 
         } else {
@@ -1722,6 +1927,38 @@ static dbe_ret_t trx_validate_read_advance(
 
 #endif /* SS_NOTRXREADCHECK */
 
+/*#***********************************************************************\
+ *
+ *              trx_writecheck_sortcmp
+ *
+ * Compare function used to sort write checks into key order before
+ * write set validation. The key range minimum begins with the key id,
+ * so checks are ordered first by key and then by key value.
+ *
+ * Parameters :
+ *
+ *      p1 - in
+ *              Pointer to the first write check pointer.
+ *
+ *      p2 - in
+ *              Pointer to the second write check pointer.
+ *
+ * Return value :
+ *
+ *      < 0, 0, > 0 as in qsort
+ *
+ * Limitations  :
+ *
+ * Globals used :
+ */
+static int SS_CDECL trx_writecheck_sortcmp(const void* p1, const void* p2)
+{
+        trx_writecheck_t* wchk1 = *(trx_writecheck_t**)p1;
+        trx_writecheck_t* wchk2 = *(trx_writecheck_t**)p2;
+
+        return(vtpl_compare(wchk1->wchk_minkey, wchk2->wchk_minkey));
+}
+
 /*#***********************************************************************\
  *
  *              trx_validate_write_init
@@ -1777,7 +2014,11 @@ static void trx_validate_write_init(
         /* Above has a bad optimization, validate is always needed. Found
          * a bug when same transaction deletes the same row twice, e.g.
          * using CURRENT OF cursor. Happened only with late validate.
+         * Checks are validated in key order so that consecutive
+         * searches hit the same index leaves. The list is not needed
+         * in statement order any more after commit validation starts.
          */
+        su_list_sort(&trx->trx_writechklist, trx_writecheck_sortcmp);
         vi->vw_.node = su_list_first(&trx->trx_writechklist);
 #endif
 
@@ -2459,6 +2700,8 @@ static dbe_trx_t* trx_init(
         dbe_mmlocklst_t* mmll;
         dbe_trxinfo_t*  new_trxinfo;
         dbe_trxinfo_t*  cached_trxinfo;
+        void*           chkcache = NULL;
+        int             chkcachelen = 0;
 
         ss_dprintf_3(("trx_init, userid = %d\n", dbe_user_getid(user)));
         ss_dassert(user != NULL);
@@ -2501,7 +2744,11 @@ static dbe_trx_t* trx_init(
         }
         if (trxbuf != NULL) {
             trx = trxbuf;
+            chkcache = trx->trx_chkcache;
+            chkcachelen = trx->trx_chkcachelen;
             memset(trx, '\0', sizeof(dbe_trx_t));
+            trx->trx_chkcache = chkcache;
+            trx->trx_chkcachelen = chkcachelen;
         } else {
             trx = SsMemCalloc(sizeof(dbe_trx_t), 1);
         }
@@ -5021,6 +5268,7 @@ void dbe_trx_donebuf(
                                 trx->trx_infocache->ti_usertrxid));
             }
             trx->trx_infocache = NULL;
+            trx_chkcache_done(trx);
         } else {
             trx_freemem(trx, TRUE, issoft);
         }
@@ -6647,7 +6895,7 @@ static void trx_escalate_key(dbe_trx_t* trx, su_rbt_t* rbt, long keyid)
 
         /* Create new read check for the escalated range.
          */
-        new_rchk = SSMEM_NEW(trx_readcheck_t);
+        new_rchk = trx_chkrec_alloc(trx);
         new_rchk->rchk_stmttrxid = min_rchk->rchk_stmttrxid;
         new_rchk->rchk_cd = cd;
         new_rchk->rchk_plan = new_plan;
@@ -7327,7 +7575,7 @@ static void trx_addwritecheck(
         } else {
             /* Add a new write check.
              */
-            wchk = SSMEM_NEW(trx_writecheck_t);
+            wchk = trx_chkrec_alloc(trx);
 
             wchk->wchk_minkey = NULL;
             wchk->wchk_maxkey = NULL;
@@ -7888,7 +8136,7 @@ dbe_ret_t dbe_trx_adduniquecheck(
              */
             trx_keycheck_t* kchk;
 
-            kchk = SSMEM_NEW(trx_keycheck_t);
+            kchk = trx_chkrec_alloc(trx);
 
             kchk->kchk_type = DBE_KEYVLD_UNIQUE;
             kchk->kchk_rangemin = rangemin_dvtpl;
@@ -8268,7 +8516,7 @@ dbe_ret_t dbe_trx_addrefkeycheck(
 #endif /* SS_COLLATION */
         }
 
-        kchk = SSMEM_NEW(trx_keycheck_t);
+        kchk = trx_chkrec_alloc(trx);
 
         if (keytype == RS_KEY_PRIMKEYCHK) {
             /* Check that child key value does not exist. */
@@ -8356,7 +8604,7 @@ static void trx_addreadcheck_nomutex(
         ss_dprintf_2(("trx_addreadcheck_nomutex:add new read check, list len = %ld\n",
             (long)su_list_length(&trx->trx_readchklist)));
 
-        rchk = SSMEM_NEW(trx_readcheck_t);
+        rchk = trx_chkrec_alloc(trx);
 
         rchk->rchk_cd = trx->trx_cd;
         rchk->rchk_plan = plan;
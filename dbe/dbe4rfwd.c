@@ -51,7 +51,11 @@ Example:
 #include <ssc.h>
 #include <ssdebug.h>
 #include <ssmem.h>
+#include <sssem.h>
+#include <sstime.h>
+#include <ssthread.h>
 #include <ssservic.h>
+#include <ui0msg.h>
 #include <su0rbtr.h>
 #include <rs0rbuf.h>
 #include <rs0relh.h>
@@ -83,6 +87,18 @@ bool dbe_recoverignoretimestamps = FALSE; /* ignore timestamps during recovery *
 
 #ifndef SS_NOLOGGING
 
+#ifdef SS_MT
+/* Tuple operations of committed transactions are applied by parallel
+ * worker threads. Operations are partitioned by relation id so each
+ * relation is still applied in log order.
+ */
+#define RF_PARALLEL
+#endif /* SS_MT */
+
+#define RF_MAXWORKERS           32
+#define RF_MAXQUEUELEN          1024    /* queued operations per worker */
+#define RF_PROGRESSINTERVAL     10      /* seconds between progress reports */
+
 typedef enum {
         RFSTATE_START,
         RFSTATE_SCANNED,
@@ -1908,6 +1924,579 @@ rs_entname_t* rollfwd_viewnamebyid(dbe_rollfwd_t* rf, ulong relid)
         return (relentname);
 }
 
+#ifdef RF_PARALLEL
+
+/* Tuple operation queued to a roll-forward worker.
+ */
+typedef struct rf_work_st rf_work_t;
+struct rf_work_st {
+        rf_work_t*          rw_next;
+        dbe_logrectype_t    rw_logrectype;
+        dbe_trxnum_t        rw_committrxnum;
+        dbe_trxid_t         rw_trxid;
+        rs_relh_t*          rw_relh;        /* linked by the reader */
+        vtpl_t*             rw_vtpl;        /* private copy of the log data */
+};
+
+typedef struct rf_par_st rf_par_t;
+
+/* Roll-forward worker thread.
+ */
+typedef struct {
+        rf_par_t*           rfw_par;
+        rs_sysi_t*          rfw_cd;
+        SsMesT*             rfw_mes;        /* wakes up the worker */
+        rf_work_t*          rfw_first;
+        rf_work_t*          rfw_last;
+        int                 rfw_qlen;
+        bool                rfw_busy;       /* applying a taken batch */
+        bool                rfw_threadp;
+        ulong               rfw_napplied;
+} rf_worker_t;
+
+/* Parallel apply pipeline. The recovery thread reads and decodes the
+ * log, workers apply the tuple operations. All fields except rp_ctr,
+ * rp_nworkers and statistics are protected by rp_sem.
+ */
+struct rf_par_st {
+        dbe_counter_t*      rp_ctr;
+        int                 rp_nworkers;
+        rf_worker_t         rp_workers[RF_MAXWORKERS];
+        SsSemT*             rp_sem;
+        SsMesT*             rp_readermes;   /* wakes up the reader */
+        bool                rp_readerwaiting;
+        bool                rp_stop;
+        dbe_trxnum_t        rp_mergetrxnum; /* merge level to set at drain */
+        ulong               rp_ndispatched;
+        ulong               rp_ndrains;
+};
+
+/*#***********************************************************************\
+ *
+ *              rollfwd_par_apply
+ *
+ * Applies one queued tuple operation in a worker thread.
+ *
+ * Parameters :
+ *
+ *      cd - in, use
+ *              worker client data
+ *
+ *      work - in, take
+ *              queued operation
+ *
+ * Return value :
+ *
+ * Comments :
+ *      Failures are fatal as in the serial roll-forward.
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+static void rollfwd_par_apply(
+        rs_sysi_t* cd,
+        rf_work_t* work)
+{
+        dbe_ret_t rc;
+
+        if (work->rw_logrectype == DBE_LOGREC_DELTUPLE) {
+            rc = dbe_tuple_recovdelete(
+                    cd,
+                    DBE_TRX_NOTRX,
+                    work->rw_committrxnum,
+                    work->rw_trxid,
+                    work->rw_relh,
+                    work->rw_vtpl,
+                    FALSE);
+        } else {
+            rc = dbe_tuple_recovinsert(
+                    cd,
+                    DBE_TRX_NOTRX,
+                    work->rw_committrxnum,
+                    work->rw_trxid,
+                    work->rw_relh,
+                    work->rw_vtpl,
+                    FALSE);
+        }
+        if (rc != DBE_RC_SUCC) {
+            su_rc_error(rc);
+        }
+        SS_MEM_SETUNLINK(work->rw_relh);
+        rs_relh_done(cd, work->rw_relh);
+        SsMemFree(work->rw_vtpl);
+        SsMemFree(work);
+}
+
+/*#***********************************************************************\
+ *
+ *              rollfwd_par_workerthread
+ *
+ * Worker thread that applies queued tuple operations until the
+ * pipeline is stopped.
+ *
+ * Parameters :
+ *
+ *      data - in, use
+ *              pointer to rf_worker_t
+ *
+ * Return value :
+ *
+ * Comments :
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+static void SS_CALLBACK rollfwd_par_workerthread(void* data)
+{
+        rf_worker_t* w = data;
+        rf_par_t* par = w->rfw_par;
+        rf_work_t* work;
+        rf_work_t* next;
+        ulong napplied;
+
+        ss_autotest_or_debug(rs_sysi_setthrid(w->rfw_cd));
+
+        for (;;) {
+            SsSemEnter(par->rp_sem);
+            work = w->rfw_first;
+            w->rfw_first = NULL;
+            w->rfw_last = NULL;
+            w->rfw_qlen = 0;
+            w->rfw_busy = (work != NULL);
+            if (par->rp_readerwaiting) {
+                SsMesSend(par->rp_readermes);
+            }
+            if (work == NULL && par->rp_stop) {
+                SsSemExit(par->rp_sem);
+                break;
+            }
+            SsSemExit(par->rp_sem);
+
+            if (work == NULL) {
+                SsMesWait(w->rfw_mes);
+                continue;
+            }
+            for (napplied = 0; work != NULL; work = next, napplied++) {
+                next = work->rw_next;
+                rollfwd_par_apply(w->rfw_cd, work);
+            }
+            w->rfw_napplied += napplied;
+        }
+
+        ss_autotest_or_debug(rs_sysi_clearthrid(w->rfw_cd));
+
+        SsSemEnter(par->rp_sem);
+        w->rfw_threadp = FALSE;
+        if (par->rp_readerwaiting) {
+            SsMesSend(par->rp_readermes);
+        }
+        SsSemExit(par->rp_sem);
+
+#if (defined(SS_MYSQL) || defined(SS_MYSQL_AC)) && defined(MYSQL_DYNAMIC_PLUGIN)
+        return;
+#else
+        SsThrExit();
+#endif
+}
+
+/*#***********************************************************************\
+ *
+ *              rollfwd_par_readerwait
+ *
+ * Waits in the reader until a worker signals a state change.
+ *
+ * Parameters :
+ *
+ *      par - in, use
+ *              parallel pipeline, rp_sem must be entered
+ *
+ * Return value :
+ *
+ * Comments :
+ *      rp_sem is released during the wait and entered again before
+ *      return.
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+static void rollfwd_par_readerwait(rf_par_t* par)
+{
+        par->rp_readerwaiting = TRUE;
+        SsSemExit(par->rp_sem);
+        SsMesWait(par->rp_readermes);
+        SsSemEnter(par->rp_sem);
+        par->rp_readerwaiting = FALSE;
+}
+
+/*#***********************************************************************\
+ *
+ *              rollfwd_par_init
+ *
+ * Starts the parallel apply workers.
+ *
+ * Parameters :
+ *
+ *      rf - in, use
+ *              roll-forward object
+ *
+ * Return value - give :
+ *      pointer to pipeline, or
+ *      NULL if recovery should be done serially
+ *
+ * Comments :
+ *      Worker count comes from General.RecoveryThreads, zero means one
+ *      worker per processor.
+ *
+ * Globals used :
+ *
+ *      dbe_cfg_recoverythreads
+ *
+ * See also :
+ */
+static rf_par_t* rollfwd_par_init(dbe_rollfwd_t* rf)
+{
+        rf_par_t* par;
+        dbe_db_t* db;
+        int nworkers;
+        int i;
+
+#ifdef DBE_REPLICATION
+        if (rf->rf_hsbmode != DBE_HSB_STANDALONE) {
+            return(NULL);
+        }
+#endif /* DBE_REPLICATION */
+
+        nworkers = dbe_cfg_recoverythreads;
+        if (nworkers <= 0) {
+            nworkers = SsEnvNumProcessors();
+        }
+        if (nworkers > RF_MAXWORKERS) {
+            nworkers = RF_MAXWORKERS;
+        }
+        if (nworkers <= 1) {
+            return(NULL);
+        }
+
+        db = rs_sysi_db(rf->rf_cd);
+
+        par = SSMEM_NEW(rf_par_t);
+        par->rp_ctr = rf->rf_counter;
+        par->rp_nworkers = 0;
+        par->rp_sem = SsSemCreateLocal(SS_SEMNUM_DBE_ROLLFWD);
+        par->rp_readermes = SsMesCreateLocal();
+        par->rp_readerwaiting = FALSE;
+        par->rp_stop = FALSE;
+        par->rp_mergetrxnum = DBE_TRXNUM_NULL;
+        par->rp_ndispatched = 0;
+        par->rp_ndrains = 0;
+
+        for (i = 0; i < nworkers; i++) {
+            rf_worker_t* w = &par->rp_workers[i];
+            SsThreadT* thr;
+
+            w->rfw_cd = dbe_db_inittbconcd(db);
+            if (w->rfw_cd == NULL) {
+                break;
+            }
+            ss_autotest_or_debug(rs_sysi_clearthrid(w->rfw_cd));
+            w->rfw_par = par;
+            w->rfw_mes = SsMesCreateLocal();
+            w->rfw_first = NULL;
+            w->rfw_last = NULL;
+            w->rfw_qlen = 0;
+            w->rfw_busy = FALSE;
+            w->rfw_threadp = TRUE;
+            w->rfw_napplied = 0;
+            par->rp_nworkers++;
+
+            thr = SsThrInitParam(
+                    rollfwd_par_workerthread,
+                    "rollfwd_par_workerthread",
+                    128 * 1024,
+                    w);
+            SsThrEnable(thr);
+            SsThrDone(thr);
+        }
+
+        ss_pprintf_1(("rollfwd_par_init:%d workers\n", par->rp_nworkers));
+        ui_msg_message_status(DBE_MSG_RECOVERY_WORKERS_D, par->rp_nworkers);
+
+        return(par);
+}
+
+/*#***********************************************************************\
+ *
+ *              rollfwd_par_dispatch
+ *
+ * Queues a tuple operation to the worker that owns the relation.
+ *
+ * Parameters :
+ *
+ *      par - in, use
+ *              parallel pipeline
+ *
+ *      logrectype - in
+ *              DBE_LOGREC_DELTUPLE or one of the insert record types
+ *
+ *      committrxnum - in
+ *              commit number of the transaction
+ *
+ *      trxid - in
+ *              statement transaction id
+ *
+ *      relid - in
+ *              relation id, selects the worker
+ *
+ *      relh - in, take
+ *              linked relation handle
+ *
+ *      vtpl - in, use
+ *              tuple from the log, copied because the log buffer is reused
+ *
+ * Return value :
+ *
+ * Comments :
+ *      Blocks while the worker queue is full.
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+static void rollfwd_par_dispatch(
+        rf_par_t* par,
+        dbe_logrectype_t logrectype,
+        dbe_trxnum_t committrxnum,
+        dbe_trxid_t trxid,
+        ulong relid,
+        rs_relh_t* relh,
+        vtpl_t* vtpl)
+{
+        rf_worker_t* w;
+        rf_work_t* work;
+        size_t len;
+        bool wakeup;
+
+        len = (size_t)vtpl_grosslen(vtpl);
+
+        work = SSMEM_NEW(rf_work_t);
+        work->rw_next = NULL;
+        work->rw_logrectype = logrectype;
+        work->rw_committrxnum = committrxnum;
+        work->rw_trxid = trxid;
+        work->rw_relh = relh;
+        work->rw_vtpl = SsMemAlloc(len);
+        memcpy(work->rw_vtpl, vtpl, len);
+
+        w = &par->rp_workers[relid % par->rp_nworkers];
+
+        SsSemEnter(par->rp_sem);
+
+        while (w->rfw_qlen >= RF_MAXQUEUELEN) {
+            rollfwd_par_readerwait(par);
+        }
+        if (w->rfw_last == NULL) {
+            w->rfw_first = work;
+        } else {
+            w->rfw_last->rw_next = work;
+        }
+        w->rfw_last = work;
+        w->rfw_qlen++;
+        wakeup = !w->rfw_busy && w->rfw_qlen == 1;
+        par->rp_ndispatched++;
+
+        SsSemExit(par->rp_sem);
+
+        if (wakeup) {
+            SsMesSend(w->rfw_mes);
+        }
+}
+
+/*#***********************************************************************\
+ *
+ *              rollfwd_par_drain
+ *
+ * Waits until all queued tuple operations are applied. Called before
+ * a log record that must see the effects of all earlier operations.
+ *
+ * Parameters :
+ *
+ *      par - in, use
+ *              parallel pipeline
+ *
+ * Return value :
+ *
+ * Comments :
+ *      Merge level updates postponed from commit marks are set here
+ *      because they may advance only after the operations are applied.
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+static void rollfwd_par_drain(rf_par_t* par)
+{
+        int i;
+
+        SsSemEnter(par->rp_sem);
+        for (i = 0; i < par->rp_nworkers; i++) {
+            rf_worker_t* w = &par->rp_workers[i];
+            while (w->rfw_first != NULL || w->rfw_busy) {
+                rollfwd_par_readerwait(par);
+            }
+        }
+        par->rp_ndrains++;
+        SsSemExit(par->rp_sem);
+
+        if (!DBE_TRXNUM_EQUAL(par->rp_mergetrxnum, DBE_TRXNUM_NULL)) {
+            dbe_counter_setmergetrxnum(par->rp_ctr, par->rp_mergetrxnum);
+            par->rp_mergetrxnum = DBE_TRXNUM_NULL;
+        }
+}
+
+/*#***********************************************************************\
+ *
+ *              rollfwd_par_napplied
+ *
+ * Returns the number of tuple operations applied by the workers.
+ *
+ * Parameters :
+ *
+ *      par - in, use
+ *              parallel pipeline
+ *
+ * Return value :
+ *      number of applied operations
+ *
+ * Comments :
+ *      Value is approximate while workers are running.
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+static ulong rollfwd_par_napplied(rf_par_t* par)
+{
+        int i;
+        ulong napplied = 0;
+
+        for (i = 0; i < par->rp_nworkers; i++) {
+            napplied += par->rp_workers[i].rfw_napplied;
+        }
+        return(napplied);
+}
+
+/*#***********************************************************************\
+ *
+ *              rollfwd_par_done
+ *
+ * Applies all queued operations, stops the workers and releases the
+ * pipeline.
+ *
+ * Parameters :
+ *
+ *      par - in, take
+ *              parallel pipeline
+ *
+ * Return value :
+ *
+ * Comments :
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+static void rollfwd_par_done(rf_par_t* par)
+{
+        int i;
+
+        rollfwd_par_drain(par);
+
+        SsSemEnter(par->rp_sem);
+        par->rp_stop = TRUE;
+        SsSemExit(par->rp_sem);
+
+        for (i = 0; i < par->rp_nworkers; i++) {
+            rf_worker_t* w = &par->rp_workers[i];
+
+            SsMesSend(w->rfw_mes);
+            SsSemEnter(par->rp_sem);
+            while (w->rfw_threadp) {
+                rollfwd_par_readerwait(par);
+            }
+            SsSemExit(par->rp_sem);
+            SsMesFree(w->rfw_mes);
+            ss_autotest_or_debug(rs_sysi_setthrid(w->rfw_cd));
+            dbe_db_donetbconcd(rs_sysi_db(w->rfw_cd), w->rfw_cd);
+        }
+
+        ss_pprintf_1(("rollfwd_par_done:dispatched=%lu, drains=%lu\n",
+            par->rp_ndispatched, par->rp_ndrains));
+
+        SsMesFree(par->rp_readermes);
+        SsSemFree(par->rp_sem);
+        SsMemFree(par);
+}
+
+/*#***********************************************************************\
+ *
+ *              rollfwd_par_isbarrier
+ *
+ * Checks if a log record must wait for all queued tuple operations
+ * before it is processed.
+ *
+ * Parameters :
+ *
+ *      logrectype - in
+ *              log record type
+ *
+ * Return value :
+ *      TRUE if queued operations must be applied first
+ *
+ * Comments :
+ *      Commit and abort marks do not need a barrier because only
+ *      operations of transactions found committed by
+ *      dbe_rollfwd_scancommitmarks are queued, and marks are still
+ *      processed in log order by the reader.
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+static bool rollfwd_par_isbarrier(dbe_logrectype_t logrectype)
+{
+        switch (logrectype) {
+            case DBE_LOGREC_NOP:
+            case DBE_LOGREC_HEADER:
+            case DBE_LOGREC_INSTUPLE:
+            case DBE_LOGREC_INSTUPLEWITHBLOBS:
+            case DBE_LOGREC_INSTUPLENOBLOBS:
+            case DBE_LOGREC_DELTUPLE:
+            case DBE_LOGREC_ABORTSTMT:
+            case DBE_LOGREC_ABORTTRX_INFO:
+            case DBE_LOGREC_ABORTTRX_OLD:
+            case DBE_LOGREC_COMMITSTMT:
+            case DBE_LOGREC_COMMITTRX_INFO:
+            case DBE_LOGREC_COMMITTRX_OLD:
+            case DBE_LOGREC_COMMITTRX_HSB_OLD:
+            case DBE_LOGREC_HSBCOMMITMARK_OLD:
+            case DBE_LOGREC_CHECKPOINT_OLD:
+            case DBE_LOGREC_SNAPSHOT_OLD:
+            case DBE_LOGREC_CHECKPOINT_NEW:
+            case DBE_LOGREC_SNAPSHOT_NEW:
+            case DBE_LOGREC_DELSNAPSHOT:
+            case DBE_LOGREC_AUDITINFO:
+            case DBE_LOGREC_COMMENT:
+                return(FALSE);
+            default:
+                return(TRUE);
+        }
+}
+
+#endif /* RF_PARALLEL */
+
 /*##**********************************************************************\
  *
  *              dbe_rollfwd_recover
@@ -1963,6 +2552,14 @@ dbe_ret_t dbe_rollfwd_recover(
         bool ishsbg2;
         dbe_logi_commitinfo_t commitinfo;
         bool recheader_gotten = FALSE;
+        ulong nrecords = 0;
+        ulong napplied = 0;
+        ulong lastnrecords = 0;
+        SsTimeT starttime;
+        SsTimeT lastreporttime;
+#ifdef RF_PARALLEL
+        rf_par_t* par = NULL;
+#endif /* RF_PARALLEL */
 
         ss_dassert(rf != NULL);
         ss_dassert(rf->rf_state == RFSTATE_SCANNED);
@@ -2046,10 +2643,36 @@ dbe_ret_t dbe_rollfwd_recover(
                 DBE_TRXID_SUM(rf->rf_maxtrxid, 1));
         }
 
+        starttime = SsTime(NULL);
+        lastreporttime = starttime;
+
         if (rf->rf_ncommits != 0L || rf->rf_rtrxfound) {
+#ifdef RF_PARALLEL
+            par = rollfwd_par_init(rf);
+#endif /* RF_PARALLEL */
             for (;;) {
                 if (ctr++ % 100 == 0) {
+                    SsTimeT now;
+
                     ss_svc_notify_init();
+
+                    now = SsTime(NULL);
+                    if (now - lastreporttime >= RF_PROGRESSINTERVAL) {
+#ifdef RF_PARALLEL
+                        ulong nparapplied = par != NULL
+                                                ? rollfwd_par_napplied(par)
+                                                : 0;
+#else /* RF_PARALLEL */
+                        ulong nparapplied = 0;
+#endif /* RF_PARALLEL */
+                        ui_msg_message_status(
+                            DBE_MSG_RECOVERY_PROGRESS_UUU,
+                            nrecords,
+                            napplied + nparapplied,
+                            (nrecords - lastnrecords) / (ulong)(now - lastreporttime));
+                        lastnrecords = nrecords;
+                        lastreporttime = now;
+                    }
                 }
                 recheader_gotten = FALSE;
                 rc = dbe_rflog_getnextrecheader(
@@ -2061,10 +2684,16 @@ dbe_ret_t dbe_rollfwd_recover(
                     break;
                 }
                 recheader_gotten = TRUE;
+                nrecords++;
                 if (logrectype != DBE_LOGREC_NOP) {
                     ss_pprintf_2(("dbe_rollfwd_recover:%s, trxid=%ld\n",
                         dbe_logi_getrectypename(logrectype), DBE_TRXID_GETLONG(trxid)));
                 }
+#ifdef RF_PARALLEL
+                if (par != NULL && rollfwd_par_isbarrier(logrectype)) {
+                    rollfwd_par_drain(par);
+                }
+#endif /* RF_PARALLEL */
                 dbe_rflog_saverecordpos(rf->rf_log, &curlogpos);
 
                 hsbrecovery = dbe_logpos_cmp(&curlogpos, &rf->rf_hsbstartpos)
@@ -2119,6 +2748,24 @@ dbe_ret_t dbe_rollfwd_recover(
                                 hasblobs =
                                     (logrectype == DBE_LOGREC_INSTUPLEWITHBLOBS);
                             }
+#ifdef RF_PARALLEL
+                            if (par != NULL) {
+                                if (!hasblobs) {
+                                    rollfwd_par_dispatch(
+                                        par,
+                                        logrectype,
+                                        trxinfo->ti_committrxnum,
+                                        trxid,
+                                        relid,
+                                        relh,
+                                        p_vtpl);
+                                    break;
+                                }
+                                /* Blob pool is used by the reader only. */
+                                rollfwd_par_drain(par);
+                            }
+#endif /* RF_PARALLEL */
+                            napplied++;
                             rc = dbe_tuple_recovinsert(
                                     rf->rf_cd,
                                     rf->rf_trx,
@@ -2171,6 +2818,23 @@ dbe_ret_t dbe_rollfwd_recover(
                                 }
                                 ss_pprintf_4(("  Delete this tuple, relid=%ld\n", relid));
                                 relh = rollfwd_relhbyid(rf, relid, DBE_TRXID_NULL, &relentname);
+#ifdef RF_PARALLEL
+                                if (par != NULL) {
+#ifdef DBE_REPLICATION
+                                    ss_dassert(!unsure_replicatrx);
+#endif /* DBE_REPLICATION */
+                                    rollfwd_par_dispatch(
+                                        par,
+                                        logrectype,
+                                        trxinfo->ti_committrxnum,
+                                        trxid,
+                                        relid,
+                                        relh,
+                                        p_vtpl);
+                                    break;
+                                }
+#endif /* RF_PARALLEL */
+                                napplied++;
                                 rc = dbe_tuple_recovdelete(
                                         rf->rf_cd,
                                         rf->rf_trx,
@@ -2501,9 +3165,19 @@ dbe_ret_t dbe_rollfwd_recover(
                         if (dbe_gtrs_mergecleanup_recovery) {
                             ss_dprintf_2(("dbe_rollfwd_recover:dbe_cfg_mergecleanup, mergetrxnum=%ld\n", DBE_TRXNUM_GETLONG(trxinfo->ti_committrxnum)));
                             ss_dassert(dbe_trxnum_cmp(trxinfo->ti_committrxnum, rf->rf_committrxnum) <= 0);
-                            dbe_counter_setmergetrxnum(
-                                rf->rf_counter,
-                                trxinfo->ti_committrxnum);
+#ifdef RF_PARALLEL
+                            if (par != NULL) {
+                                /* Merge level moves after queued
+                                 * operations are applied.
+                                 */
+                                par->rp_mergetrxnum = trxinfo->ti_committrxnum;
+                            } else
+#endif /* RF_PARALLEL */
+                            {
+                                dbe_counter_setmergetrxnum(
+                                    rf->rf_counter,
+                                    trxinfo->ti_committrxnum);
+                            }
                         }
 
 #ifdef DBE_REPLICATION
@@ -3165,6 +3839,21 @@ dbe_ret_t dbe_rollfwd_recover(
                     break;
                 }
             }
+#ifdef RF_PARALLEL
+            if (par != NULL) {
+                rollfwd_par_drain(par);
+                napplied += rollfwd_par_napplied(par);
+                rollfwd_par_done(par);
+            }
+#endif /* RF_PARALLEL */
+            {
+                SsTimeT elapsed = SsTime(NULL) - starttime;
+                ui_msg_message_status(
+                    DBE_MSG_RECOVERY_PROGRESS_UUU,
+                    nrecords,
+                    napplied,
+                    nrecords / (ulong)(elapsed > 0 ? elapsed : 1));
+            }
         } else {
             rc = DBE_RC_END;
         }
@@ -200,6 +200,11 @@ dbe_search_t* dbe_search_init_disk(
         search->sea_key = rs_pla_getkey(cd, plan);
         search->sea_relid = rs_pla_getrelid(cd, plan);
         search->sea_posdvtpl = NULL;
+        search->sea_batchvb = NULL;
+        search->sea_batchtref = NULL;
+        search->sea_batchntref = 0;
+        search->sea_batchnextp = TRUE;
+        search->sea_batchnskip = 0;
 
         search->sea_isolationchange_transparent = FALSE;
 
@@ -367,6 +372,41 @@ dbe_search_t* dbe_search_init_disk(
         return(search);
 }
 
+/*#***********************************************************************\
+ *
+ *		search_batchtref_free
+ *
+ * Releases the tuple references saved for the rows of a row block.
+ *
+ * Parameters :
+ *
+ *	search - in out, use
+ *		Search object.
+ *
+ * Return value :
+ *
+ * Limitations  :
+ *
+ * Globals used :
+ */
+static void search_batchtref_free(
+        dbe_search_t* search)
+{
+        ulong i;
+
+        if (search->sea_batchtref != NULL) {
+            for (i = 0; i < search->sea_batchntref; i++) {
+                if (search->sea_batchtref[i] != NULL) {
+                    dbe_tref_done(search->sea_cd, search->sea_batchtref[i]);
+                }
+            }
+            SsMemFree(search->sea_batchtref);
+            search->sea_batchtref = NULL;
+            search->sea_batchntref = 0;
+        }
+        search->sea_batchvb = NULL;
+}
+
 /*##**********************************************************************\
  *
  *		dbe_search_done_disk
@@ -400,6 +440,7 @@ void dbe_search_done_disk(
         if (search->sea_tref != NULL) {
             dbe_tref_done(search->sea_cd, search->sea_tref);
         }
+        search_batchtref_free(search);
         dbe_indsea_done(search->sea_indsea);
         rs_pla_done(search->sea_cd, search->sea_plan);
 
@@ -529,6 +570,8 @@ void dbe_search_reset_disk(
         dbe_user_checkoutsearches(search->sea_user);
 
         search->sea_flags = 0;
+        search->sea_batchnextp = TRUE;
+        search->sea_batchnskip = 0;
         search->sea_ttype = ttype;
         search->sea_sellist = sellist;
         search->sea_plan = plan;
@@ -694,6 +737,8 @@ dbe_ret_t dbe_search_reset_disk_fetch(
         dbe_user_checkoutsearches(search->sea_user);
 
         search->sea_flags = 0;
+        search->sea_batchnextp = TRUE;
+        search->sea_batchnskip = 0;
         search->sea_ttype = ttype;
         search->sea_sellist = sellist;
         search->sea_plan = plan;
@@ -1832,7 +1877,7 @@ static dbe_ret_t search_nextorprev(
         CHK_SEARCH(search);
         SS_PUSHNAME("search_nextorprev");
 
-        ss_debug(rs_tval_resetexternalflatva(search->sea_cd, search->sea_ttype, *p_tval));
+        ss_debug(if (p_tval != NULL) rs_tval_resetexternalflatva(search->sea_cd, search->sea_ttype, *p_tval));
 
         search->sea_datasrk = NULL;
 
@@ -2260,6 +2305,410 @@ dbe_ret_t dbe_search_nextorprev_disk(
         return(rc);
 }
 
+/*#***********************************************************************\
+ *
+ *		search_readdata
+ *
+ * Reads the data tuple of a tuple reference collected by
+ * search_nextorprev_deref_n and creates the row from it.
+ *
+ * Parameters :
+ *
+ *	search - in out, use
+ *		Search object.
+ *
+ *	trx - in
+ *		Current transaction handle
+ *
+ *	tref - in, use
+ *		Tuple reference with read level set.
+ *
+ *	p_tval - in out, use
+ *		Row tuple value.
+ *
+ * Return value :
+ *
+ *      DBE_RC_FOUND    - Row created to *p_tval.
+ *      DBE_RC_NOTFOUND - Data tuple is not visible to the search.
+ *      error code
+ *
+ * Limitations  :
+ *
+ * Globals used :
+ */
+static dbe_ret_t search_readdata(
+        dbe_search_t* search,
+        dbe_trx_t* trx,
+        dbe_tref_t* tref,
+        rs_tval_t** p_tval)
+{
+        dbe_ret_t rc;
+
+        search->sea_datasrk = NULL;
+
+        rc = dbe_datasea_search(
+                search->sea_datasea,
+                tref->tr_vtpl,
+                dbe_trx_getstmttrxid(trx),
+                &search->sea_srk);
+
+        ss_dprintf_4(("search_readdata:datasea rc=%s\n", su_rc_nameof(rc)));
+
+        switch (rc) {
+            case DBE_RC_FOUND:
+                search->sea_rc = DBE_RC_FOUND;
+                return(search_createtval(search, p_tval));
+            case DBE_RC_END:
+                search->sea_rc = DBE_RC_NOTFOUND;
+                return(DBE_RC_NOTFOUND);
+            default:
+                su_rc_derror(rc);
+                search->sea_rc = rc;
+                return(rc);
+        }
+}
+
+/*#***********************************************************************\
+ *
+ *		search_nextorprev_deref_n
+ *
+ * Fills a row block for a search that dereferences index entries to
+ * data tuples. The index is stepped first and the tuple references of
+ * up to a block of rows are collected. The clustering key leaves of the
+ * references are then prefetched in key order, and finally the data
+ * tuples are read in index order, so the rows come out in the same
+ * order as from dbe_search_nextorprev_disk.
+ *
+ * Parameters :
+ *
+ *	search - in out, use
+ *		Search object.
+ *
+ *	trx - in
+ *		Current transaction handle
+ *
+ *	nextp - in
+ *		If TRUE, fetch next. Otherwise fetch previous.
+ *
+ *	vb - in out, use
+ *		Empty row block.
+ *
+ *	p_nwritten - out
+ *		Number of rows and end of set marks written to vb.
+ *
+ * Return value :
+ *
+ *      Return code of the last index step, or data search error.
+ *
+ * Limitations  :
+ *
+ *      Only for searches that do not lock, see dbe_search_nextorprev_n.
+ *
+ * Globals used :
+ */
+static dbe_ret_t search_nextorprev_deref_n(
+        dbe_search_t* search,
+        dbe_trx_t* trx,
+        bool nextp,
+        rs_vbuf_t* vb,
+        ulong* p_nwritten)
+{
+        rs_sysi_t* cd;
+        dbe_tref_t** trefs;
+        vtpl_t** refvtpls;
+        dbe_tref_t* lasttref;
+        rs_tval_t* tval;
+        ulong maxtref;
+        ulong ntref;
+        ulong slot;
+        ulong i;
+        dbe_ret_t rc;
+        dbe_ret_t datarc;
+
+        cd = search->sea_cd;
+
+        /* Leave room for the end of set mark. */
+        maxtref = vb->vb_nslots - 2;
+        trefs = SsMemAlloc(maxtref * sizeof(trefs[0]));
+        ntref = 0;
+
+        if (search->sea_needrestart) {
+            /* Restart here, restart also renews the data search. */
+            dbe_search_restart(search, trx, dbe_trxnum_null, dbe_trx_getusertrxid(trx));
+            ss_dassert(!search->sea_needrestart);
+        }
+
+        /* Step the index only, data tuples are read after the batch
+         * is collected.
+         */
+        search->sea_getdata = FALSE;
+        do {
+            rc = dbe_search_nextorprev_disk(search, trx, nextp, NULL);
+            if (rc != DBE_RC_FOUND) {
+                break;
+            }
+            trefs[ntref] = dbe_tref_init();
+            dbe_tref_buildsearchtref(
+                cd,
+                trefs[ntref],
+                search->sea_plan,
+                dbe_srk_getvamap(search->sea_srk),
+                dbe_srk_gettrxid(search->sea_srk));
+            dbe_tref_setreadlevel(
+                trefs[ntref],
+                search->sea_tc.tc_maxtrxnum);
+            ntref++;
+        } while (ntref < maxtref);
+        search->sea_getdata = TRUE;
+
+        ss_dprintf_2(("search_nextorprev_deref_n:rc=%s, ntref=%ld\n", su_rc_nameof(rc), ntref));
+
+        if (ntref > 1) {
+            refvtpls = SsMemAlloc(ntref * sizeof(refvtpls[0]));
+            for (i = 0; i < ntref; i++) {
+                refvtpls[i] = trefs[i]->tr_vtpl;
+            }
+            dbe_datasea_prefetch(search->sea_datasea, refvtpls, (int)ntref);
+            SsMemFree(refvtpls);
+        }
+
+        *p_nwritten = 0;
+        lasttref = NULL;
+
+        for (i = 0; i < ntref; i++) {
+            slot = vb->vb_wpos;
+            tval = rs_vbuf_getwritable(cd, vb);
+            ss_dassert(tval != NULL);
+
+            datarc = search_readdata(search, trx, trefs[i], &tval);
+
+            if (datarc == DBE_RC_FOUND) {
+                ss_dassert(tval == vb->vb_slot[slot].vbs_tval);
+                if (search->sea_batchtref[slot] != NULL) {
+                    dbe_tref_done(cd, search->sea_batchtref[slot]);
+                }
+                search->sea_batchtref[slot] = trefs[i];
+                lasttref = trefs[i];
+                trefs[i] = NULL;
+                rs_vbuf_writedone(cd, vb);
+                (*p_nwritten)++;
+            } else {
+                rs_vbuf_abortwrite(cd, vb);
+                dbe_tref_done(cd, trefs[i]);
+                trefs[i] = NULL;
+                if (datarc != DBE_RC_NOTFOUND) {
+                    rc = datarc;
+                    for (i++; i < ntref; i++) {
+                        dbe_tref_done(cd, trefs[i]);
+                    }
+                    break;
+                }
+            }
+        }
+        SsMemFree(trefs);
+
+        if (lasttref != NULL) {
+            if (search->sea_tref != NULL) {
+                dbe_tref_done(cd, search->sea_tref);
+            }
+            search->sea_tref = dbe_tref_copy(cd, lasttref);
+        }
+
+        if (rc == DBE_RC_END) {
+            ss_dassert(rs_vbuf_hasroom(cd, vb));
+            rs_vbuf_getwritable(cd, vb);
+            rs_vbuf_writeeos(cd, vb);
+            (*p_nwritten)++;
+        } else if (rc == DBE_RC_FOUND && *p_nwritten == 0) {
+            rc = DBE_RC_NOTFOUND;
+        }
+
+        return(rc);
+}
+
+/*##**********************************************************************\
+ *
+ *		dbe_search_nextorprev_n
+ *
+ * Fills a row block with the next or previous tuples from the search.
+ * Rows are read until the block is full, the search ends or a step
+ * does not return a row. A copy of the tuple reference is saved with
+ * each row, so dbe_search_gettref returns the reference of the row
+ * the caller is at even though the search is already further.
+ *
+ * Rows are read ahead only when the search does not lock them. Other
+ * searches return at most one row per call, so lock waits are seen at
+ * the row they belong to.
+ *
+ * If the direction changes while the block still has unread rows,
+ * those rows are dropped and the search is stepped back over them
+ * before new rows are read. An unread end of set mark costs one more
+ * step, because the search has already moved past the last row.
+ *
+ * Parameters :
+ *
+ *	search - in out, use
+ *		Search object.
+ *
+ *	trx - in
+ *		Current transaction handle
+ *
+ *	nextp - in
+ *		If TRUE, fetch next. Otherwise fetch previous.
+ *
+ *	vb - in out, use
+ *		Row block. Rows are written to the tuple values of the
+ *		block, end of search is written as an end of set mark.
+ *
+ * Return value :
+ *
+ *      DBE_RC_FOUND    - At least one row or the end of set mark
+ *                        was added to vb.
+ *      DBE_RC_NOTFOUND - No row found in this step, vb is unchanged.
+ *      DBE_RC_WAITLOCK - Wait for a lock, vb is unchanged.
+ *      DBE_RC_END      - End of search while stepping back after a
+ *                        direction change.
+ *      error code
+ *
+ * Limitations  :
+ *
+ *      The caller may call this only when vb has no unread rows in
+ *      direction nextp.
+ *
+ * Globals used :
+ */
+dbe_ret_t dbe_search_nextorprev_n(
+        dbe_search_t* search,
+        dbe_trx_t* trx,
+        bool nextp,
+        rs_vbuf_t* vb)
+{
+        rs_sysi_t* cd;
+        rs_tval_t* tval;
+        bool simpletval;
+        bool readahead;
+        ulong slot;
+        ulong nwritten;
+        dbe_ret_t rc;
+
+        ss_dprintf_1(("dbe_search_nextorprev_n:sea_id=%ld, nextp=%d\n", (long)search->sea_id, nextp));
+        CHK_SEARCH(search);
+        ss_dassert(dbe_search_gettype(search) == DBE_SEARCH_DBE);
+
+        cd = search->sea_cd;
+
+        if (search->sea_batchvb != vb) {
+            search_batchtref_free(search);
+            search->sea_batchvb = vb;
+            search->sea_batchntref = vb->vb_nslots;
+            search->sea_batchtref = SsMemCalloc(vb->vb_nslots, sizeof(search->sea_batchtref[0]));
+        }
+
+        /* Rows in the block must own their values, they stay in use
+         * after the search has moved on.
+         */
+        simpletval = rs_sysi_testflag(cd, RS_SYSI_FLAG_SEARCH_SIMPLETVAL);
+        if (simpletval) {
+            rs_sysi_clearflag(cd, RS_SYSI_FLAG_SEARCH_SIMPLETVAL);
+        }
+
+        if (nextp != search->sea_batchnextp) {
+            ss_dassert(search->sea_batchnskip == 0);
+            search->sea_batchnskip = rs_vbuf_nrows(cd, vb);
+            if (vb->vb_nitems > search->sea_batchnskip) {
+                /* The block ends with an end of set mark. The search
+                 * is then past the last row in the block and needs one
+                 * more step to get back to it.
+                 */
+                search->sea_batchnskip++;
+            }
+            search->sea_batchnextp = nextp;
+            rs_vbuf_rewind(cd, vb);
+            ss_dprintf_2(("dbe_search_nextorprev_n:direction changed, skip %ld rows\n", search->sea_batchnskip));
+        }
+
+        if (search->sea_batchnskip > 0) {
+            tval = NULL;
+            do {
+                rc = dbe_search_nextorprev_disk(search, trx, nextp, &tval);
+                if (rc == DBE_RC_FOUND) {
+                    search->sea_batchnskip--;
+                } else if (rc == DBE_RC_END) {
+                    search->sea_batchnskip = 0;
+                } else if (rc != DBE_RC_NOTFOUND) {
+                    break;
+                }
+            } while (search->sea_batchnskip > 0);
+            if (tval != NULL) {
+                rs_tval_free(cd, search->sea_ttype, tval);
+            }
+            if (rc != DBE_RC_FOUND && rc != DBE_RC_NOTFOUND) {
+                if (simpletval) {
+                    rs_sysi_setflag(cd, RS_SYSI_FLAG_SEARCH_SIMPLETVAL);
+                }
+                return(rc);
+            }
+        }
+
+        ss_dassert(!rs_vbuf_hasdata(cd, vb));
+        ss_dassert(rs_vbuf_hasroom(cd, vb));
+
+        readahead = search->sea_cursortype == DBE_CURSOR_SELECT
+                    && search->sea_reltype == RS_RELTYPE_OPTIMISTIC
+                    && !search->sea_uselocks;
+        nwritten = 0;
+        rc = DBE_RC_NOTFOUND;
+
+        if (readahead
+            && search->sea_getdata
+            && search->sea_flags == 0
+            && vb->vb_nslots > 2)
+        {
+            rc = search_nextorprev_deref_n(search, trx, nextp, vb, &nwritten);
+        } else {
+            while (rs_vbuf_hasroom(cd, vb)) {
+                slot = vb->vb_wpos;
+                tval = rs_vbuf_getwritable(cd, vb);
+
+                rc = dbe_search_nextorprev_disk(search, trx, nextp, &tval);
+
+                if (rc == DBE_RC_FOUND) {
+                    ss_dassert(tval == vb->vb_slot[slot].vbs_tval);
+                    if (search->sea_batchtref[slot] != NULL) {
+                        dbe_tref_done(cd, search->sea_batchtref[slot]);
+                    }
+                    search->sea_batchtref[slot] = dbe_tref_copy(
+                                                    cd,
+                                                    dbe_search_gettref(search, NULL));
+                    rs_vbuf_writedone(cd, vb);
+                    nwritten++;
+                    if (!readahead) {
+                        break;
+                    }
+                } else if (rc == DBE_RC_END) {
+                    rs_vbuf_writeeos(cd, vb);
+                    nwritten++;
+                    break;
+                } else {
+                    rs_vbuf_abortwrite(cd, vb);
+                    break;
+                }
+            }
+        }
+
+        if (simpletval) {
+            rs_sysi_setflag(cd, RS_SYSI_FLAG_SEARCH_SIMPLETVAL);
+        }
+
+        ss_dprintf_1(("dbe_search_nextorprev_n:rc=%s, nwritten=%ld\n", su_rc_nameof(rc), nwritten));
+
+        if (nwritten > 0) {
+            return(DBE_RC_FOUND);
+        } else {
+            return(rc);
+        }
+}
+
 /*##**********************************************************************\
  *
  *		dbe_search_gotoend
@@ -2413,6 +2862,11 @@ dbe_ret_t dbe_search_setposition(
  *	search - in, use
  *
  *
+ *	tval - in, use
+ *		Tuple value returned by the search, or NULL. If the value
+ *		was returned in a dbe_search_nextorprev_n row block, the
+ *		reference saved with that row is returned.
+ *
  * Return value - ref :
  *
  *      Pointer to a local copy of tuple reference.
@@ -2432,6 +2886,21 @@ dbe_tref_t* dbe_search_gettref(
             ss_dprintf_1(("dbe_search_gettref\n"));
             CHK_SEARCH(search);
             ss_assert(search->sea_refattrs != NULL);
+
+            if (tval != NULL && search->sea_batchvb != NULL) {
+                ulong i;
+
+                /* The search may be ahead of the row the caller is at,
+                 * return the reference saved with the row.
+                 */
+                for (i = 0; i < search->sea_batchvb->vb_nslots; i++) {
+                    if (search->sea_batchvb->vb_slot[i].vbs_tval == tval) {
+                        ss_dassert(search->sea_batchtref[i] != NULL);
+                        return(search->sea_batchtref[i]);
+                    }
+                }
+            }
+
             su_rc_assert(search->sea_rc == DBE_RC_FOUND ||
                         search->sea_rc == DBE_RC_LOCKTUPLE ||
                         search->sea_rc == DBE_RC_WAITLOCK,
@@ -64,6 +64,7 @@ Example:
 #include <ssc.h>
 #include <ssmem.h>
 #include <ssdebug.h>
+#include <sspmon.h>
 
 #include <uti0va.h>
 #include <uti0vtpl.h>
@@ -80,6 +81,7 @@ Example:
 #include "dbe9type.h"
 #include "dbe6bkey.h"
 #include "dbe6srk.h"
+#include "dbe6btre.h"
 #include "dbe5inde.h"
 #include "dbe5isea.h"
 #include "dbe5dsea.h"
@@ -345,6 +347,51 @@ void dbe_datasea_done(dbe_datasea_t* datasea)
         SsMemFree(datasea);
 }
 
+/*##**********************************************************************\
+ * 
+ *		dbe_datasea_prefetch
+ * 
+ * Starts reading the permanent tree leaves of a batch of searched key
+ * values. The following dbe_datasea_search calls for the same values
+ * then find the leaves in the cache instead of doing one random read
+ * per key value.
+ * 
+ * Parameters : 
+ * 
+ *	datasea - in, use
+ *		Data search object.
+ *		
+ *	refvtpls - in out, use
+ *		V-tuple values that will be searched. The array is sorted
+ *          into key order, the v-tuples are not changed.
+ *		
+ *	nrefvtpl - in
+ *		Number of elements in refvtpls.
+ *		
+ * Return value : 
+ * 
+ * Limitations  : 
+ * 
+ * Globals used : 
+ */
+void dbe_datasea_prefetch(
+        dbe_datasea_t* datasea,
+        vtpl_t** refvtpls,
+        int nrefvtpl)
+{
+        int nleaf;
+
+        CHK_DATASEA(datasea);
+        ss_dprintf_1(("dbe_datasea_prefetch:nrefvtpl=%d\n", nrefvtpl));
+
+        nleaf = dbe_btree_prefetchleaves(
+                    dbe_index_getpermtree(datasea->ds_index),
+                    refvtpls,
+                    nrefvtpl);
+
+        SS_PMON_ADD_N(SS_PMON_DATASEA_PREFETCH, nleaf);
+}
+
 /*##**********************************************************************\
  * 
  *		dbe_datasea_setlongseqsea
@@ -977,8 +977,9 @@ void dbe_indmerge_getnmerged(
             su_list_do_get(merge->im_mergepartlist, n, mp) {
                 mergepart_updateindexwrites(mp);
             }
-            SsSemExit(merge->im_sem);
+            /* Parts merged in parallel update the counter under im_sem. */
             *p_nindexwrites = merge->im_nindexwrites;
+            SsSemExit(merge->im_sem);
         }
 }
 
@@ -937,7 +937,8 @@ static dbe_bnode_t* bnode_create_empty(
  *		bnode_create_seq
  *
  * Creates a new node onto cache using a sequence in address addr if
- * possible.
+ * possible. Otherwise the node is allocated near the previous node,
+ * if one is given.
  *
  * Parameters :
  *
@@ -945,7 +946,10 @@ static dbe_bnode_t* bnode_create_empty(
  *		global objects
  *
  *	prev_addr - in
- *		previous node address
+ *		previous node address or SU_DADDR_NULL
+ *
+ *	seqp - in
+ *		if TRUE, a sequence allocation is tried first
  *
  *	p_rc - out
  *		error code if function returns NULL
@@ -961,6 +965,7 @@ static dbe_bnode_t* bnode_create_empty(
 static dbe_bnode_t* bnode_create_seq(
         dbe_gobj_t* go,
         su_daddr_t prev_addr,
+        bool seqp,
         bool bonsaip,
         dbe_ret_t* p_rc,
         dbe_info_t* info)
@@ -972,7 +977,7 @@ static dbe_bnode_t* bnode_create_seq(
 
         ss_dassert(bonsaip == TRUE || bonsaip == FALSE);
 
-        if (prev_addr != SU_DADDR_NULL) {
+        if (prev_addr != SU_DADDR_NULL && seqp) {
             rc = dbe_fl_seq_alloc(go->go_idxfd->fd_freelist, prev_addr, &addr);
             if (rc != SU_SUCCESS) {
                 /* Create a new sequence allocation. */
@@ -982,7 +987,9 @@ static dbe_bnode_t* bnode_create_seq(
                 addr = SU_DADDR_NULL;
             }
         }
-        if (addr == SU_DADDR_NULL) {
+        if (addr == SU_DADDR_NULL && prev_addr != SU_DADDR_NULL) {
+            rc = dbe_fl_alloc_near(go->go_idxfd->fd_freelist, prev_addr, &addr, info);
+        } else if (addr == SU_DADDR_NULL) {
             rc = dbe_fl_alloc(go->go_idxfd->fd_freelist, &addr, info);
         }
         ss_dprintf_1(("bnode_create_seq:addr = %ld, dbe_fl_alloc rc = %d\n", addr, rc));
@@ -1033,7 +1040,7 @@ dbe_bnode_t* dbe_bnode_create(
         dbe_ret_t* p_rc,
         dbe_info_t* info)
 {
-        return(bnode_create_seq(go, SU_DADDR_NULL, bonsaip, p_rc, info));
+        return(bnode_create_seq(go, SU_DADDR_NULL, FALSE, bonsaip, p_rc, info));
 }
 
 /*#***********************************************************************\
@@ -1681,8 +1688,13 @@ dbe_bnode_t* dbe_bnode_relocate(
 
         go = n->n_go;
 
-        /* Allocate a new block for the node. */
-        rc = dbe_fl_alloc(go->go_idxfd->fd_freelist, &newaddr, info);
+        if (info->i_flags & DBE_INFO_DEFRAG) {
+            /* Defragmentation moves the node to the lowest free block. */
+            rc = dbe_fl_alloc(go->go_idxfd->fd_freelist, &newaddr, info);
+        } else {
+            /* Allocate a new block for the node near the old one. */
+            rc = dbe_fl_alloc_near(go->go_idxfd->fd_freelist, n->n_addr, &newaddr, info);
+        }
         if (rc != SU_SUCCESS) {
             *p_rc = rc;
             SS_POPNAME;
@@ -4205,10 +4217,10 @@ static dbe_bnode_t* bnode_split(
 
         if (BNODE_ISSEQINS(n)) {
             *p_seqins = TRUE;
-            nn = bnode_create_seq(n->n_go, n->n_addr, n->n_bonsaip, p_rc, info);
+            nn = bnode_create_seq(n->n_go, n->n_addr, TRUE, n->n_bonsaip, p_rc, info);
         } else {
             *p_seqins = FALSE;
-            nn = dbe_bnode_create(n->n_go, n->n_bonsaip, p_rc, info);
+            nn = bnode_create_seq(n->n_go, n->n_addr, FALSE, n->n_bonsaip, p_rc, info);
         }
         if (nn == NULL) {
             return(NULL);
@@ -5859,6 +5871,78 @@ bool dbe_bnode_getaddrinkey(
         }
 }
 
+/*##**********************************************************************\
+ *
+ *		dbe_bnode_getchildkeys
+ *
+ * Calls a function for each key value in a non-leaf node. The key
+ * values are given in expanded form, so the caller can search the
+ * child node from the tree using the key value.
+ *
+ * Parameters :
+ *
+ *	n - in, use
+ *		non-leaf node
+ *
+ *	childfun - in, use
+ *		function called for each key value, the key value
+ *          is valid only during the call
+ *
+ *	ctx - in, hold
+ *		context passed to childfun
+ *
+ * Return value :
+ *
+ * Comments :
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+void dbe_bnode_getchildkeys(
+        dbe_bnode_t* n,
+        void (*childfun)(void* ctx, dbe_bkey_t* k),
+        void* ctx)
+{
+        int i;
+        int kpos;
+        char* keys;
+        dbe_bkey_t* k;
+
+        ss_dprintf_3(("dbe_bnode_getchildkeys:addr = %ld, level=%d\n", n->n_addr, n->n_level));
+        CHK_BNODE(n);
+        ss_dassert(n->n_level > 0);
+
+        if (n->n_count == 0) {
+            return;
+        }
+
+        if (n->n_info & BNODE_MISMATCHARRAY) {
+            bnode_getkeyoffset(n, 0, kpos);
+            keys = &n->n_keys[kpos];
+        } else {
+            keys = n->n_keys;
+        }
+
+        k = dbe_bkey_init(n->n_go->go_bkeyinfo);
+        dbe_bkey_copy(k, (dbe_bkey_t*)keys);
+
+        for (i = 0; i < n->n_count; i++) {
+            if (i > 0) {
+                if (n->n_info & BNODE_MISMATCHARRAY) {
+                    bnode_getkeyoffset(n, i, kpos);
+                    keys = &n->n_keys[kpos];
+                } else {
+                    keys += dbe_bkey_getlength((dbe_bkey_t*)keys);
+                }
+                dbe_bkey_expand(k, k, (dbe_bkey_t*)keys);
+            }
+            (*childfun)(ctx, k);
+        }
+
+        dbe_bkey_done(k);
+}
+
 /*##**********************************************************************\
  *
  *		dbe_bnode_searchnode
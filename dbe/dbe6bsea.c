@@ -92,6 +92,8 @@ Example:
 
 #include "dbe9type.h"
 #include "dbe8cach.h"
+#include "dbe6gobj.h"
+#include "dbe6finf.h"
 #include "dbe6bkey.h"
 #include "dbe6srk.h"
 #include "dbe6bkrs.h"
@@ -103,6 +105,11 @@ Example:
 
 #define LONGSEQSEA_NREADLEAFS   5
 
+/* Adaptive read-ahead window grows up to this many times the size
+ * set with dbe_btrsea_setreadaheadsize.
+ */
+#define BSEA_READAHEAD_GROWFACTOR   4
+
 typedef enum {
         BSEA_GETNODE_NEXT,
         BSEA_GETNODE_PREV,
@@ -1576,6 +1583,8 @@ void dbe_btrsea_initbufvalidate_ex(
         bs->bs_nmergeremoved = 0;
         bs->bs_nreadleafs = 0;
         bs->bs_readaheadsize = 0;
+        bs->bs_readaheadmax = 0;
+        bs->bs_readaheadleafs = 0;
         bs->bs_keypos = DBE_KEYPOS_LAST;
         bs->bs_bonsaip = b->b_bonsaip;
         bs->bs_mergetrxnum = DBE_TRXNUM_NULL;
@@ -1760,6 +1769,8 @@ void dbe_btrsea_reset(
         bs->bs_nmergeremoved = 0;
         bs->bs_nreadleafs = 0;
         bs->bs_readaheadsize = 0;
+        bs->bs_readaheadmax = 0;
+        bs->bs_readaheadleafs = 0;
         bs->bs_keypos = DBE_KEYPOS_LAST;
         bs->bs_lockingread = lockingread;
         ss_dassert(!bs->bs_unlock_tree);
@@ -2042,6 +2053,9 @@ static dbe_ret_t btrsea_checkcons(
                             bs->bs_kc->kc_cd,
                             bs->bs_srk,
                             bs->bs_kc->kc_conslist);
+                if (!succp) {
+                    SS_PMON_ADD(SS_PMON_KEYFILTER);
+                }
             } else if (trxresult == DBE_TRXST_BEGIN ||
 #ifdef DBE_REPLICATION
                        trxresult == DBE_TRXST_TOBEABORTED ||
@@ -2095,12 +2109,20 @@ static dbe_ret_t btrsea_checkcons(
                         dbe_srk_getbkey(bs->bs_srk),
                         bs->bs_bonsaip,
                         bs->bs_validatesea,
-                        &trxresult) 
-                    &&
-                    dbe_btrsea_checkkeycons(
-                        bs->bs_kc->kc_cd,
-                        bs->bs_srk,
-                        bs->bs_kc->kc_conslist);
+                        &trxresult);
+            if (succp) {
+                /* Key constraints are checked against the index entry
+                 * before any data tuple is dereferenced, so a reject here
+                 * saves a clustering key lookup.
+                 */
+                succp = dbe_btrsea_checkkeycons(
+                            bs->bs_kc->kc_cd,
+                            bs->bs_srk,
+                            bs->bs_kc->kc_conslist);
+                if (!succp) {
+                    SS_PMON_ADD(SS_PMON_KEYFILTER);
+                }
+            }
         }
         SU_GENERIC_TIMER_STOP(SU_GENERIC_TIMER_DBE_CHECKCONS);
         if (succp) {
@@ -2111,6 +2133,68 @@ static dbe_ret_t btrsea_checkcons(
         }
 }
 
+/*#***********************************************************************\
+ *
+ *		btrsea_adaptreadahead
+ *
+ * Adjusts the read-ahead window of a long sequential search. The window
+ * is checked after every window full of leafs. It is halved if
+ * prefetched pages were replaced in the cache before they were used,
+ * and doubled up to bs_readaheadmax if prefetched pages were used.
+ *
+ * Parameters :
+ *
+ *	bs - in out, use
+ *		tree search
+ *
+ * Return value :
+ *
+ * Comments :
+ *
+ *      Cache prefetch counters are global, so concurrent scans see
+ *      each other's waste. That is intended, wasted prefetches mean the
+ *      cache cannot hold the current read-ahead of all scans.
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+static void btrsea_adaptreadahead(dbe_btrsea_t* bs)
+{
+        long nused;
+        long nwasted;
+        long dused;
+        long dwasted;
+
+        if (bs->bs_nreadleafs - bs->bs_readaheadleafs
+            < (long)bs->bs_readaheadsize) {
+            return;
+        }
+        dbe_cache_getprefetchinfo(
+            bs->bs_go->go_idxfd->fd_cache,
+            &nused,
+            &nwasted);
+        if (bs->bs_readaheadleafs > 0) {
+            dused = nused - bs->bs_prefetchused;
+            dwasted = nwasted - bs->bs_prefetchwasted;
+            if (dwasted > 0 && 4 * dwasted > dused) {
+                if (bs->bs_readaheadsize > 1) {
+                    bs->bs_readaheadsize /= 2;
+                }
+            } else if (dused > 0) {
+                bs->bs_readaheadsize *= 2;
+                if (bs->bs_readaheadsize > bs->bs_readaheadmax) {
+                    bs->bs_readaheadsize = bs->bs_readaheadmax;
+                }
+            }
+            ss_dprintf_2(("btrsea_adaptreadahead:used %ld, wasted %ld, window %u\n",
+                dused, dwasted, bs->bs_readaheadsize));
+        }
+        bs->bs_readaheadleafs = bs->bs_nreadleafs;
+        bs->bs_prefetchused = nused;
+        bs->bs_prefetchwasted = nwasted;
+}
+
 /*##**********************************************************************\
  *
  *		dbe_btrsea_getnext
@@ -2343,6 +2427,9 @@ dbe_ret_t dbe_btrsea_getnext(
                         bs->bs_nreadleafs > LONGSEQSEA_NREADLEAFS) {
                         bs->bs_longseqsea = 1;
                     }
+                    if (bs->bs_longseqsea && bs->bs_readaheadmax > 0) {
+                        btrsea_adaptreadahead(bs);
+                    }
                     break;
 
                 default:
@@ -2985,7 +3072,9 @@ void dbe_btrsea_clearlongseqsea(dbe_btrsea_t* bs)
  *
  *		dbe_btrsea_setreadaheadsize
  *
- *
+ * Sets the initial read-ahead window of a long sequential search.
+ * The window adapts to cache usage of prefetched pages, see
+ * btrsea_adaptreadahead.
  *
  * Parameters :
  *
@@ -2993,12 +3082,15 @@ void dbe_btrsea_clearlongseqsea(dbe_btrsea_t* bs)
  *
  *
  *	readaheadsize -
- *
+ *		initial window in leafs, zero disables read-ahead
  *
  * Return value :
  *
  * Comments :
  *
+ *      Merge searches never grow above readaheadsize because their
+ *      callers limit it by the merge pool size.
+ *
  * Globals used :
  *
  * See also :
@@ -3010,6 +3102,12 @@ void dbe_btrsea_setreadaheadsize(
         CHK_BTRSEA(bs);
 
         bs->bs_readaheadsize = readaheadsize;
+        if (bs->bs_mergesea) {
+            bs->bs_readaheadmax = readaheadsize;
+        } else {
+            bs->bs_readaheadmax = readaheadsize * BSEA_READAHEAD_GROWFACTOR;
+        }
+        bs->bs_readaheadleafs = 0;
 }
 
 /*##**********************************************************************\
@@ -105,6 +105,7 @@ Example:
 #include "dbe6bnod.h"
 #include "dbe6btre.h"
 #include "dbe6finf.h"
+#include "dbe6iom.h"
 #include "dbe0db.h"
 
 extern bool         dbe_reportindex;
@@ -757,6 +758,302 @@ dbe_ret_t dbe_btree_nodepath_relocate(
         return(dbe_btree_nodepath_relocate_getnewaddr(path, b, NULL, info));
 }
 
+typedef struct {
+        su_rbt_t*       rc_rbt;
+        dbe_gobj_t*     rc_go;
+        su_daddr_t      rc_minaddr;
+        su_daddr_t      rc_maxaddr;
+        uint            rc_maxnodes;
+        uint            rc_level;   /* Level of the child nodes. */
+} btree_relocctx_t;
+
+static int btree_relocnode_compare(void* key1, void* key2)
+{
+        dbe_btree_relocnode_t* rn1 = key1;
+        dbe_btree_relocnode_t* rn2 = key2;
+
+        return(su_rbt_long_compare(rn1->rn_addr, rn2->rn_addr));
+}
+
+static void btree_relocnode_done(void* key)
+{
+        dbe_btree_relocnode_t* rn = key;
+
+        dbe_dynbkey_free(&rn->rn_key);
+        SsMemFree(rn);
+}
+
+/*#***********************************************************************\
+ *
+ *		btree_relocnode_add
+ *
+ * Adds a node to the relocation candidates if its address is inside
+ * the requested range. Only the maxnodes highest addresses are kept.
+ *
+ * Parameters :
+ *
+ *	rc - in out, use
+ *		relocation context
+ *
+ *	addr - in
+ *		node address
+ *
+ *	level - in
+ *		node level
+ *
+ *	k - in, use
+ *		key value that leads to the node in the tree
+ *
+ * Return value :
+ *
+ * Limitations  :
+ *
+ * Globals used :
+ */
+static void btree_relocnode_add(
+        btree_relocctx_t* rc,
+        su_daddr_t addr,
+        uint level,
+        dbe_bkey_t* k)
+{
+        dbe_btree_relocnode_t* rn;
+
+        if (addr < rc->rc_minaddr || addr > rc->rc_maxaddr) {
+            return;
+        }
+        rn = SSMEM_NEW(dbe_btree_relocnode_t);
+        rn->rn_addr = addr;
+        rn->rn_level = level;
+        rn->rn_nretry = 0;
+        rn->rn_key = NULL;
+        dbe_dynbkey_setbkey(&rn->rn_key, k);
+        if (!su_rbt_insert(rc->rc_rbt, rn)) {
+            /* Same node reached twice, should not happen. */
+            btree_relocnode_done(rn);
+            return;
+        }
+        if (su_rbt_nelems(rc->rc_rbt) > rc->rc_maxnodes) {
+            su_rbt_delete(rc->rc_rbt, su_rbt_min(rc->rc_rbt, NULL));
+        }
+}
+
+/*#***********************************************************************\
+ *
+ *		btree_relocnode_addchild
+ *
+ * Called for each key value in a non-leaf node. Adds the child node
+ * to the candidates and descends to it if it is not a leaf.
+ *
+ * Parameters :
+ *
+ *	ctx - in out, use
+ *		relocation context
+ *
+ *	k - in, use
+ *		expanded key value in the parent node
+ *
+ * Return value :
+ *
+ * Limitations  :
+ *
+ * Globals used :
+ */
+static void btree_relocnode_addchild(void* ctx, dbe_bkey_t* k)
+{
+        btree_relocctx_t* rc = ctx;
+        dbe_bnode_t* n;
+        dbe_info_t info;
+        su_daddr_t addr;
+
+        addr = dbe_bkey_getaddr(k);
+        btree_relocnode_add(rc, addr, rc->rc_level, k);
+
+        if (rc->rc_level > 0) {
+            /* Reached from the permanent tree root, so this is
+             * a permanent tree node.
+             */
+            dbe_info_init(info, DBE_INFO_TREEPRELOCKED);
+            n = dbe_bnode_getreadonly(rc->rc_go, addr, FALSE, &info);
+            if (n != NULL) {
+                rc->rc_level--;
+                dbe_bnode_getchildkeys(n, btree_relocnode_addchild, rc);
+                rc->rc_level++;
+                dbe_bnode_write(n, FALSE);
+            }
+        }
+}
+
+/*##*********************************************************************\
+ *
+ *		dbe_btree_getrelocatenodes
+ *
+ * Collects candidate nodes for online defragmentation. The tree is
+ * walked from the root, so only nodes that really belong to this
+ * tree are returned. Leaf nodes are not read, their addresses and
+ * key values are taken from the parent nodes.
+ *
+ * Parameters :
+ *
+ *	b - in, use
+ *		permanent index tree
+ *
+ *      minaddr - in
+ *          lowest accepted node address
+ *
+ *      maxaddr - in
+ *          highest accepted node address
+ *
+ *      maxnodes - in
+ *          at most this many nodes with the highest addresses
+ *          are returned
+ *
+ * Return value - give :
+ *
+ *      Tree of dbe_btree_relocnode_t ordered by node address. The
+ *      caller releases it with su_rbt_done.
+ *
+ * Limitations  :
+ *
+ * Globals used :
+ */
+su_rbt_t* dbe_btree_getrelocatenodes(
+        dbe_btree_t* b,
+        su_daddr_t minaddr,
+        su_daddr_t maxaddr,
+        uint maxnodes)
+{
+        btree_relocctx_t rc;
+        dbe_info_t info;
+        dbe_bnode_t* n;
+
+        ss_bprintf_1(("dbe_btree_getrelocatenodes:minaddr=%ld, maxaddr=%ld\n",
+            (long)minaddr, (long)maxaddr));
+        BTREE_CHK(b);
+        ss_dassert(!b->b_bonsaip);
+
+        rc.rc_rbt = su_rbt_init(btree_relocnode_compare, btree_relocnode_done);
+        rc.rc_go = b->b_go;
+        rc.rc_minaddr = minaddr;
+        rc.rc_maxaddr = maxaddr;
+        rc.rc_maxnodes = maxnodes;
+
+        if (maxnodes == 0) {
+            return(rc.rc_rbt);
+        }
+
+        dbe_btree_lock_shared(b);
+
+        dbe_info_init(info, DBE_INFO_TREEPRELOCKED);
+        n = dbe_bnode_getreadonly(b->b_go, b->b_rootaddr, FALSE, &info);
+        if (n != NULL) {
+            if (dbe_bnode_getkeycount(n) > 0) {
+                btree_relocnode_add(
+                    &rc,
+                    b->b_rootaddr,
+                    dbe_bnode_getlevel(n),
+                    dbe_bnode_getfirstkey(n));
+                if (dbe_bnode_getlevel(n) > 0) {
+                    rc.rc_level = dbe_bnode_getlevel(n) - 1;
+                    dbe_bnode_getchildkeys(n, btree_relocnode_addchild, &rc);
+                }
+            }
+            dbe_bnode_write(n, FALSE);
+        }
+
+        dbe_btree_unlock(b);
+
+        return(rc.rc_rbt);
+}
+
+/*##*********************************************************************\
+ *
+ *		dbe_btree_relocatenode
+ *
+ * Moves a tree node to the lowest free block of the database file.
+ * Used by online defragmentation to empty the end of the file. The
+ * candidate comes from dbe_btree_getrelocatenodes and may be out of
+ * date. The node is searched from the tree using the candidate key
+ * value and it is moved only if the search leads to the same address
+ * at the same level. The candidate address itself is never read.
+ * Nodes that are already changed in the current checkpoint are not
+ * moved, they can be moved after the next checkpoint. The nodes below
+ * the candidate in the search path are not moved.
+ *
+ * Parameters :
+ *
+ *	b - in out, use
+ *		permanent index tree
+ *
+ *      rn - in
+ *          candidate node
+ *
+ *      p_newaddr - out
+ *          new node address, or SU_DADDR_NULL if the node was not moved
+ *
+ * Return value :
+ *
+ *      DBE_RC_SUCC  - node moved or no longer a candidate
+ *      DBE_RC_RETRY - node is changed in the current checkpoint
+ *      error code
+ *
+ * Limitations  :
+ *
+ * Globals used :
+ */
+dbe_ret_t dbe_btree_relocatenode(
+        dbe_btree_t* b,
+        dbe_btree_relocnode_t* rn,
+        su_daddr_t* p_newaddr)
+{
+        dbe_info_t info;
+        dbe_bnode_t* n;
+        su_list_t* path;
+        su_daddr_t newaddr;
+        dbe_ret_t rc = DBE_RC_SUCC;
+
+        ss_bprintf_1(("dbe_btree_relocatenode:addr=%ld, level=%d\n",
+            (long)rn->rn_addr, rn->rn_level));
+        BTREE_CHK(b);
+        ss_dassert(!b->b_bonsaip);
+
+        *p_newaddr = SU_DADDR_NULL;
+
+        dbe_btree_lock_exclusive(b);
+
+        if (rn->rn_level > b->b_maxlevel) {
+            dbe_btree_unlock(b);
+            return(DBE_RC_SUCC);
+        }
+
+        dbe_info_init(info, DBE_INFO_TREEPRELOCKED|DBE_INFO_DEFRAG);
+        path = dbe_btree_nodepath_init(b, rn->rn_key, TRUE, &info, DBE_NODEPATH_GENERIC);
+
+        /* Release nodes below the candidate level, they are not moved. */
+        n = su_listnode_getdata(su_list_last(path));
+        while (dbe_bnode_getlevel(n) < rn->rn_level) {
+            n = su_list_removelast(path);
+            dbe_bnode_write(n, FALSE);
+            n = su_listnode_getdata(su_list_last(path));
+        }
+        if (dbe_bnode_getlevel(n) == rn->rn_level
+            && dbe_bnode_getaddr(n) == rn->rn_addr)
+        {
+            if (dbe_bnode_getcpnum(n) == dbe_counter_getcpnum(b->b_go->go_ctr)) {
+                rc = DBE_RC_RETRY;
+            } else {
+                newaddr = 0;
+                rc = dbe_btree_nodepath_relocate_getnewaddr(path, b, &newaddr, &info);
+                if (rc == DBE_RC_SUCC && newaddr != 0) {
+                    *p_newaddr = newaddr;
+                }
+            }
+        }
+        dbe_btree_nodepath_done(path);
+        dbe_btree_unlock(b);
+
+        return(rc);
+}
+
 SS_INLINE bool dbe_btree_lockinfo_lock(dbe_btree_t* b, dbe_info_t* info, dbe_bnode_t* n, bool btree_locked)
 {
         if (!dbe_cfg_usenewbtreelocking) {
@@ -2522,3 +2819,181 @@ void dbe_btree_getkeysamples(
 
 #endif /* SS_NOESTSAMPLES */
 
+static int SS_CLIBCALLBACK prefetch_qsortcmp(const void* s1, const void* s2)
+{
+        vtpl_t* v1 = *(vtpl_t**)s1;
+        vtpl_t* v2 = *(vtpl_t**)s2;
+        int cmp;
+
+        cmp = vtpl_compare(v1, v2);
+        if (cmp < 0) {
+            return(-1);
+        } else if (cmp > 0) {
+            return(1);
+        } else {
+            return(0);
+        }
+}
+
+/*#***********************************************************************\
+ *
+ *		btree_getleafaddr
+ *
+ * Returns the address of the leaf node where a key value belongs. Only
+ * the higher level nodes are read, the leaf itself is not.
+ *
+ * Parameters :
+ *
+ *	b - in, use
+ *		index tree
+ *
+ *	k - in, use
+ *		key value
+ *
+ *	info - in, use
+ *		info for node reads
+ *
+ * Return value :
+ *
+ *      leaf address, or SU_DADDR_NULL if the root is a leaf
+ *
+ * Limitations  :
+ *
+ * Globals used :
+ */
+static su_daddr_t btree_getleafaddr(
+        dbe_btree_t* b,
+        dbe_bkey_t* k,
+        dbe_info_t* info)
+{
+        su_daddr_t addr;
+        dbe_bnode_t* n;
+        dbe_bnode_t* tmpn;
+        dbe_bnode_t* rootnode;
+        bool unlock_tree;
+        uint level;
+
+        dbe_btree_lock_shared(b);
+        unlock_tree = TRUE;
+
+        n = dbe_btree_getrootnode_nomutex(b);
+        rootnode = n;
+        if (n == NULL) {
+            n = dbe_bnode_getreadonly(b->b_go, b->b_rootaddr, b->b_bonsaip, info);
+        }
+
+        for (;;) {
+            level = dbe_bnode_getlevel(n);
+            if (level == 0) {
+                addr = SU_DADDR_NULL;
+                break;
+            }
+            addr = dbe_bnode_searchnode(n, k, TRUE);
+            if (level == 1) {
+                break;
+            }
+            tmpn = dbe_bnode_getreadonly(b->b_go, addr, b->b_bonsaip, info);
+            if (n != rootnode) {
+                dbe_bnode_write(n, FALSE);
+            }
+            if (unlock_tree && dbe_cfg_usenewbtreelocking) {
+                dbe_btree_unlock(b);
+                unlock_tree = FALSE;
+            }
+            n = tmpn;
+        }
+
+        if (n != rootnode) {
+            dbe_bnode_write(n, FALSE);
+        }
+        if (unlock_tree) {
+            dbe_btree_unlock(b);
+        }
+        return(addr);
+}
+
+/*##**********************************************************************\
+ *
+ *		dbe_btree_prefetchleaves
+ *
+ * Adds prefetch requests for the leaf nodes where the given key values
+ * belong. The key values are sorted first, so the tree is descended in
+ * key order and each leaf is requested only once. Used to read the
+ * clustering key leaves of a batch of tuple references with sequential
+ * I/O before the data tuples are searched one by one.
+ *
+ * Parameters :
+ *
+ *	b - in, use
+ *		index tree
+ *
+ *	vtpls - in out, use
+ *		array of key v-tuples, the array is sorted
+ *
+ *	nvtpl - in
+ *		number of elements in vtpls
+ *
+ * Return value :
+ *
+ *      number of leaves given to the I/O manager
+ *
+ * Limitations  :
+ *
+ * Globals used :
+ */
+int dbe_btree_prefetchleaves(
+        dbe_btree_t* b,
+        vtpl_t** vtpls,
+        int nvtpl)
+{
+        dbe_bkey_t* k;
+        su_daddr_t* addrs;
+        su_daddr_t addr;
+        dbe_info_t info;
+        int naddr;
+        int i;
+
+        ss_bprintf_1(("dbe_btree_prefetchleaves:nvtpl=%d\n", nvtpl));
+        BTREE_CHK(b);
+
+        if (nvtpl <= 0) {
+            return(0);
+        }
+
+        dbe_info_init(info, 0);
+
+        qsort(vtpls, nvtpl, sizeof(vtpls[0]), prefetch_qsortcmp);
+
+        addrs = SsMemAlloc(nvtpl * sizeof(addrs[0]));
+        naddr = 0;
+
+        k = dbe_bkey_init(b->b_go->go_bkeyinfo);
+
+        for (i = 0; i < nvtpl; i++) {
+            dbe_bkey_setvtpl(k, vtpls[i]);
+            addr = btree_getleafaddr(b, k, &info);
+            if (addr == SU_DADDR_NULL) {
+                /* Root is a leaf, it is already in memory. */
+                break;
+            }
+            if (naddr == 0 || addrs[naddr - 1] != addr) {
+                addrs[naddr++] = addr;
+            }
+        }
+
+        dbe_bkey_done(k);
+
+        if (naddr > 0) {
+            dbe_iomgr_prefetch(
+                b->b_go->go_iomgr,
+                addrs,
+                naddr,
+                info.i_flags);
+        }
+
+        SsMemFree(addrs);
+
+        ss_bprintf_2(("dbe_btree_prefetchleaves:naddr=%d\n", naddr));
+
+        return(naddr);
+}
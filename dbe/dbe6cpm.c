@@ -1182,6 +1182,10 @@ static void cpmgr_createcp_file(
 {
         su_ret_t rc;
 
+        /* cut free blocks at the end of the file, the new size is
+         * saved to the checkpoint record
+         */
+        dbe_fl_shrink(filedes->fd_freelist);
         /* allocate 1 extra block from freelist */
         rc = dbe_cl_preparetosave(filedes->fd_chlist);
         su_rc_assert(rc == SU_SUCCESS, rc);
@@ -214,6 +214,9 @@ dbe_cache_t *dbe_cache_cfg_init(
         size_t cache_size;
         dbe_cache_t *dbcache = NULL;
         ulong maxpagesemcount;
+        uint cache_nlru;
+        uint cache_policy;
+        long cache_probationtime;
         uint cache_preflushpercent;
         uint cache_lastuseskippercent;
 
@@ -230,16 +233,24 @@ dbe_cache_t *dbe_cache_cfg_init(
         found = dbe_cfg_getidxpreflushperc(cfg, &cache_preflushpercent);
         found = dbe_cfg_getidxlastuseLRUskipperc(cfg, &cache_lastuseskippercent);
         found = dbe_cfg_getidxmaxpagesemcount(cfg, &maxpagesemcount);
+        found = dbe_cfg_getidxcachelrupartitions(cfg, &cache_nlru);
+        found = dbe_cfg_getidxcachepolicy(cfg, &cache_policy);
+        found = dbe_cfg_getidxcacheprobationtime(cfg, &cache_probationtime);
 
         dbcache = dbe_cache_init(
                     svfil,
                     (uint)(cache_size / blocksize),
-                    (uint)maxpagesemcount);
+                    (uint)maxpagesemcount,
+                    cache_nlru);
         succp = dbe_cache_setpreflushinfo(
                         dbcache,
                         cache_preflushpercent,
                         cache_lastuseskippercent);
         ss_dassert(succp);
+        dbe_cache_setreplacementpolicy(
+                dbcache,
+                (dbe_cache_policy_t)cache_policy,
+                cache_probationtime);
 
         return dbcache;
 }
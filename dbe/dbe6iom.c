@@ -69,6 +69,7 @@ Example:
 #include <ssstring.h>
 #include <ssservic.h>
 #include <sscacmem.h>
+#include <ssfile.h>
 
 #include <su0parr.h>
 #include <su0rbtr.h>
@@ -881,6 +882,72 @@ static void iomgr_freeslotbuf(
         }
 }
 
+#ifdef MME_CP_FIX
+
+/*#***********************************************************************\
+ *
+ *		iomgr_prefetch_n
+ *
+ * Executes a batch of prefetch requests with one list I/O call
+ * and completes the requests.
+ *
+ * Parameters :
+ *
+ *	devqueue - in out, use
+ *		device queue, mutex not held on entry or exit
+ *
+ *	filedes - in, use
+ *		file descriptor of the device queue
+ *
+ *	addrs - in
+ *		page addresses to prefetch
+ *
+ *	reqs - in, take
+ *		requests, completed and freed
+ *
+ *	nreqs - in
+ *		number of requests
+ *
+ *	naddrs - in
+ *		number of addresses, expired requests have no address
+ *
+ *	infoflags - in
+ *		info flags of the requests
+ *
+ * Return value :
+ *
+ * Comments :
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+static void iomgr_prefetch_n(
+        iomgr_devqueue_t* devqueue,
+        dbe_filedes_t* filedes,
+        su_daddr_t* addrs,
+        iomgr_request_t** reqs,
+        ulong nreqs,
+        ulong naddrs,
+        dbe_info_flags_t infoflags)
+{
+        ulong i;
+
+        ss_dprintf_2(("iomgr_prefetch_n: nreqs=%lu, naddrs=%lu\n",
+            nreqs, naddrs));
+        if (naddrs > 0) {
+            dbe_cache_prefetch_n(filedes->fd_cache, addrs, naddrs, infoflags);
+        }
+        SsSemEnter(devqueue->iodq_mutex);
+        for (i = 0; i < nreqs; i++) {
+            iomgr_wakeup(&reqs[i]->ior_wait);
+            request_done(reqs[i]);
+        }
+        SsSemExit(devqueue->iodq_mutex);
+}
+
+#endif /* MME_CP_FIX */
+
 #endif /* DBE_NONBLOCKING_PAGEFLUSH */
 
 /*#***********************************************************************\
@@ -919,6 +986,11 @@ static void iomgr_threadfun(void)
         ulong                   nflushes;
         iomgr_request_t*        reqs[DBE_CACHE_MAXNFLUSHES];
         bool                    reqispending;
+        su_daddr_t              prefetches[DBE_CACHE_MAXNFLUSHES];
+        iomgr_request_t*        prefetchreqs[DBE_CACHE_MAXNFLUSHES];
+        ulong                   nprefetchreqs;
+        ulong                   nprefetches;
+        dbe_info_flags_t        prefetchinfoflags = 0;
 #endif
 #endif /* DBE_NONBLOCKING_PAGEFLUSH */
         ss_beta(int thrinfoid;)
@@ -994,6 +1066,8 @@ static void iomgr_threadfun(void)
             }
 #ifdef MME_CP_FIX
             nflushes = 0;
+            nprefetchreqs = 0;
+            nprefetches = 0;
 #endif
             while (treenode != NULL) {
 #ifdef SS_NTHREADS_PER_DEVQUEUE
@@ -1043,6 +1117,43 @@ static void iomgr_threadfun(void)
                                    || devqueue->iodq_type ==
                                       IOM_DEVQUEUE_READWRITE,
                                       devqueue->iodq_type);
+#if defined(DBE_NONBLOCKING_PAGEFLUSH) && defined(MME_CP_FIX)
+                        /* Collect prefetches to a batch that is read
+                         * with one list I/O request.
+                         */
+                        if (nprefetchreqs > 0
+                            && prefetchinfoflags != req->ior_infoflags)
+                        {
+                            iomgr_prefetch_n(
+                                    devqueue,
+                                    filedes,
+                                    prefetches,
+                                    prefetchreqs,
+                                    nprefetchreqs,
+                                    nprefetches,
+                                    prefetchinfoflags);
+                            nprefetchreqs = 0;
+                            nprefetches = 0;
+                        }
+                        prefetchinfoflags = req->ior_infoflags;
+                        if (!req->ior_expired) {
+                            prefetches[nprefetches++] = req->ior_daddr;
+                        }
+                        prefetchreqs[nprefetchreqs++] = req;
+                        reqispending = TRUE;
+                        if (nprefetchreqs == DBE_CACHE_MAXNFLUSHES) {
+                            iomgr_prefetch_n(
+                                    devqueue,
+                                    filedes,
+                                    prefetches,
+                                    prefetchreqs,
+                                    nprefetchreqs,
+                                    nprefetches,
+                                    prefetchinfoflags);
+                            nprefetchreqs = 0;
+                            nprefetches = 0;
+                        }
+#else /* DBE_NONBLOCKING_PAGEFLUSH && MME_CP_FIX */
                         if (!req->ior_expired) {
                             cacheslot =
                                 dbe_cache_reach(
@@ -1060,6 +1171,7 @@ static void iomgr_threadfun(void)
                                     DBE_CACHE_CLEAN,
                                     iom_prefetch);
                         }
+#endif /* DBE_NONBLOCKING_PAGEFLUSH && MME_CP_FIX */
                         break;
                     case IOM_CACHE_PREFLUSH:
                         ss_dprintf_2(("iomgr_threadfun: PREFLUSH addr=%lu\n",
@@ -1072,7 +1184,45 @@ static void iomgr_threadfun(void)
                                    || devqueue->iodq_type ==
                                       IOM_DEVQUEUE_READWRITE,
                                       devqueue->iodq_type);
-#ifdef DBE_NONBLOCKING_PAGEFLUSH
+#if defined(DBE_NONBLOCKING_PAGEFLUSH) && defined(MME_CP_FIX)
+                        /* Preflushes are written in the same list I/O
+                         * batch as flushes.
+                         */
+                        flushes[nflushes].fa_addr = req->ior_daddr;
+                        flushes[nflushes].fa_preflush = TRUE;
+#ifdef SS_MME
+                        flushes[nflushes].fa_mmeslot = req->ior_.mmepage;
+#else /* SS_MME */
+                        flushes[nflushes].fa_mmeslot = FALSE;
+#endif /* SS_MME */
+                        flushes[nflushes].fa_writebuf = NULL;
+                        flushes[nflushes].fa_infoflags = req->ior_infoflags;
+                        reqs[nflushes] = req;
+                        reqispending = TRUE;
+                        nflushes++;
+
+                        if (nflushes == DBE_CACHE_MAXNFLUSHES) {
+                            dbe_cache_flushaddr_n(
+                                    filedes->fd_cache,
+                                    flushes,
+                                    nflushes);
+                            SsSemEnter(devqueue->iodq_mutex);
+                            for (i = 0; i < nflushes; i++) {
+                                if (reqs[i]->ior_type
+                                    == IOM_CACHE_FLUSHPAGEBATCH) {
+                                    iomgr_flushbatch_dec(
+                                            reqs[i]->ior_.flushbatch,
+                                            filedes->fd_cache,
+                                            reqs[i]->ior_.mmepage);
+                                }
+                                iomgr_wakeup(&reqs[i]->ior_wait);
+                                request_done(reqs[i]);
+                            }
+
+                            nflushes = 0;
+                            SsSemExit(devqueue->iodq_mutex);
+                        }
+#elif defined(DBE_NONBLOCKING_PAGEFLUSH)
                         iomgr_allocslotbuf(
                                 &cacmem,
                                 &slotbuf,
@@ -1246,6 +1396,20 @@ static void iomgr_threadfun(void)
             ss_dprintf_1(("iomgr_threadfun: req pool empty\n"));
 
 #ifdef MME_CP_FIX
+            if (nprefetchreqs > 0) {
+                SsSemExit(devqueue->iodq_mutex);
+                iomgr_prefetch_n(
+                        devqueue,
+                        filedes,
+                        prefetches,
+                        prefetchreqs,
+                        nprefetchreqs,
+                        nprefetches,
+                        prefetchinfoflags);
+                SsSemEnter(devqueue->iodq_mutex);
+                nprefetchreqs = 0;
+                nprefetches = 0;
+            }
             if (nflushes > 0) {
                 SsSemExit(devqueue->iodq_mutex);
                 dbe_cache_flushaddr_n(
@@ -1838,6 +2002,9 @@ dbe_iomgr_t* dbe_iomgr_init(dbe_file_t* file, dbe_cfg_t* cfg)
         bool found;
         dbe_iomgr_t* iomgr;
         long maxmmecacheusage;
+#ifdef MME_CP_FIX
+        bool useiouring;
+#endif /* MME_CP_FIX */
 
         iomgr = SSMEM_NEW(dbe_iomgr_t);
         iomgr->iom_file = file;
@@ -1846,6 +2013,10 @@ dbe_iomgr_t* dbe_iomgr_init(dbe_file_t* file, dbe_cfg_t* cfg)
         iomgr->iom_meslist = NULL;
         found = dbe_cfg_getuseiothreads(cfg, &iomgr->iom_useiothreads);
         found = dbe_cfg_getmmemaxcacheusage(cfg, &maxmmecacheusage);
+#ifdef MME_CP_FIX
+        found = dbe_cfg_getuseiouring(cfg, &useiouring);
+        SsFileListIOSetUring(useiouring);
+#endif /* MME_CP_FIX */
 
 #ifdef SS_NTHREADS_PER_DEVQUEUE
         dbe_cfg_getnumiothreads(cfg, &iomgr->iom_nthreads_total);
@@ -1962,6 +2133,10 @@ void dbe_iomgr_done(dbe_iomgr_t* iomgr)
         }
         su_pa_done(iomgr->iom_devqueues);
 #endif /* SS_NTHREADS_PER_DEVICE */
+#ifdef MME_CP_FIX
+        /* All I/O threads are stopped, release cached I/O rings. */
+        SsFileListIOGlobalDone();
+#endif /* MME_CP_FIX */
         SsSemFree(iomgr->iom_mutex);
         SsMemFree(iomgr);
 }
@@ -67,6 +67,7 @@ Example:
 #include <sstime.h>
 #include <ssthread.h>
 #include <sspmon.h>
+#include <ssatomic.h>
 
 #include <uti0va.h>
 
@@ -88,7 +89,42 @@ Example:
 #ifndef LMGR_NMUTEXES
 #define LMGR_NMUTEXES 101
 #endif
-#define LMGR_MUTEX(lm, name)  (((name) % (lm)->lm_hashsize) % lmgr_nmutexes)
+#define LMGR_MUTEX(lm, name)  ((name) % lmgr_nmutexes)
+#define LMGR_STRIPE(lm, name) (&(lm)->lm_stripe[LMGR_MUTEX(lm, name)])
+#endif
+
+/* Stripe hash table is grown when there are more lock heads per bucket. */
+#define LMGR_MAXLOADFACTOR      2
+#define LMGR_MAXSTRIPEHASHSIZE  (1024L * 1024L * 16L)
+
+/* Max number of free lock requests kept in each transaction. With split
+ * mutexes the requests are kept per stripe, because the pool is used
+ * under the mutex of the stripe the lock falls in.
+ */
+#ifdef LMGR_SPLITMUTEX
+#define LMGR_TRAN_NFREEREQUESTS 4
+#else
+#define LMGR_TRAN_NFREEREQUESTS 32
+#endif
+
+#if defined(LMGR_SPLITMUTEX) && defined(SS_MT)
+/* Deadlocks are detected by a background thread from the wait-for graph
+ * instead of inline in lmgr_lock. Inline detection would need to enter
+ * stripe mutexes in an arbitrary order.
+ */
+#define LMGR_BGDEADLOCK
+/* Max number of transactions in a resolved deadlock cycle. Mutexes of
+ * all stripes in the cycle are held while the cycle is validated.
+ */
+#define LMGR_MAXCYCLE           64
+#endif
+
+#ifdef SS_ATOMIC
+#define LMGR_LOCKCNT_ADD(lm, n) SsAtomicLongAdd(&(lm)->lm_lockcnt, (n))
+#define LMGR_NEXTSTARTSEQ(lm)   SsAtomicLongAdd(&(lm)->lm_startseq, 1)
+#else
+#define LMGR_LOCKCNT_ADD(lm, n) ((lm)->lm_lockcnt += (n))
+#define LMGR_NEXTSTARTSEQ(lm)   (++(lm)->lm_startseq)
 #endif
 
 
@@ -165,18 +201,59 @@ struct dbe_locktran_st {
 #endif
         lock_request_t* lt_wait;    /* lock waited by this transaction (or NULL) */
         dbe_locktran_t* lt_cycle;   /* used by deadlock detector */
+#ifdef LMGR_SPLITMUTEX
+        lock_request_t* lt_freereq[LMGR_NMUTEXES];  /* free requests private to
+                                                       this transaction */
+        uint            lt_nfreereq[LMGR_NMUTEXES];
+#else
+        lock_request_t* lt_freereq; /* free requests private to this transaction */
+        uint            lt_nfreereq;
+#endif
+        long            lt_startseq;/* lock manager start order, 0 if no locks */
+#ifdef LMGR_BGDEADLOCK
+        long            lt_waitrelid;       /* relid of the waited lock */
+        dbe_lockname_t  lt_waitname;        /* name of the waited lock */
+        long            lt_dlwaitrelid;     /* lt_waitrelid and lt_waitname */
+        dbe_lockname_t  lt_dlwaitname;      /* copied under lm_waitsem for
+                                               the deadlock detector */
+        bool            lt_deadlockvictim;  /* selected as a deadlock victim */
+        bool            lt_waitlisted;      /* in lock manager wait list */
+        dbe_lockmgr_t*  lt_lm;              /* lock manager of wait list */
+        dbe_locktran_t* lt_waitprev;        /* wait list links */
+        dbe_locktran_t* lt_waitnext;
+        ulong           lt_dlpass;          /* deadlock detector pass */
+        int             lt_dlindex;         /* graph node index in lt_dlpass */
+#endif
 };
 
+#ifdef LMGR_SPLITMUTEX
+/* Lock table stripe. Each stripe has its own mutex, hash table and free
+ * lists. The stripe hash table is grown online under the stripe mutex
+ * without stopping other stripes.
+ */
+typedef struct {
+        SsSemT*             ls_mutex;
+        lock_head_t**       ls_hash;        /* Hash table of this stripe. */
+        uint                ls_hashsize;    /* Hash table size. */
+        ulong               ls_nlocks;      /* Lock heads in hash table. */
+        lock_head_t*        ls_freelock;
+        ulong               ls_nfreelocks;
+        lock_request_t*     ls_freerequest;
+        ulong               ls_nfreerequests;
+} lmgr_stripe_t;
+#endif
+
 /* Lock manager object. Lock manager maintains a hash table of locked
  * objects.
  */
 struct dbe_lockmgr_st {
         ss_debug(dbe_chk_t  lm_chk;)
-        lock_head_t**       lm_hash;        /* Hash table. */
-        uint                lm_hashsize;    /* Hash table size. */
 #ifdef LMGR_SPLITMUTEX
-        SsSemT*             lm_mutex[LMGR_NMUTEXES];
+        lmgr_stripe_t       lm_stripe[LMGR_NMUTEXES];
+        ulong               lm_nresize;     /* Number of stripe resizes. */
 #else
+        lock_head_t**       lm_hash;        /* Hash table. */
+        uint                lm_hashsize;    /* Hash table size. */
         SsSemT*             lm_sem;         /* Lock manager mutex. */
 #endif
         long                lm_lockcnt;
@@ -191,11 +268,7 @@ struct dbe_lockmgr_st {
         ulong               lm_cachedrelid;
         lock_head_t*        lm_cachedlock;
 #ifdef LMGR_SPLITMUTEX
-        lock_head_t*        lm_freelock[LMGR_NMUTEXES];
-        ulong               lm_nfreelocks[LMGR_NMUTEXES];
         ulong               lm_maxfreelocks;
-        lock_request_t*     lm_freerequest[LMGR_NMUTEXES];
-        ulong               lm_nfreerequests[LMGR_NMUTEXES];
         ulong               lm_maxfreerequests;
 #else
         lock_head_t*        lm_freelock;
@@ -206,6 +279,20 @@ struct dbe_lockmgr_st {
         ulong               lm_maxfreerequests;
 #endif
         bool                lm_sharedsem;
+        long                lm_startseq;    /* Transaction start sequence. */
+#ifdef LMGR_BGDEADLOCK
+        bool                lm_deadlockdetect;
+        SsSemT*             lm_waitsem;     /* Wait list mutex. */
+        dbe_locktran_t*     lm_waitlist;    /* Transactions that have waited. */
+        uint                lm_nwaiting;
+        SsMesT*             lm_dlmes;       /* Wakes up deadlock thread. */
+        bool                lm_dlthreadp;   /* Deadlock thread is running. */
+        bool                lm_dlstop;
+        ulong               lm_dlpass;
+        ulong               lm_ndeadlockcheck;
+        ulong               lm_ndeadlock;   /* Resolved deadlock cycles. */
+        ulong               lm_deadlocktime;/* Time spent in detection, ms. */
+#endif
         /* PMON counters for MME lock manager.  See sspmon.[ch] */
         long                lm_maxnlocks;
         long                lm_nchains;
@@ -415,13 +502,16 @@ static dbe_lock_mode_t lockmgr_getrellockmode(dbe_lock_mode_t rowlockmode)
 
 /*#***********************************************************************\
  * 
- *		lmgr_print
+ *		lmgr_printhash
  * 
  * 
  * 
  * Parameters : 
  * 
- *	lm - 
+ *	hash - 
+ *		
+ *		
+ *	hashsize - 
  *		
  *		
  * Return value : 
@@ -432,16 +522,14 @@ static dbe_lock_mode_t lockmgr_getrellockmode(dbe_lock_mode_t rowlockmode)
  * 
  * See also : 
  */
-static void lmgr_print(dbe_lockmgr_t* lm)
+static void lmgr_printhash(lock_head_t** hash, uint hashsize)
 {
-        int i;
+        uint i;
         lock_head_t* lock;
         lock_request_t* req;
 
-        SsDbgPrintf("LOCKLIST BEGIN\n");
-
-        for (i = 0; i < lm->lm_hashsize; i++) {
-            lock = lm->lm_hash[i];
+        for (i = 0; i < hashsize; i++) {
+            lock = hash[i];
             while (lock != NULL) {
                 CHK_LOCKHEAD(lock);
                 SsDbgPrintf("lh_name=%ld, lh_granted_mode=%s, lh_waiting=%d\n",
@@ -457,9 +545,162 @@ static void lmgr_print(dbe_lockmgr_t* lm)
                 lock = lock->lh_chain;
             }
         }
+}
+
+/*#***********************************************************************\
+ * 
+ *		lmgr_print
+ * 
+ * 
+ * 
+ * Parameters : 
+ * 
+ *	lm - 
+ *		
+ *		
+ * Return value : 
+ * 
+ * Comments : 
+ * 
+ * Globals used : 
+ * 
+ * See also : 
+ */
+static void lmgr_print(dbe_lockmgr_t* lm)
+{
+        SsDbgPrintf("LOCKLIST BEGIN\n");
+
+#ifdef LMGR_SPLITMUTEX
+        {
+            int i;
+            for (i = 0; i < lmgr_nmutexes; i++) {
+                lmgr_printhash(lm->lm_stripe[i].ls_hash, lm->lm_stripe[i].ls_hashsize);
+            }
+        }
+#else
+        lmgr_printhash(lm->lm_hash, lm->lm_hashsize);
+#endif
         SsDbgPrintf("LOCKLIST END\n");
 }
 
+/*#***********************************************************************\
+ * 
+ *		lmgr_getbucket
+ * 
+ * Returns the hash chain where lock head of name is kept. The caller
+ * must hold the mutex that protects name.
+ * 
+ * Parameters : 
+ * 
+ *	lm - in, use
+ *		
+ *		
+ *	name - in
+ *		
+ *		
+ * Return value - ref : 
+ * 
+ *      Pointer to the first lock head pointer of the hash chain.
+ * 
+ * Comments : 
+ * 
+ * Globals used : 
+ * 
+ * See also : 
+ */
+static lock_head_t** lmgr_getbucket(dbe_lockmgr_t* lm, dbe_lockname_t name)
+{
+#ifdef LMGR_SPLITMUTEX
+        lmgr_stripe_t* ls;
+
+        ls = LMGR_STRIPE(lm, name);
+
+        /* Low bits select the stripe, use the rest within the stripe. */
+        return(&ls->ls_hash[(name / lmgr_nmutexes) % ls->ls_hashsize]);
+#else
+        return(&lm->lm_hash[name % lm->lm_hashsize]);
+#endif
+}
+
+#ifdef LMGR_SPLITMUTEX
+
+/*#***********************************************************************\
+ * 
+ *		lmgr_stripe_growif
+ * 
+ * Grows the stripe hash table when the stripe has more than
+ * LMGR_MAXLOADFACTOR lock heads per bucket. All lock heads are rehashed
+ * to a table about twice as large. Only the stripe mutex is needed so
+ * other stripes can be used during the resize.
+ * 
+ * Parameters : 
+ * 
+ *	lm - in, use
+ *		
+ *		
+ *	ls - in out, use
+ *		Stripe, the stripe mutex must be entered.
+ *		
+ * Return value : 
+ * 
+ *      TRUE if the table was resized.
+ * 
+ * Comments : 
+ * 
+ * Globals used : 
+ * 
+ * See also : 
+ */
+static bool lmgr_stripe_growif(dbe_lockmgr_t* lm, lmgr_stripe_t* ls)
+{
+        lock_head_t** newhash;
+        uint newsize;
+        uint i;
+        uint bucket;
+        lock_head_t* lock;
+        lock_head_t* next;
+        long nchains = 0;
+
+        if (ls->ls_nlocks <= (ulong)ls->ls_hashsize * LMGR_MAXLOADFACTOR
+            || ls->ls_hashsize >= LMGR_MAXSTRIPEHASHSIZE)
+        {
+            return(FALSE);
+        }
+
+        newsize = 2 * ls->ls_hashsize + 1;
+        ss_dprintf_2(("lmgr_stripe_growif:nlocks=%lu, hashsize %u -> %u\n",
+            ls->ls_nlocks, ls->ls_hashsize, newsize));
+
+        newhash = SsMemCalloc(newsize, sizeof(newhash[0]));
+
+        for (i = 0; i < ls->ls_hashsize; i++) {
+            if (ls->ls_hash[i] != NULL) {
+                nchains--;
+            }
+            for (lock = ls->ls_hash[i]; lock != NULL; lock = next) {
+                CHK_LOCKHEAD(lock);
+                next = lock->lh_chain;
+                bucket = (lock->lh_name / lmgr_nmutexes) % newsize;
+                if (newhash[bucket] == NULL) {
+                    nchains++;
+                }
+                lock->lh_chain = newhash[bucket];
+                newhash[bucket] = lock;
+            }
+        }
+        SsMemFree(ls->ls_hash);
+        ls->ls_hash = newhash;
+        ls->ls_hashsize = newsize;
+
+        /* Statistics only, not protected by stripe mutexes. */
+        lm->lm_nchains += nchains;
+        lm->lm_nresize++;
+
+        return(TRUE);
+}
+
+#endif /* LMGR_SPLITMUTEX */
+
 /*#***********************************************************************\
  * 
  *		lock_request_alloc
@@ -497,31 +738,58 @@ static lock_request_t* lock_request_alloc(
         dbe_lockname_t      name)
 {
         lock_request_t* req;
+#ifdef LMGR_SPLITMUTEX
+        int             m;
+#endif
         ss_debug(static long locktime;)
 
         SS_PMON_ADD(SS_PMON_DBE_LOCK_COUNT);
 
 #ifdef LMGR_SPLITMUTEX
-        if (lm->lm_freerequest[LMGR_MUTEX(lm, name)] != NULL) {
-            ss_dassert(lm->lm_nfreerequests[LMGR_MUTEX(lm, name)] > 0);
-            req = lm->lm_freerequest[LMGR_MUTEX(lm, name)];
-            lm->lm_freerequest[LMGR_MUTEX(lm, name)] = req->lr_queue;
-            lm->lm_nfreerequests[LMGR_MUTEX(lm, name)]--;
+        /* The transaction pool of this stripe is protected by the stripe
+         * mutex, like me->lt_locks[m].
+         */
+        m = LMGR_MUTEX(lm, name);
+        if (me->lt_freereq[m] != NULL) {
+            ss_dassert(me->lt_nfreereq[m] > 0);
+            req = me->lt_freereq[m];
+            me->lt_freereq[m] = req->lr_queue;
+            me->lt_nfreereq[m]--;
             ss_dassert(req->lr_chk == DBE_CHK_FREELOCKREQ);
         } else {
-            ss_dassert(lm->lm_nfreerequests[LMGR_MUTEX(lm, name)] == 0);
-            req = SSMEM_NEW(lock_request_t);
+            lmgr_stripe_t* ls;
+
+            ls = &lm->lm_stripe[m];
+            if (ls->ls_freerequest != NULL) {
+                ss_dassert(ls->ls_nfreerequests > 0);
+                req = ls->ls_freerequest;
+                ls->ls_freerequest = req->lr_queue;
+                ls->ls_nfreerequests--;
+                ss_dassert(req->lr_chk == DBE_CHK_FREELOCKREQ);
+            } else {
+                ss_dassert(ls->ls_nfreerequests == 0);
+                req = SSMEM_NEW(lock_request_t);
+            }
         }
 #else
-        if (lm->lm_freerequest != NULL) {
-            ss_dassert(lm->lm_nfreerequests > 0);
-            req = lm->lm_freerequest;
-            lm->lm_freerequest = req->lr_queue;
-            lm->lm_nfreerequests--;
+        if (me->lt_freereq != NULL) {
+            /* Transaction private pool, no shared state touched. */
+            ss_dassert(me->lt_nfreereq > 0);
+            req = me->lt_freereq;
+            me->lt_freereq = req->lr_queue;
+            me->lt_nfreereq--;
             ss_dassert(req->lr_chk == DBE_CHK_FREELOCKREQ);
         } else {
-            ss_dassert(lm->lm_nfreerequests == 0);
-            req = SSMEM_NEW(lock_request_t);
+            if (lm->lm_freerequest != NULL) {
+                ss_dassert(lm->lm_nfreerequests > 0);
+                req = lm->lm_freerequest;
+                lm->lm_freerequest = req->lr_queue;
+                lm->lm_nfreerequests--;
+                ss_dassert(req->lr_chk == DBE_CHK_FREELOCKREQ);
+            } else {
+                ss_dassert(lm->lm_nfreerequests == 0);
+                req = SSMEM_NEW(lock_request_t);
+            }
         }
 #endif
 
@@ -538,11 +806,11 @@ static lock_request_t* lock_request_alloc(
         req->lr_tran = me;
         req->lr_tran_prev = NULL;
 #ifdef LMGR_SPLITMUTEX
-        req->lr_tran_next = me->lt_locks[LMGR_MUTEX(lm, name)];
-        if (me->lt_locks[LMGR_MUTEX(lm, name)] != NULL) {
-            me->lt_locks[LMGR_MUTEX(lm, name)]->lr_tran_prev = req;
+        req->lr_tran_next = me->lt_locks[m];
+        if (me->lt_locks[m] != NULL) {
+            me->lt_locks[m]->lr_tran_prev = req;
         }
-        me->lt_locks[LMGR_MUTEX(lm, name)] = req;
+        me->lt_locks[m] = req;
 #else
         req->lr_tran_next = me->lt_locks;
         if (me->lt_locks != NULL) {
@@ -603,20 +871,48 @@ static void lock_request_free(
         if (req == me->lt_locks[LMGR_MUTEX(lm, req->lr_name)]) {
             me->lt_locks[LMGR_MUTEX(lm, req->lr_name)] = req->lr_tran_next;
         }
-
-        if (lm->lm_nfreerequests[LMGR_MUTEX(lm, req->lr_name)]
-            < lm->lm_maxfreerequests) {
-            req->lr_queue = lm->lm_freerequest[LMGR_MUTEX(lm, req->lr_name)];
-            lm->lm_freerequest[LMGR_MUTEX(lm, req->lr_name)] = req;
-            ss_debug(req->lr_chk = DBE_CHK_FREELOCKREQ);
-            lm->lm_nfreerequests[LMGR_MUTEX(lm, req->lr_name)]++;
-        } else {
-            SsMemFree(req);
-        }
 #else        
         if (req == me->lt_locks) {
             me->lt_locks = req->lr_tran_next;
         }
+#endif
+
+#ifdef LMGR_SPLITMUTEX
+        {
+            lmgr_stripe_t* ls;
+            int m;
+
+            m = LMGR_MUTEX(lm, req->lr_name);
+            if (me->lt_nfreereq[m] < LMGR_TRAN_NFREEREQUESTS) {
+                /* Keep in the transaction for its next lock in this
+                 * stripe.
+                 */
+                req->lr_queue = me->lt_freereq[m];
+                me->lt_freereq[m] = req;
+                ss_debug(req->lr_chk = DBE_CHK_FREELOCKREQ);
+                me->lt_nfreereq[m]++;
+                return;
+            }
+
+            ls = &lm->lm_stripe[m];
+            if (ls->ls_nfreerequests < lm->lm_maxfreerequests) {
+                req->lr_queue = ls->ls_freerequest;
+                ls->ls_freerequest = req;
+                ss_debug(req->lr_chk = DBE_CHK_FREELOCKREQ);
+                ls->ls_nfreerequests++;
+            } else {
+                SsMemFree(req);
+            }
+        }
+#else        
+        if (me->lt_nfreereq < LMGR_TRAN_NFREEREQUESTS) {
+            /* Keep in the transaction for its next lock. */
+            req->lr_queue = me->lt_freereq;
+            me->lt_freereq = req;
+            ss_debug(req->lr_chk = DBE_CHK_FREELOCKREQ);
+            me->lt_nfreereq++;
+            return;
+        }
         if (lm->lm_nfreerequests < lm->lm_maxfreerequests) {
             req->lr_queue = lm->lm_freerequest;
             lm->lm_freerequest = req;
@@ -662,16 +958,20 @@ static lock_head_t* lock_head_alloc(
         lock_head_t* lock;
 
 #ifdef LMGR_SPLITMUTEX
-        if (lm->lm_freelock[LMGR_MUTEX(lm, name)] != NULL) {
-            ss_dassert(lm->lm_nfreelocks[LMGR_MUTEX(lm, name)] > 0);
-            lock = lm->lm_freelock[LMGR_MUTEX(lm, name)];
-            lm->lm_freelock[LMGR_MUTEX(lm, name)] = lock->lh_chain;
-            lm->lm_nfreelocks[LMGR_MUTEX(lm, name)]--;
+        lmgr_stripe_t* ls;
+
+        ls = LMGR_STRIPE(lm, name);
+        if (ls->ls_freelock != NULL) {
+            ss_dassert(ls->ls_nfreelocks > 0);
+            lock = ls->ls_freelock;
+            ls->ls_freelock = lock->lh_chain;
+            ls->ls_nfreelocks--;
             ss_dassert(lock->lh_chk == DBE_CHK_FREELOCKHEAD);
         } else {
-            ss_dassert(lm->lm_nfreelocks[LMGR_MUTEX(lm, name)] == 0);
+            ss_dassert(ls->ls_nfreelocks == 0);
             lock = SSMEM_NEW(lock_head_t);
         }
+        ls->ls_nlocks++;
 #else
         if (lm->lm_freelock != NULL) {
             ss_dassert(lm->lm_nfreelocks > 0);
@@ -685,163 +985,724 @@ static lock_head_t* lock_head_alloc(
         }
 #endif
 
-        ss_debug(lock->lh_chk = DBE_CHK_LOCKHEAD;)
-        lock->lh_chain = NULL;
-        lock->lh_relid = relid;
-        lock->lh_name = name;
-        lock->lh_queue = NULL;
-        lock->lh_granted_mode = mode;
-        lock->lh_waiting = FALSE;
+        ss_debug(lock->lh_chk = DBE_CHK_LOCKHEAD;)
+        lock->lh_chain = NULL;
+        lock->lh_relid = relid;
+        lock->lh_name = name;
+        lock->lh_queue = NULL;
+        lock->lh_granted_mode = mode;
+        lock->lh_waiting = FALSE;
+
+        return(lock);
+}
+
+/*#***********************************************************************\
+ * 
+ *		lock_head_free
+ * 
+ * 
+ * 
+ * Parameters : 
+ *
+ *      lm - in, use
+ *          The lockmanager.
+ *
+ *      lock - in, take
+ *          The lock to be freed.
+ *		
+ * Return value : 
+ * 
+ * Comments : 
+ * 
+ * Globals used : 
+ * 
+ * See also : 
+ */
+static void lock_head_free(
+        dbe_lockmgr_t*  lm,
+        lock_head_t*    lock)
+{
+        CHK_LOCKMGR(lm);
+        CHK_LOCKHEAD(lock);
+
+        if (lm->lm_cachedlock == lock) {
+            lm->lm_cachedrelid = 0;
+            lm->lm_cachedlock = NULL;
+        } else {
+            ss_dassert(lock->lh_relid != DBE_LOCKRELID_REL
+                       || lock->lh_name != lm->lm_cachedrelid);
+        }
+
+#ifdef LMGR_SPLITMUTEX
+        {
+            lmgr_stripe_t* ls;
+
+            ls = LMGR_STRIPE(lm, lock->lh_name);
+            ss_dassert(ls->ls_nlocks > 0);
+            ls->ls_nlocks--;
+            if (ls->ls_nfreelocks < lm->lm_maxfreelocks) {
+                lock->lh_chain = ls->ls_freelock;
+                ls->ls_freelock = lock;
+                ss_debug(lock->lh_chk = DBE_CHK_FREELOCKHEAD);
+                ls->ls_nfreelocks++;
+            } else {
+                SsMemFree(lock);
+            }
+        }
+#else
+        if (lm->lm_nfreelocks < lm->lm_maxfreelocks) {
+            lock->lh_chain = lm->lm_freelock;
+            lm->lm_freelock = lock;
+            ss_debug(lock->lh_chk = DBE_CHK_FREELOCKHEAD);
+            lm->lm_nfreelocks++;
+        } else {
+            SsMemFree(lock);
+        }
+#endif
+}
+
+#ifndef LMGR_BGDEADLOCK
+
+/*#***********************************************************************\
+ * 
+ *		lmgr_isdeadlock
+ * 
+ * Tests for cycles in lock wait lists.
+ * 
+ * Parameters : 
+ * 
+ *		me - 
+ *			
+ *			
+ *		req - 
+ *			
+ *			
+ *		level - 
+ *			
+ *			
+ * Return value : 
+ * 
+ * Comments : 
+ * 
+ * Globals used : 
+ * 
+ * See also : 
+ */
+static bool lmgr_isdeadlock(dbe_locktran_t* me, int level, int* p_maxlocks)
+{
+        dbe_locktran_t* tran;
+        lock_request_t* req;
+        bool deadlock;
+
+        ss_dprintf_3(("lmgr_isdeadlock:level=%d, *p_maxlocks=%d, me=%ld\n", level, *p_maxlocks, (long)me));
+        ss_dassert(dbe_cfg_fastdeadlockdetect);
+
+        level--;
+
+        if (me->lt_wait == NULL) {
+            ss_dprintf_4(("lmgr_isdeadlock:FALSE, me->lt_wait == NULL\n"));
+            return(FALSE);
+        }
+        if (level == 0) {
+            /* Too many nested levels, stop. */
+            ss_dprintf_4(("lmgr_isdeadlock:FALSE, level == 0\n"));
+            return(FALSE);
+        }
+        req = me->lt_wait->lr_head->lh_queue;
+        while (req != NULL) {
+            if (req->lr_tran == me && req->lr_status != LOCK_GRANTED) {
+                break;
+            }
+            ss_dprintf_3(("lmgr_isdeadlock:req->lr_status=%d, req->lr_mode=%s, me->lt_wait->lr_mode=%s, name=%ld\n",
+                req->lr_status,
+                lock_modename(req->lr_mode), 
+                lock_modename(me->lt_wait->lr_mode),
+                (long)req->lr_head->lh_name));
+            ss_assert(req->lr_head->lh_name == me->lt_wait->lr_head->lh_name);
+            if ((*p_maxlocks)-- <= 0) {
+                /* Too many locks checked, stop. */
+                ss_dprintf_4(("lmgr_isdeadlock:FALSE, (*p_maxlocks)-- <= 0\n"));
+                return(FALSE);
+            }
+            if (req->lr_tran != me
+                && (!lock_compat(req->lr_mode, me->lt_wait->lr_mode)
+                    || req->lr_status != LOCK_GRANTED))
+            {
+                tran = req->lr_tran;
+                me->lt_cycle = tran;
+                ss_dprintf_4(("lmgr_isdeadlock:check for deadlock:me->lt_cycle = tran, %ld = %ld\n", (long)&me->lt_cycle, (long)tran));
+                if (tran->lt_cycle != NULL) {
+                    ss_dprintf_4(("lmgr_isdeadlock:tran->lt_cycle=%ld\n", (long)tran->lt_cycle));
+                    deadlock = TRUE;
+                } else {
+                    deadlock = lmgr_isdeadlock(tran, level, p_maxlocks);
+                }
+                ss_dprintf_4(("lmgr_isdeadlock:check for deadlock:me->lt_cycle = NULL, %ld = 0\n", (long)&me->lt_cycle));
+                me->lt_cycle = NULL;
+                if (deadlock) {
+                    ss_dprintf_4(("lmgr_isdeadlock:TRUE, deadlock\n"));
+                    return(TRUE);
+                }
+            }
+            req = req->lr_queue;
+        }
+        ss_dprintf_4(("lmgr_isdeadlock:FALSE, end\n"));
+        return(FALSE);
+}
+
+#endif /* !LMGR_BGDEADLOCK */
+
+#ifdef LMGR_BGDEADLOCK
+
+/*#***********************************************************************\
+ * 
+ *		lmgr_waitlist_add
+ * 
+ * Adds a transaction to the lock manager wait list if it is not already
+ * there. The deadlock detector examines only transactions in the wait
+ * list.
+ * 
+ * Parameters : 
+ * 
+ *	lm - use
+ *		Lock manager.
+ *		
+ *	me - use
+ *		Transaction that got LOCK_WAIT.
+ *		
+ * Return value : 
+ * 
+ * Comments : 
+ * 
+ *      Must be called without holding any stripe mutex, the wait list
+ *      mutex is entered before stripe mutexes.
+ *
+ *      The waited lock is copied here for the deadlock detector.
+ *      lt_waitrelid and lt_waitname are written by the transaction
+ *      itself under the stripe mutex of the lock, so the detector cannot
+ *      read them without knowing the stripe first.
+ * 
+ * Globals used : 
+ * 
+ * See also : 
+ */
+static void lmgr_waitlist_add(dbe_lockmgr_t* lm, dbe_locktran_t* me)
+{
+        SsSemEnter(lm->lm_waitsem);
+        me->lt_dlwaitrelid = me->lt_waitrelid;
+        me->lt_dlwaitname = me->lt_waitname;
+        if (!me->lt_waitlisted) {
+            me->lt_lm = lm;
+            me->lt_waitlisted = TRUE;
+            me->lt_waitprev = NULL;
+            me->lt_waitnext = lm->lm_waitlist;
+            if (lm->lm_waitlist != NULL) {
+                lm->lm_waitlist->lt_waitprev = me;
+            }
+            lm->lm_waitlist = me;
+            lm->lm_nwaiting++;
+        }
+        SsSemExit(lm->lm_waitsem);
+}
+
+/*#***********************************************************************\
+ * 
+ *		lmgr_waitlist_remove
+ * 
+ * Removes a transaction from the lock manager wait list. Wait list
+ * mutex must be entered by the caller.
+ * 
+ * Parameters : 
+ * 
+ *	lm - use
+ *		Lock manager.
+ *		
+ *	me - use
+ *		Transaction in the wait list.
+ *		
+ * Return value : 
+ * 
+ * Comments : 
+ * 
+ * Globals used : 
+ * 
+ * See also : 
+ */
+static void lmgr_waitlist_remove(dbe_lockmgr_t* lm, dbe_locktran_t* me)
+{
+        ss_dassert(SsSemThreadIsEntered(lm->lm_waitsem));
+        ss_dassert(me->lt_waitlisted);
+
+        if (me->lt_waitprev != NULL) {
+            me->lt_waitprev->lt_waitnext = me->lt_waitnext;
+        } else {
+            lm->lm_waitlist = me->lt_waitnext;
+        }
+        if (me->lt_waitnext != NULL) {
+            me->lt_waitnext->lt_waitprev = me->lt_waitprev;
+        }
+        me->lt_waitprev = NULL;
+        me->lt_waitnext = NULL;
+        me->lt_waitlisted = FALSE;
+        lm->lm_nwaiting--;
+}
+
+/*#***********************************************************************\
+ * 
+ *		lmgr_dl_getwaitreq
+ * 
+ * Finds the request a transaction is waiting for in lock relid.name.
+ * Stripe mutex of name must be entered by the caller. Lock is searched
+ * through the hash table so the transaction's own wait pointer is not
+ * needed.
+ * 
+ * Parameters : 
+ * 
+ *	lm - in
+ *		Lock manager.
+ *		
+ *	tran - in
+ *		Transaction.
+ *		
+ *	relid - in
+ *		Relation id of the waited lock.
+ *		
+ *	name - in
+ *		Name of the waited lock.
+ *		
+ * Return value - ref : 
+ * 
+ *      Waiting or converting request of tran, or NULL if tran is not
+ *      waiting for relid.name.
+ * 
+ * Comments : 
+ * 
+ * Globals used : 
+ * 
+ * See also : 
+ */
+static lock_request_t* lmgr_dl_getwaitreq(
+        dbe_lockmgr_t* lm,
+        dbe_locktran_t* tran,
+        long relid,
+        dbe_lockname_t name)
+{
+        lock_head_t* lock;
+        lock_request_t* req;
+
+        for (lock = *lmgr_getbucket(lm, name); lock != NULL; lock = lock->lh_chain) {
+            CHK_LOCKHEAD(lock);
+            if (lock->lh_relid == relid && lock->lh_name == name) {
+                break;
+            }
+        }
+        if (lock == NULL) {
+            return(NULL);
+        }
+        for (req = lock->lh_queue; req != NULL; req = req->lr_queue) {
+            CHK_LOCKREQ(req);
+            if (req->lr_tran == tran
+                && (req->lr_status == LOCK_WAITING
+                    || req->lr_status == LOCK_CONVERTING))
+            {
+                return(req);
+            }
+        }
+        return(NULL);
+}
+
+/*#***********************************************************************\
+ * 
+ *		lmgr_dl_isblocker
+ * 
+ * Checks if request req that is ahead of waiting request w in the lock
+ * queue blocks w. Earlier waiters and incompatible granted requests
+ * block.
+ * 
+ * Parameters : 
+ * 
+ *	req - in
+ *		Request ahead of w in the queue.
+ *		
+ *	w - in
+ *		Waiting request.
+ *		
+ * Return value : 
+ * 
+ *      TRUE if req blocks w.
+ * 
+ * Comments : 
+ * 
+ * Globals used : 
+ * 
+ * See also : 
+ */
+static bool lmgr_dl_isblocker(lock_request_t* req, lock_request_t* w)
+{
+        return(req->lr_tran != w->lr_tran
+               && (!lock_compat(req->lr_mode, w->lr_mode)
+                   || req->lr_status != LOCK_GRANTED));
+}
+
+/*#***********************************************************************\
+ * 
+ *		lmgr_dl_resolve
+ * 
+ * Validates a cycle found from the wait-for graph and selects a victim.
+ * The graph is collected one stripe at a time, so the cycle may not
+ * exist any more. Mutexes of all stripes in the cycle are entered in
+ * stripe order and every wait-for edge is checked again. If all edges
+ * still exist the cycle is a real deadlock, and the youngest transaction
+ * in the cycle is woken up to return LOCK_DEADLOCK.
+ * 
+ * Parameters : 
+ * 
+ *	lm - use
+ *		Lock manager.
+ *		
+ *	waiters - in
+ *		Graph nodes.
+ *		
+ *	wrelid - in
+ *		Relation ids of the waited locks of each node.
+ *		
+ *	wname - in
+ *		Names of the waited locks of each node.
+ *		
+ *	cycle - in
+ *		Node indexes of the cycle, cycle[i] waits for cycle[i+1]
+ *		and the last node waits for cycle[0].
+ *		
+ *	ncycle - in
+ *		Number of nodes in the cycle.
+ *		
+ * Return value : 
+ * 
+ *      TRUE if a deadlock was resolved.
+ * 
+ * Comments : 
+ * 
+ * Globals used : 
+ * 
+ * See also : 
+ */
+static bool lmgr_dl_resolve(
+        dbe_lockmgr_t* lm,
+        dbe_locktran_t** waiters,
+        long* wrelid,
+        dbe_lockname_t* wname,
+        int* cycle,
+        int ncycle)
+{
+        int stripes[LMGR_MAXCYCLE];
+        int nstripes = 0;
+        int i;
+        int j;
+        bool validp = TRUE;
+        dbe_locktran_t* victim = NULL;
+
+        ss_dassert(ncycle <= LMGR_MAXCYCLE);
+
+        /* Sorted list of distinct stripes, mutexes are entered in
+         * stripe order.
+         */
+        for (i = 0; i < ncycle; i++) {
+            int m = LMGR_MUTEX(lm, wname[cycle[i]]);
+            int k;
+            j = 0;
+            while (j < nstripes && stripes[j] < m) {
+                j++;
+            }
+            if (j < nstripes && stripes[j] == m) {
+                continue;
+            }
+            for (k = nstripes; k > j; k--) {
+                stripes[k] = stripes[k - 1];
+            }
+            stripes[j] = m;
+            nstripes++;
+        }
+        for (i = 0; i < nstripes; i++) {
+            SsSemEnter(lm->lm_stripe[stripes[i]].ls_mutex);
+        }
+
+        for (i = 0; validp && i < ncycle; i++) {
+            dbe_locktran_t* tran;
+            dbe_locktran_t* next;
+            lock_request_t* w;
+            lock_request_t* req;
+
+            tran = waiters[cycle[i]];
+            next = waiters[cycle[(i + 1) % ncycle]];
+            if (tran->lt_deadlockvictim) {
+                /* Cycle is already broken by an earlier victim. */
+                validp = FALSE;
+                break;
+            }
+            w = lmgr_dl_getwaitreq(lm, tran, wrelid[cycle[i]], wname[cycle[i]]);
+            validp = FALSE;
+            if (w != NULL) {
+                for (req = w->lr_head->lh_queue; req != w; req = req->lr_queue) {
+                    if (req->lr_tran == next && lmgr_dl_isblocker(req, w)) {
+                        validp = TRUE;
+                        break;
+                    }
+                }
+            }
+            if (victim == NULL || tran->lt_startseq > victim->lt_startseq) {
+                victim = tran;
+            }
+        }
+
+        if (validp) {
+            ss_dprintf_2(("lmgr_dl_resolve:deadlock of %d transactions, victim %ld\n",
+                ncycle, (long)victim));
+            CHK_LOCKTRAN(victim);
+            victim->lt_deadlockvictim = TRUE;
+            ss_assert(victim->lt_cd != NULL);
+            rs_sysi_lockwakeup(victim->lt_cd);
+            lm->lm_ndeadlock++;
+        }
 
-        return(lock);
+        for (i = nstripes - 1; i >= 0; i--) {
+            SsSemExit(lm->lm_stripe[stripes[i]].ls_mutex);
+        }
+        return(validp);
 }
 
 /*#***********************************************************************\
  * 
- *		lock_head_free
- * 
+ *		lmgr_deadlock_check
  * 
+ * One pass of the deadlock detector. Builds a wait-for graph of the
+ * transactions in the wait list and searches it for cycles using an
+ * iterative depth first search. Edges are collected holding only one
+ * stripe mutex at a time so lock requests in other stripes can proceed.
+ * Transactions that are not waiting any more are removed from the wait
+ * list.
  * 
  * Parameters : 
- *
- *      lm - in, use
- *          The lockmanager.
- *
- *      lock - in, take
- *          The lock to be freed.
+ * 
+ *	lm - use
+ *		Lock manager.
  *		
  * Return value : 
  * 
  * Comments : 
  * 
+ *      Search depth is limited by DeadlockDetectMaxDepth and the number
+ *      of examined lock requests by DeadlockDetectMaxLocks. Longer
+ *      cycles are resolved by lock timeout.
+ * 
  * Globals used : 
  * 
+ *      dbe_cfg_deadlockdetectmaxdepth
+ *      dbe_cfg_deadlockdetectmaxlocks
+ * 
  * See also : 
  */
-static void lock_head_free(
-        dbe_lockmgr_t*  lm,
-        lock_head_t*    lock)
+static void lmgr_deadlock_check(dbe_lockmgr_t* lm)
 {
-        CHK_LOCKMGR(lm);
-        CHK_LOCKHEAD(lock);
+        SsTimeT starttime;
+        SsTimeT elapsed;
+        dbe_locktran_t* tran;
+        dbe_locktran_t** waiters;
+        long* wrelid;
+        dbe_lockname_t* wname;
+        bool* waitingp;
+        char* color;
+        int* first;
+        int* edge;
+        int nedges = 0;
+        int maxedges;
+        int nlocks;
+        int maxdepth;
+        int stack[LMGR_MAXCYCLE];
+        int pos[LMGR_MAXCYCLE];
+        int n;
+        int i;
 
-        if (lm->lm_cachedlock == lock) {
-            lm->lm_cachedrelid = 0;
-            lm->lm_cachedlock = NULL;
-        } else {
-            ss_dassert(lock->lh_relid != DBE_LOCKRELID_REL
-                       || lock->lh_name != lm->lm_cachedrelid);
+        starttime = SsTimeMs();
+
+        SsSemEnter(lm->lm_waitsem);
+
+        n = lm->lm_nwaiting;
+        if (n == 0) {
+            SsSemExit(lm->lm_waitsem);
+            return;
+        }
+        ss_dprintf_1(("lmgr_deadlock_check:%d waiting transactions\n", n));
+
+        lm->lm_dlpass++;
+        lm->lm_ndeadlockcheck++;
+        maxedges = 4 * n;
+        waiters = SsMemAlloc(n * sizeof(waiters[0]));
+        wrelid = SsMemAlloc(n * sizeof(wrelid[0]));
+        wname = SsMemAlloc(n * sizeof(wname[0]));
+        waitingp = SsMemAlloc(n * sizeof(waitingp[0]));
+        color = SsMemCalloc(n, sizeof(color[0]));
+        first = SsMemAlloc((n + 1) * sizeof(first[0]));
+        edge = SsMemAlloc(maxedges * sizeof(edge[0]));
+
+        for (i = 0, tran = lm->lm_waitlist; tran != NULL; i++, tran = tran->lt_waitnext) {
+            CHK_LOCKTRAN(tran);
+            ss_dassert(i < n);
+            waiters[i] = tran;
+            tran->lt_dlpass = lm->lm_dlpass;
+            tran->lt_dlindex = i;
         }
+        ss_dassert(i == n);
 
-#ifdef LMGR_SPLITMUTEX
-        if (lm->lm_nfreelocks[LMGR_MUTEX(lm, lock->lh_name)]
-            < lm->lm_maxfreelocks) {
-            lock->lh_chain = lm->lm_freelock[LMGR_MUTEX(lm, lock->lh_name)];
-            lm->lm_freelock[LMGR_MUTEX(lm, lock->lh_name)] = lock;
-            ss_debug(lock->lh_chk = DBE_CHK_FREELOCKHEAD);
-            lm->lm_nfreelocks[LMGR_MUTEX(lm, lock->lh_name)]++;
-        } else {
-            SsMemFree(lock);
+        /* Collect wait-for edges. Blocking transactions are reached
+         * through lock requests under the stripe mutex, so they are alive
+         * even if they are not in the wait list.
+         */
+        nlocks = dbe_cfg_deadlockdetectmaxlocks;
+        for (i = 0; i < n; i++) {
+            lmgr_stripe_t* ls;
+            lock_request_t* w;
+            lock_request_t* req;
+
+            tran = waiters[i];
+            wrelid[i] = tran->lt_dlwaitrelid;
+            wname[i] = tran->lt_dlwaitname;
+            first[i] = nedges;
+            ls = LMGR_STRIPE(lm, wname[i]);
+            SsSemEnter(ls->ls_mutex);
+            w = lmgr_dl_getwaitreq(lm, tran, wrelid[i], wname[i]);
+            waitingp[i] = (w != NULL);
+            for (req = (w != NULL ? w->lr_head->lh_queue : NULL);
+                 req != w && nlocks > 0;
+                 req = req->lr_queue, nlocks--)
+            {
+                if (lmgr_dl_isblocker(req, w)
+                    && req->lr_tran->lt_dlpass == lm->lm_dlpass)
+                {
+                    if (nedges == maxedges) {
+                        maxedges *= 2;
+                        edge = SsMemRealloc(edge, maxedges * sizeof(edge[0]));
+                    }
+                    edge[nedges++] = req->lr_tran->lt_dlindex;
+                }
+            }
+            SsSemExit(ls->ls_mutex);
         }
-#else
-        if (lm->lm_nfreelocks < lm->lm_maxfreelocks) {
-            lock->lh_chain = lm->lm_freelock;
-            lm->lm_freelock = lock;
-            ss_debug(lock->lh_chk = DBE_CHK_FREELOCKHEAD);
-            lm->lm_nfreelocks++;
-        } else {
-            SsMemFree(lock);
+        first[n] = nedges;
+
+        /* Search cycles. Node color is 0 for unvisited, 1 for a node in
+         * the search stack and 2 for a finished node.
+         */
+        maxdepth = SS_MIN(dbe_cfg_deadlockdetectmaxdepth, LMGR_MAXCYCLE);
+        for (i = 0; i < n; i++) {
+            int depth;
+
+            if (color[i] != 0 || first[i] == first[i + 1]) {
+                continue;
+            }
+            depth = 0;
+            stack[0] = i;
+            pos[0] = first[i];
+            color[i] = 1;
+            while (depth >= 0) {
+                int v = stack[depth];
+                if (pos[depth] < first[v + 1]) {
+                    int u = edge[pos[depth]++];
+                    if (color[u] == 1) {
+                        /* Back edge, stack from u to v is a cycle. */
+                        int j = depth;
+                        while (stack[j] != u) {
+                            j--;
+                        }
+                        lmgr_dl_resolve(lm, waiters, wrelid, wname, &stack[j], depth - j + 1);
+                    } else if (color[u] == 0 && depth + 1 < maxdepth) {
+                        depth++;
+                        stack[depth] = u;
+                        pos[depth] = first[u];
+                        color[u] = 1;
+                    }
+                } else {
+                    color[v] = 2;
+                    depth--;
+                }
+            }
         }
-#endif
+
+        for (i = 0; i < n; i++) {
+            if (!waitingp[i]) {
+                lmgr_waitlist_remove(lm, waiters[i]);
+            }
+        }
+
+        SsSemExit(lm->lm_waitsem);
+
+        SsMemFree(waiters);
+        SsMemFree(wrelid);
+        SsMemFree(wname);
+        SsMemFree(waitingp);
+        SsMemFree(color);
+        SsMemFree(first);
+        SsMemFree(edge);
+
+        elapsed = SsTimeMs() - starttime;
+        lm->lm_deadlocktime += elapsed;
+        SS_PMON_ADD(SS_PMON_DBE_LOCK_DEADLOCKCHECK);
+        SS_PMON_ADD_N(SS_PMON_DBE_LOCK_DEADLOCKCHECKTIME, elapsed);
+        ss_dprintf_1(("lmgr_deadlock_check:%d edges, %lu ms\n", nedges, (ulong)elapsed));
 }
 
 /*#***********************************************************************\
  * 
- *		lmgr_isdeadlock
+ *		lmgr_deadlockthread
  * 
- * Tests for cycles in lock wait lists.
+ * Deadlock detector thread. Runs a detection pass every
+ * DeadlockDetectInterval milliseconds when there are waiting
+ * transactions. Lock waits shorter than the interval never pay for
+ * deadlock detection.
  * 
  * Parameters : 
  * 
- *		me - 
- *			
- *			
- *		req - 
- *			
- *			
- *		level - 
- *			
- *			
+ *	param - use
+ *		Lock manager.
+ *		
  * Return value : 
  * 
  * Comments : 
  * 
  * Globals used : 
  * 
+ *      dbe_cfg_deadlockdetectinterval
+ * 
  * See also : 
  */
-static bool lmgr_isdeadlock(dbe_locktran_t* me, int level, int* p_maxlocks)
+static void SS_CALLBACK lmgr_deadlockthread(void* param)
 {
-        dbe_locktran_t* tran;
-        lock_request_t* req;
-        bool deadlock;
+        dbe_lockmgr_t* lm = param;
 
-        ss_dprintf_3(("lmgr_isdeadlock:level=%d, *p_maxlocks=%d, me=%ld\n", level, *p_maxlocks, (long)me));
-        ss_dassert(dbe_cfg_fastdeadlockdetect);
-
-        level--;
+        ss_pprintf_1(("lmgr_deadlockthread\n"));
 
-        if (me->lt_wait == NULL) {
-            ss_dprintf_4(("lmgr_isdeadlock:FALSE, me->lt_wait == NULL\n"));
-            return(FALSE);
-        }
-        if (level == 0) {
-            /* Too many nested levels, stop. */
-            ss_dprintf_4(("lmgr_isdeadlock:FALSE, level == 0\n"));
-            return(FALSE);
-        }
-        req = me->lt_wait->lr_head->lh_queue;
-        while (req != NULL) {
-            if (req->lr_tran == me && req->lr_status != LOCK_GRANTED) {
+        while (!lm->lm_dlstop) {
+            SsMesRequest(lm->lm_dlmes, dbe_cfg_deadlockdetectinterval);
+            if (lm->lm_dlstop) {
                 break;
             }
-            ss_dprintf_3(("lmgr_isdeadlock:req->lr_status=%d, req->lr_mode=%s, me->lt_wait->lr_mode=%s, name=%ld\n",
-                req->lr_status,
-                lock_modename(req->lr_mode), 
-                lock_modename(me->lt_wait->lr_mode),
-                (long)req->lr_head->lh_name));
-            ss_assert(req->lr_head->lh_name == me->lt_wait->lr_head->lh_name);
-            if ((*p_maxlocks)-- <= 0) {
-                /* Too many locks checked, stop. */
-                ss_dprintf_4(("lmgr_isdeadlock:FALSE, (*p_maxlocks)-- <= 0\n"));
-                return(FALSE);
-            }
-            if (req->lr_tran != me
-                && (!lock_compat(req->lr_mode, me->lt_wait->lr_mode)
-                    || req->lr_status != LOCK_GRANTED))
-            {
-                tran = req->lr_tran;
-                me->lt_cycle = tran;
-                ss_dprintf_4(("lmgr_isdeadlock:check for deadlock:me->lt_cycle = tran, %ld = %ld\n", (long)&me->lt_cycle, (long)tran));
-                if (tran->lt_cycle != NULL) {
-                    ss_dprintf_4(("lmgr_isdeadlock:tran->lt_cycle=%ld\n", (long)tran->lt_cycle));
-                    deadlock = TRUE;
-                } else {
-                    deadlock = lmgr_isdeadlock(tran, level, p_maxlocks);
-                }
-                ss_dprintf_4(("lmgr_isdeadlock:check for deadlock:me->lt_cycle = NULL, %ld = 0\n", (long)&me->lt_cycle));
-                me->lt_cycle = NULL;
-                if (deadlock) {
-                    ss_dprintf_4(("lmgr_isdeadlock:TRUE, deadlock\n"));
-                    return(TRUE);
-                }
+            if (lm->lm_nwaiting > 0) {
+                lmgr_deadlock_check(lm);
             }
-            req = req->lr_queue;
         }
-        ss_dprintf_4(("lmgr_isdeadlock:FALSE, end\n"));
-        return(FALSE);
+
+        ss_pprintf_2(("lmgr_deadlockthread:stop\n"));
+
+        lm->lm_dlthreadp = FALSE;
+
+#if (defined(SS_MYSQL) || defined(SS_MYSQL_AC)) && defined(MYSQL_DYNAMIC_PLUGIN)
+        return;
+#else
+        SsThrExit();
+#endif
 }
 
+#endif /* LMGR_BGDEADLOCK */
+
 /*#***********************************************************************\
  * 
  *		lmgr_lock
@@ -897,7 +1758,7 @@ static dbe_lock_reply_t lmgr_lock(
         lock_request_t**    p_req,
         bool*               p_newlock)
 {
-        uint                bucket;
+        lock_head_t**       p_bucket = NULL;
         lock_head_t*        lock;
         lock_request_t*     req;
         lock_request_t*     last = NULL;
@@ -922,6 +1783,10 @@ static dbe_lock_reply_t lmgr_lock(
             rs_sysi_setdisablerowspermessage(me->lt_cd, TRUE);
         }
 
+        if (me->lt_startseq == 0) {
+            me->lt_startseq = LMGR_NEXTSTARTSEQ(lm);
+        }
+
         if (me->lt_wait != NULL) {
             /* Waiting for a lock.
              */
@@ -933,6 +1798,9 @@ static dbe_lock_reply_t lmgr_lock(
                 /* Lock granted.
                  */
                 me->lt_wait = NULL;
+#ifdef LMGR_BGDEADLOCK
+                me->lt_deadlockvictim = FALSE;
+#endif
                 ss_dprintf_4(("Lock granted, return LOCK_OK\n"));
                 lm->lm_lockokcnt++;
                 req->lr_okcount++;
@@ -949,6 +1817,20 @@ static dbe_lock_reply_t lmgr_lock(
                 SsTimeT now;
                 SsTimeT timeout_now;
 
+#ifdef LMGR_BGDEADLOCK
+                if (me->lt_deadlockvictim) {
+                    /* Deadlock detector selected this transaction as
+                     * a victim.
+                     */
+                    ss_dprintf_4(("Deadlock victim\n"));
+                    me->lt_deadlockvictim = FALSE;
+                    if (error_num == LOCK_CONVERTING) {
+                        req->lr_status = LOCK_DENIED;
+                    }
+                    error_num = LOCK_DEADLOCK;
+                    goto request_denied;
+                }
+#endif
 #ifdef DBE_LOCK_MSEC
                 now = SsTimeMs();
 #else
@@ -987,7 +1869,11 @@ static dbe_lock_reply_t lmgr_lock(
                 }
                 error_num = LOCK_TIMEOUT;
             }
-            /* Request denied (timed out), make sure unlock will work.
+#ifdef LMGR_BGDEADLOCK
+ request_denied:
+#endif
+            /* Request denied (timed out or deadlock), make sure unlock
+             * will work.
              */
             ss_poutput_1(lmgr_print(lm));
             lm->lm_locktimeoutcnt++;
@@ -996,7 +1882,11 @@ static dbe_lock_reply_t lmgr_lock(
             req->lr_class = LOCK_INSTANT;
             lmgr_unlock(lm, me, req->lr_head->lh_relid, req->lr_head->lh_name);
             SS_POPNAME;
-            SS_PMON_ADD(SS_PMON_DBE_LOCK_TIMEOUT);
+            if (error_num == LOCK_DEADLOCK) {
+                SS_PMON_ADD(SS_PMON_DBE_LOCK_DEADLOCK);
+            } else {
+                SS_PMON_ADD(SS_PMON_DBE_LOCK_TIMEOUT);
+            }
             return(error_num);
         }
 
@@ -1011,8 +1901,8 @@ static dbe_lock_reply_t lmgr_lock(
             lock = lm->lm_cachedlock;
             CHK_LOCKHEAD(lock);
         } else {
-            bucket = name % lm->lm_hashsize;
-            lock = lm->lm_hash[bucket];
+            p_bucket = lmgr_getbucket(lm, name);
+            lock = *p_bucket;
             path = 1;
             
             while (lock != NULL) {
@@ -1040,10 +1930,15 @@ static dbe_lock_reply_t lmgr_lock(
             ss_dprintf_4(("Name not found, lock is free, return LOCK_OK\n"));
             lock = lock_head_alloc(lm, relid, name, mode);
             lock->lh_queue = lock_request_alloc(lm, me, lock, mode, class, name);
-            lm->lm_lockcnt++;
+            LMGR_LOCKCNT_ADD(lm, 1);
             lock->lh_queue->lr_okcount++;
-            lock->lh_chain = lm->lm_hash[bucket];
-            lm->lm_hash[bucket] = lock;
+#ifdef LMGR_SPLITMUTEX
+            if (lmgr_stripe_growif(lm, LMGR_STRIPE(lm, name))) {
+                p_bucket = lmgr_getbucket(lm, name);
+            }
+#endif
+            lock->lh_chain = *p_bucket;
+            *p_bucket = lock;
             lm->lm_lockokcnt++;
             if (p_req != NULL) {
                 *p_req = lock->lh_queue;
@@ -1088,7 +1983,7 @@ static dbe_lock_reply_t lmgr_lock(
             ss_dprintf_4(("A new request for this transaction\n"));
             if (!bouncep) {
                 req = lock_request_alloc(lm, me, lock, mode, class, name);
-                lm->lm_lockcnt++;
+                LMGR_LOCKCNT_ADD(lm, 1);
                 last->lr_queue = req;
             }
             if (p_newlock != NULL) {
@@ -1122,7 +2017,9 @@ static dbe_lock_reply_t lmgr_lock(
                 /* New request: must wait case. Mark the fact in the header
                  * status and request status.
                  */
+#ifndef LMGR_BGDEADLOCK
                 int deadlockdetectmaxlocks = dbe_cfg_deadlockdetectmaxlocks;
+#endif
                 if (bouncep) {
                     ss_dprintf_4(("Bounce lock, not compatible, return LOCK_TIMEOUT\n"));
                     SS_POPNAME;
@@ -1136,6 +2033,11 @@ static dbe_lock_reply_t lmgr_lock(
                 req->lr_status = LOCK_WAITING;
                 me->lt_wait = req;
                 ss_poutput_1(lmgr_print(lm));
+#ifdef LMGR_BGDEADLOCK
+                me->lt_waitrelid = (long)relid;
+                me->lt_waitname = name;
+                me->lt_deadlockvictim = FALSE;
+#else
                 if (dbe_cfg_fastdeadlockdetect
                     && timeout != 0
                     && lmgr_isdeadlock(me, dbe_cfg_deadlockdetectmaxdepth, &deadlockdetectmaxlocks))
@@ -1143,6 +2045,7 @@ static dbe_lock_reply_t lmgr_lock(
                     ss_dprintf_4(("Deadlock, set timeout to zero.\n"));
                     timeout = 0;
                 }
+#endif
                 if (timeout != 0 && rs_sysi_task(me->lt_cd) != NULL) {
                     /* Wait for the lock. */
                     lock->lh_waiting = TRUE;
@@ -1250,7 +2153,9 @@ static dbe_lock_reply_t lmgr_lock(
                 /* Not compatible with others in the granted group,
                  * must wait.
                  */
+#ifndef LMGR_BGDEADLOCK
                 int deadlockdetectmaxlocks = dbe_cfg_deadlockdetectmaxlocks;
+#endif
                 ss_dprintf_4(("Not compatible with others in granted group, must wait\n"));
 
                 for (tmpreq = lock->lh_queue; tmpreq != NULL; tmpreq = tmpreq->lr_queue) {
@@ -1259,7 +2164,7 @@ static dbe_lock_reply_t lmgr_lock(
                 }
 
                 req = lock_request_alloc(lm, me, lock, mode, class, name);
-                lm->lm_lockcnt++;
+                LMGR_LOCKCNT_ADD(lm, 1);
                 last->lr_queue = req;
 
                 if (p_newlock != NULL) {
@@ -1273,6 +2178,11 @@ static dbe_lock_reply_t lmgr_lock(
                 req->lr_convert_mode = mode;
                 me->lt_wait = req;
                 ss_poutput_1(lmgr_print(lm));
+#ifdef LMGR_BGDEADLOCK
+                me->lt_waitrelid = (long)relid;
+                me->lt_waitname = name;
+                me->lt_deadlockvictim = FALSE;
+#else
                 if (dbe_cfg_fastdeadlockdetect 
                     && timeout != 0
                     && lmgr_isdeadlock(me, dbe_cfg_deadlockdetectmaxdepth, &deadlockdetectmaxlocks)) 
@@ -1280,6 +2190,7 @@ static dbe_lock_reply_t lmgr_lock(
                     ss_dprintf_4(("Deadlock, set timeout to zero.\n"));
                     timeout = 0;
                 }
+#endif
                 if (timeout != 0 && rs_sysi_task(me->lt_cd) != NULL) {
                     /* Wait for the lock. */
                     lock->lh_waiting = TRUE;
@@ -1349,7 +2260,7 @@ static void lmgr_unlock(
         ulong relid,
         dbe_lockname_t name)
 {
-        uint bucket;
+        lock_head_t** p_bucket;
         lock_head_t* lock;
         lock_head_t* prev = NULL;
         lock_request_t* req;
@@ -1366,8 +2277,8 @@ static void lmgr_unlock(
 
         /* Find the requestor's request
          */
-        bucket = name % lm->lm_hashsize;
-        lock = lm->lm_hash[bucket];
+        p_bucket = lmgr_getbucket(lm, name);
+        lock = *p_bucket;
         path = 1;
         while (lock != NULL) {
             CHK_LOCKHEAD(lock);
@@ -1423,8 +2334,8 @@ static void lmgr_unlock(
             /* Mine is only request. */
             ss_dprintf_4(("Mine is only request, unlock ok\n"));
             if (prev == NULL) {
-                lm->lm_hash[bucket] = lock->lh_chain;
-                if (lm->lm_hash[bucket] == NULL) {
+                *p_bucket = lock->lh_chain;
+                if (*p_bucket == NULL) {
                     lm->lm_nchains--;
                 }
             } else {
@@ -1432,7 +2343,7 @@ static void lmgr_unlock(
             }
             lock_head_free(lm, lock);
             lock_request_free(lm, req);
-            lm->lm_lockcnt--;
+            LMGR_LOCKCNT_ADD(lm, -1);
             return;
         }
 
@@ -1445,7 +2356,7 @@ static void lmgr_unlock(
             lock->lh_queue = req->lr_queue;
         }
         lock_request_free(lm, req);
-        lm->lm_lockcnt--;
+        LMGR_LOCKCNT_ADD(lm, -1);
 
         /* Reset lock header.
          */
@@ -1643,7 +2554,7 @@ void dbe_lockmgr_unlock(
         CHK_LOCKTRAN(me);
 
 #ifdef LMGR_SPLITMUTEX
-        SsSemEnter(lm->lm_mutex[LMGR_MUTEX(lm, name)]);
+        SsSemEnter(LMGR_STRIPE(lm, name)->ls_mutex);
 #else
         SsSemEnter(lm->lm_sem);
 #endif
@@ -1671,7 +2582,7 @@ void dbe_lockmgr_unlock(
         }
 
 #ifdef LMGR_SPLITMUTEX
-        SsSemExit(lm->lm_mutex[LMGR_MUTEX(lm, name)]);
+        SsSemExit(LMGR_STRIPE(lm, name)->ls_mutex);
 #else
         SsSemExit(lm->lm_sem);
 #endif
@@ -1720,7 +2631,7 @@ void dbe_lockmgr_unlock_shared(
         CHK_LOCKTRAN(me);
 
 #ifdef LMGR_SPLITMUTEX
-        SsSemEnter(lm->lm_mutex[LMGR_MUTEX(lm, name)]);
+        SsSemEnter(LMGR_STRIPE(lm, name)->ls_mutex);
 #else
         SsSemEnter(lm->lm_sem);
 #endif
@@ -1743,7 +2654,7 @@ void dbe_lockmgr_unlock_shared(
         }
 
 #ifdef LMGR_SPLITMUTEX
-        SsSemExit(lm->lm_mutex[LMGR_MUTEX(lm, name)]);
+        SsSemExit(LMGR_STRIPE(lm, name)->ls_mutex);
 #else
         SsSemExit(lm->lm_sem);
 #endif
@@ -1788,7 +2699,7 @@ void dbe_lockmgr_cancelwaiting(
 
         if (!lm->lm_sharedsem) {
 #ifdef LMGR_SPLITMUTEX
-            SsSemEnter(lm->lm_mutex[LMGR_MUTEX(lm, name)]);
+            SsSemEnter(LMGR_STRIPE(lm, name)->ls_mutex);
 #else
             SsSemEnter(lm->lm_sem);
 #endif
@@ -1807,9 +2718,12 @@ void dbe_lockmgr_cancelwaiting(
         }
 
         me->lt_wait = NULL;
+#ifdef LMGR_BGDEADLOCK
+        me->lt_deadlockvictim = FALSE;
+#endif
         if (!lm->lm_sharedsem) {
 #ifdef LMGR_SPLITMUTEX
-            SsSemExit(lm->lm_mutex[LMGR_MUTEX(lm, name)]);
+            SsSemExit(LMGR_STRIPE(lm, name)->ls_mutex);
 #else
             SsSemExit(lm->lm_sem);
 #endif
@@ -1864,7 +2778,7 @@ static void lmgr_unlock_class(
 #ifdef LMGR_SPLITMUTEX
         for (i = 0; i < lmgr_nmutexes; i++) {
             if (me->lt_locks[i] != NULL) {
-                SsSemEnter(lm->lm_mutex[i]);
+                SsSemEnter(lm->lm_stripe[i].ls_mutex);
                 mutexed = TRUE;
             } else {
                 mutexed = FALSE;
@@ -1892,7 +2806,7 @@ static void lmgr_unlock_class(
             }
 #ifdef LMGR_SPLITMUTEX
             if (mutexed) {
-                SsSemExit(lm->lm_mutex[i]);
+                SsSemExit(lm->lm_stripe[i].ls_mutex);
             }
         }
 #endif
@@ -2000,9 +2914,9 @@ dbe_lockmgr_t* dbe_lockmgr_init(
         ss_dprintf_1(("dbe_lockmgr_init\n"));
         ss_dassert(hashsize > 0);
 
-#ifdef LMGR_SPLITMUTEX
+#if defined(LMGR_SPLITMUTEX) && !defined(LMGR_BGDEADLOCK)
         if (dbe_cfg_fastdeadlockdetect) {
-            /* With fast deadlock detection we cannot use split mutex
+            /* With inline deadlock detection we cannot use split mutex
              * because we cannot fix the order in which deadlock detect
              * code would enter mutexes.
              */
@@ -2013,15 +2927,29 @@ dbe_lockmgr_t* dbe_lockmgr_init(
         lm = SSMEM_NEW(dbe_lockmgr_t);
 
         ss_debug(lm->lm_chk = DBE_CHK_LOCKMGR;)
-        lm->lm_hash = SsMemCalloc(hashsize, sizeof(lm->lm_hash[0]));
-        lm->lm_hashsize = hashsize;
 #ifdef LMGR_SPLITMUTEX
         ss_dassert(sem == NULL);
+        /* hashsize is the initial total size, stripes grow on demand. */
+        hashsize = hashsize / lmgr_nmutexes;
+        if (hashsize < 16) {
+            hashsize = 16;
+        }
         for (i = 0; i < lmgr_nmutexes; i++) {
-            lm->lm_mutex[i] = SsSemCreateLocal(SS_SEMNUM_DBE_LOCKMGR);
+            lmgr_stripe_t* ls = &lm->lm_stripe[i];
+            ls->ls_mutex = SsSemCreateLocal(SS_SEMNUM_DBE_LOCKMGR);
+            ls->ls_hash = SsMemCalloc(hashsize, sizeof(ls->ls_hash[0]));
+            ls->ls_hashsize = hashsize;
+            ls->ls_nlocks = 0;
+            ls->ls_freelock = NULL;
+            ls->ls_nfreelocks = 0;
+            ls->ls_freerequest = NULL;
+            ls->ls_nfreerequests = 0;
         }
+        lm->lm_nresize = 0;
         lm->lm_sharedsem = FALSE;
 #else
+        lm->lm_hash = SsMemCalloc(hashsize, sizeof(lm->lm_hash[0]));
+        lm->lm_hashsize = hashsize;
         if (sem == NULL) {
             lm->lm_sem = SsSemCreateLocal(SS_SEMNUM_DBE_LOCKMGR);
             lm->lm_sharedsem = FALSE;
@@ -2042,15 +2970,7 @@ dbe_lockmgr_t* dbe_lockmgr_init(
         lm->lm_cachedrelid = 0;
         lm->lm_cachedlock = NULL;
 #ifdef LMGR_SPLITMUTEX
-        for (i = 0; i < lmgr_nmutexes; i++) {
-            lm->lm_freelock[i] = NULL;
-            lm->lm_nfreelocks[i] = 0;
-        }
         lm->lm_maxfreelocks = N_FREE_LOCKS / lmgr_nmutexes;
-        for (i = 0; i < lmgr_nmutexes; i++) {
-            lm->lm_freerequest[i] = NULL;
-            lm->lm_nfreerequests[i] = 0;
-        }
         lm->lm_maxfreerequests = N_FREE_REQUESTS / lmgr_nmutexes;
 #else
         lm->lm_freelock = NULL;
@@ -2064,6 +2984,31 @@ dbe_lockmgr_t* dbe_lockmgr_init(
         lm->lm_nchains = 0;
         lm->lm_maxnchains = 0;
         lm->lm_maxpath = 0;
+        lm->lm_startseq = 0;
+#ifdef LMGR_BGDEADLOCK
+        lm->lm_deadlockdetect = dbe_cfg_fastdeadlockdetect;
+        lm->lm_waitsem = NULL;
+        lm->lm_waitlist = NULL;
+        lm->lm_nwaiting = 0;
+        lm->lm_dlmes = NULL;
+        lm->lm_dlthreadp = FALSE;
+        lm->lm_dlstop = FALSE;
+        lm->lm_dlpass = 0;
+        lm->lm_ndeadlockcheck = 0;
+        lm->lm_ndeadlock = 0;
+        lm->lm_deadlocktime = 0;
+        if (lm->lm_deadlockdetect) {
+            SsThreadT* thr;
+
+            ss_pprintf_2(("dbe_lockmgr_init:Start deadlock detector thread\n"));
+            lm->lm_waitsem = SsSemCreateLocal(SS_SEMNUM_DBE_LOCKMGR_WAIT);
+            lm->lm_dlmes = SsMesCreateLocal();
+            lm->lm_dlthreadp = TRUE;
+            thr = SsThrInitParam(lmgr_deadlockthread, "lmgr_deadlockthread", 24 * 1024, lm);
+            SsThrEnable(thr);
+            SsThrDone(thr);
+        }
+#endif
 
         return(lm);
 }
@@ -2094,6 +3039,55 @@ void dbe_lockmgr_done(dbe_lockmgr_t* lm)
         ss_dprintf_1(("dbe_lockmgr_done\n"));
         CHK_LOCKMGR(lm);
 
+#ifdef LMGR_BGDEADLOCK
+        if (lm->lm_deadlockdetect) {
+            lm->lm_dlstop = TRUE;
+            SsMesSend(lm->lm_dlmes);
+            while (lm->lm_dlthreadp) {
+                SsThrSleep(10);
+            }
+            ss_dassert(lm->lm_waitlist == NULL);
+            SsMesFree(lm->lm_dlmes);
+            SsSemFree(lm->lm_waitsem);
+        }
+#endif
+
+#ifdef LMGR_SPLITMUTEX
+        lm->lm_maxfreelocks = 0;
+        lm->lm_maxfreerequests = 0;
+        for (i = 0; i < lmgr_nmutexes; i++) {
+            lmgr_stripe_t* ls = &lm->lm_stripe[i];
+#ifdef SS_DEBUG
+            {
+                uint j;
+                for (j = 0; j < ls->ls_hashsize; j++) {
+                    if (ls->ls_hash[j] != NULL) {
+                        ss_testlog_print((char *)"%d@%s: non-freed lock in lock table.\n",
+                                         __LINE__, (char *)__FILE__);
+                    }
+                }
+            }
+#endif
+            while (ls->ls_freelock != NULL) {
+                lock_head_t* lock;
+                ss_dassert(ls->ls_freelock->lh_chk == DBE_CHK_FREELOCKHEAD);
+                ss_debug(ls->ls_freelock->lh_chk = DBE_CHK_LOCKHEAD);
+                lock = ls->ls_freelock->lh_chain;
+                SsMemFree(ls->ls_freelock);
+                ls->ls_freelock = lock;
+            }
+            while (ls->ls_freerequest != NULL) {
+                lock_request_t* req;
+                ss_dassert(ls->ls_freerequest->lr_chk == DBE_CHK_FREELOCKREQ);
+                ss_debug(ls->ls_freerequest->lr_chk = DBE_CHK_LOCKREQ);
+                req = ls->ls_freerequest->lr_queue;
+                SsMemFree(ls->ls_freerequest);
+                ls->ls_freerequest = req;
+            }
+            SsSemFree(ls->ls_mutex);
+            SsMemFree(ls->ls_hash);
+        }
+#else
 #ifdef SS_DEBUG
         for (i = 0; i < lm->lm_hashsize; i++) {
 #if 0
@@ -2107,27 +3101,6 @@ void dbe_lockmgr_done(dbe_lockmgr_t* lm)
         }
 #endif
         lm->lm_maxfreelocks = 0;
-#ifdef LMGR_SPLITMUTEX
-        for (i = 0; i < lmgr_nmutexes; i++) {
-            while (lm->lm_freelock[i] != NULL) {
-                lock_head_t* lock;
-                ss_dassert(lm->lm_freelock[i]->lh_chk == DBE_CHK_FREELOCKHEAD);
-                ss_debug(lm->lm_freelock[i]->lh_chk = DBE_CHK_LOCKHEAD);
-                lock = lm->lm_freelock[i]->lh_chain;
-                SsMemFree(lm->lm_freelock[i]);
-                lm->lm_freelock[i] = lock;
-            }
-            lm->lm_maxfreerequests = 0;
-            while (lm->lm_freerequest[i] != NULL) {
-                lock_request_t* req;
-                ss_dassert(lm->lm_freerequest[i]->lr_chk == DBE_CHK_FREELOCKREQ);
-                ss_debug(lm->lm_freerequest[i]->lr_chk = DBE_CHK_LOCKREQ);
-                req = lm->lm_freerequest[i]->lr_queue;
-                SsMemFree(lm->lm_freerequest[i]);
-                lm->lm_freerequest[i] = req;
-            }
-        }
-#else
         while (lm->lm_freelock != NULL) {
             lock_head_t* lock;
             ss_dassert(lm->lm_freelock->lh_chk == DBE_CHK_FREELOCKHEAD);
@@ -2145,18 +3118,11 @@ void dbe_lockmgr_done(dbe_lockmgr_t* lm)
             SsMemFree(lm->lm_freerequest);
             lm->lm_freerequest = req;
         }
-#endif
-        
-#ifdef LMGR_SPLITMUTEX
-        for (i = 0; i < lmgr_nmutexes; i++) {
-            SsSemFree(lm->lm_mutex[i]);
-        }
-#else
         if (!lm->lm_sharedsem) {
             SsSemFree(lm->lm_sem);
         }
-#endif
         SsMemFree(lm->lm_hash);
+#endif
         SsMemFree(lm);
 }
 
@@ -2233,6 +3199,28 @@ void dbe_lockmgr_printinfo(
             lm->lm_locktimeoutcnt);
         SsFprintf(fp, "  Active locks %ld\n",
             lm->lm_lockcnt);
+#ifdef LMGR_SPLITMUTEX
+        {
+            int i;
+            ulong hashsize = 0;
+            for (i = 0; i < lmgr_nmutexes; i++) {
+                hashsize += lm->lm_stripe[i].ls_hashsize;
+            }
+            SsFprintf(fp, "  Lock table stripes %d, hash size %lu, resizes %lu\n",
+                lmgr_nmutexes,
+                hashsize,
+                lm->lm_nresize);
+        }
+#endif
+#ifdef LMGR_BGDEADLOCK
+        if (lm->lm_deadlockdetect) {
+            SsFprintf(fp, "  Deadlock checks %lu, deadlocks %lu, check time %lu ms, waiting %u\n",
+                lm->lm_ndeadlockcheck,
+                lm->lm_ndeadlock,
+                lm->lm_deadlocktime,
+                lm->lm_nwaiting);
+        }
+#endif
 
 #ifndef LMGR_SPLITMUTEX
         SsSemExit(lm->lm_sem);
@@ -2361,7 +3349,7 @@ dbe_lock_reply_t dbe_lockmgr_lock(
                 });
 
 #ifdef LMGR_SPLITMUTEX
-        SsSemEnter(lm->lm_mutex[LMGR_MUTEX(lm, lockname)]);
+        SsSemEnter(LMGR_STRIPE(lm, lockname)->ls_mutex);
 #else
         SsSemEnter(lm->lm_sem);
 #endif
@@ -2427,10 +3415,15 @@ dbe_lock_reply_t dbe_lockmgr_lock(
 
  exit_function:
 #ifdef LMGR_SPLITMUTEX
-        SsSemExit(lm->lm_mutex[LMGR_MUTEX(lm, lockname)]);
+        SsSemExit(LMGR_STRIPE(lm, lockname)->ls_mutex);
 #else
         SsSemExit(lm->lm_sem);
 #endif
+#ifdef LMGR_BGDEADLOCK
+        if (reply == LOCK_WAIT && lm->lm_deadlockdetect) {
+            lmgr_waitlist_add(lm, locktran);
+        }
+#endif
         
         SS_POPNAME;
         return(reply);
@@ -2460,7 +3453,7 @@ dbe_lock_reply_t dbe_lockmgr_lock_long(
 #endif
 
 #ifdef LMGR_SPLITMUTEX
-        SsSemEnter(lm->lm_mutex[LMGR_MUTEX(lm, lockname)]);
+        SsSemEnter(LMGR_STRIPE(lm, lockname)->ls_mutex);
 #else
         SsSemEnter(lm->lm_sem);
 #endif
@@ -2526,10 +3519,15 @@ dbe_lock_reply_t dbe_lockmgr_lock_long(
 
  exit_function:
 #ifdef LMGR_SPLITMUTEX
-        SsSemExit(lm->lm_mutex[LMGR_MUTEX(lm, lockname)]);
+        SsSemExit(LMGR_STRIPE(lm, lockname)->ls_mutex);
 #else
         SsSemExit(lm->lm_sem);
 #endif
+#ifdef LMGR_BGDEADLOCK
+        if (reply == LOCK_WAIT && lm->lm_deadlockdetect) {
+            lmgr_waitlist_add(lm, locktran);
+        }
+#endif
 
         SS_POPNAME;
         return(reply);
@@ -2597,7 +3595,7 @@ dbe_lock_reply_t dbe_lockmgr_lock_mme(
         
         if (escalatep) {
 #ifdef LMGR_SPLITMUTEX
-            mutex_taken = lm->lm_mutex[LMGR_MUTEX(lm, *relid)];
+            mutex_taken = LMGR_STRIPE(lm, *relid)->ls_mutex;
             SsSemEnter(mutex_taken);
 #endif
             rellockmode = lockmgr_getrellockmode(mode);
@@ -2651,7 +3649,7 @@ dbe_lock_reply_t dbe_lockmgr_lock_mme(
 #endif /* DBE_LOCKESCALATE_OPT */
 
 #ifdef LMGR_SPLITMUTEX
-        mutex_taken = lm->lm_mutex[LMGR_MUTEX(lm, *lockname)];
+        mutex_taken = LMGR_STRIPE(lm, *lockname)->ls_mutex;
         SsSemEnter(mutex_taken);
 #endif
         
@@ -2696,6 +3694,11 @@ dbe_lock_reply_t dbe_lockmgr_lock_mme(
             SsSemExit(lm->lm_sem);
         }
 #endif
+#ifdef LMGR_BGDEADLOCK
+        if (reply == LOCK_WAIT && lm->lm_deadlockdetect) {
+            lmgr_waitlist_add(lm, locktran);
+        }
+#endif
 
         return(reply);
 }
@@ -2724,7 +3727,7 @@ dbe_lock_reply_t dbe_lockmgr_relock_mme(
         });
 
 #ifdef LMGR_SPLITMUTEX
-        SsSemEnter(lm->lm_mutex[LMGR_MUTEX(lm, lockname)]);
+        SsSemEnter(LMGR_STRIPE(lm, lockname)->ls_mutex);
 #else
         if (!lm->lm_sharedsem) {
             SsSemEnter(lm->lm_sem);
@@ -2744,12 +3747,17 @@ dbe_lock_reply_t dbe_lockmgr_relock_mme(
                     NULL);
 
 #ifdef LMGR_SPLITMUTEX
-        SsSemExit(lm->lm_mutex[LMGR_MUTEX(lm, lockname)]);
+        SsSemExit(LMGR_STRIPE(lm, lockname)->ls_mutex);
 #else
         if (!lm->lm_sharedsem) {
             SsSemExit(lm->lm_sem);
         }
 #endif
+#ifdef LMGR_BGDEADLOCK
+        if (reply == LOCK_WAIT && lm->lm_deadlockdetect) {
+            lmgr_waitlist_add(lm, locktran);
+        }
+#endif
         
         ss_dprintf_2(("dbe_lockmgr_relock_mme: return %d\n", reply));
 
@@ -2796,6 +3804,7 @@ void dbe_lockmgr_unlockall(
             lmgr_unlock_class(lm, locktran, LOCK_LONG, TRUE);
 
             locktran->lt_wait = NULL;
+            locktran->lt_startseq = 0;
 
 #ifndef LMGR_SPLITMUTEX
             SsSemExit(lm->lm_sem);
@@ -2818,6 +3827,7 @@ void dbe_lockmgr_unlockall_nomutex(
         lmgr_unlock_class(lm, locktran, LOCK_LONG, TRUE);
 
         locktran->lt_wait = NULL;
+        locktran->lt_startseq = 0;
 
         ss_dprintf_2(("dbe_lockmgr_unlockall_nomutex:return\n"));
 }
@@ -2833,6 +3843,7 @@ void dbe_lockmgr_unlockall_mme(
         if (locktran->lt_locks == NULL) {
             /* Nothing to unlock, avoid mutexing by returning immediately. */
             ss_dassert(locktran->lt_wait == NULL);
+            locktran->lt_startseq = 0;
             ss_dprintf_2(("dbe_lockmgr_unlockall_mme:return shortcut\n"));
             return;
         }
@@ -2846,6 +3857,7 @@ void dbe_lockmgr_unlockall_mme(
         lmgr_unlock_class(lm, locktran, LOCK_LONG, TRUE);
 
         locktran->lt_wait = NULL;
+        locktran->lt_startseq = 0;
 
         LMGR_FILL_MME_PMON(lm);
 
@@ -2874,6 +3886,7 @@ void dbe_lockmgr_unlockall_long(
         lmgr_unlock_class(lm, locktran, LOCK_VERY_LONG, TRUE);
 
         locktran->lt_wait = NULL;
+        locktran->lt_startseq = 0;
 
 #ifndef LMGR_SPLITMUTEX
         SsSemExit(lm->lm_sem);
@@ -2981,6 +3994,29 @@ dbe_locktran_t* dbe_locktran_init(rs_sysi_t* cd)
 #endif
         locktran->lt_wait = NULL;
         locktran->lt_cycle = NULL;
+#ifdef LMGR_SPLITMUTEX
+        for (i = 0; i < lmgr_nmutexes; i++) {
+            locktran->lt_freereq[i] = NULL;
+            locktran->lt_nfreereq[i] = 0;
+        }
+#else
+        locktran->lt_freereq = NULL;
+        locktran->lt_nfreereq = 0;
+#endif
+        locktran->lt_startseq = 0;
+#ifdef LMGR_BGDEADLOCK
+        locktran->lt_waitrelid = 0;
+        locktran->lt_waitname = 0;
+        locktran->lt_dlwaitrelid = 0;
+        locktran->lt_dlwaitname = 0;
+        locktran->lt_deadlockvictim = FALSE;
+        locktran->lt_waitlisted = FALSE;
+        locktran->lt_lm = NULL;
+        locktran->lt_waitprev = NULL;
+        locktran->lt_waitnext = NULL;
+        locktran->lt_dlpass = 0;
+        locktran->lt_dlindex = 0;
+#endif
 
         ss_dprintf_2(("dbe_locktran_init:locktran = %ld\n", (long)locktran));
 
@@ -3008,6 +4044,10 @@ dbe_locktran_t* dbe_locktran_init(rs_sysi_t* cd)
  */
 void dbe_locktran_done(dbe_locktran_t* locktran)
 {
+#ifdef LMGR_SPLITMUTEX
+        int i;
+#endif
+
         ss_dprintf_1(("dbe_locktran_done:userid = %d, locktran = %ld\n", rs_sysi_userid(locktran->lt_cd), (long)locktran));
         CHK_LOCKTRAN(locktran);
 
@@ -3023,6 +4063,41 @@ void dbe_locktran_done(dbe_locktran_t* locktran)
 #endif
         ss_dassert(locktran->lt_wait == NULL);
 
+#ifdef LMGR_BGDEADLOCK
+        if (locktran->lt_lm != NULL) {
+            /* Deadlock detector may still have this transaction in the
+             * wait list.
+             */
+            SsSemEnter(locktran->lt_lm->lm_waitsem);
+            if (locktran->lt_waitlisted) {
+                lmgr_waitlist_remove(locktran->lt_lm, locktran);
+            }
+            SsSemExit(locktran->lt_lm->lm_waitsem);
+        }
+#endif
+
+#ifdef LMGR_SPLITMUTEX
+        for (i = 0; i < lmgr_nmutexes; i++) {
+            while (locktran->lt_freereq[i] != NULL) {
+                lock_request_t* req;
+                ss_dassert(locktran->lt_freereq[i]->lr_chk == DBE_CHK_FREELOCKREQ);
+                ss_debug(locktran->lt_freereq[i]->lr_chk = DBE_CHK_LOCKREQ);
+                req = locktran->lt_freereq[i]->lr_queue;
+                SsMemFree(locktran->lt_freereq[i]);
+                locktran->lt_freereq[i] = req;
+            }
+        }
+#else
+        while (locktran->lt_freereq != NULL) {
+            lock_request_t* req;
+            ss_dassert(locktran->lt_freereq->lr_chk == DBE_CHK_FREELOCKREQ);
+            ss_debug(locktran->lt_freereq->lr_chk = DBE_CHK_LOCKREQ);
+            req = locktran->lt_freereq->lr_queue;
+            SsMemFree(locktran->lt_freereq);
+            locktran->lt_freereq = req;
+        }
+#endif
+
         SsMemFree(locktran);
 }
 
@@ -161,6 +161,7 @@ Example:
 #define DBE_DEFAULT_TRXBUFSIZE          4000
 #define DBE_DEFAULT_TRXEARLYVALIDATE    TRUE
 #define DBE_DEFAULT_USEIOTHREADS        FALSE
+#define DBE_DEFAULT_USEIOURING          FALSE
 #define DBE_DEFAULT_TABLE_LOCK_TO       30L
 #define DBE_DEFAULT_LOCKTIMEOUT         60L
 #define DBE_DEFAULT_MMELOCKHASHSIZE     1000000
@@ -204,6 +205,7 @@ Example:
 #define DBE_DEFAULT_FASTDEADLOCKDETECT                 FALSE
 #define DBE_DEFAULT_DEADLOCKDETECTMAXDEPTH             10
 #define DBE_DEFAULT_DEADLOCKDETECTMAXLOCKS             100000
+#define DBE_DEFAULT_DEADLOCKDETECTINTERVAL             100
 
 
 #define DBE_DEFAULT_SYNCHRONIZEDWRITE   TRUE
@@ -225,6 +227,11 @@ Example:
 #define CFG_MAX_NUMIOTHREADS            128
 
 #define DBE_DEFAULT_MAXPAGESEM          0x7FFFFFFFL
+#define DBE_DEFAULT_CACHELRUPARTITIONS  16
+#define DBE_MAX_CACHELRUPARTITIONS      64
+#define DBE_DEFAULT_CACHEPOLICY         0       /* 0=LRU, 1=midpoint insertion */
+#define DBE_MAX_CACHEPOLICY             1
+#define DBE_DEFAULT_CACHEPROBATIONTIME  1000    /* ms */
 
 #define DBE_MIN_RELBUFSIZE              5
 #define DBE_MAX_TRXBUFSIZE              500000L
@@ -269,10 +276,13 @@ bool dbe_cfg_usepessimisticgate;
 bool dbe_cfg_versionedpessimisticreadcommitted;
 bool dbe_cfg_versionedpessimisticrepeatableread;
 int  dbe_cfg_maxmergeparts;
+int  dbe_cfg_maxmergetasks;
+int  dbe_cfg_recoverythreads;
 bool dbe_cfg_startupforcemerge;
 bool dbe_cfg_fastdeadlockdetect;
-bool dbe_cfg_deadlockdetectmaxdepth;
-bool dbe_cfg_deadlockdetectmaxlocks;
+int  dbe_cfg_deadlockdetectmaxdepth;
+int  dbe_cfg_deadlockdetectmaxlocks;
+long dbe_cfg_deadlockdetectinterval;
 bool dbe_cfg_splitpurge;
 bool dbe_cfg_mergecleanup;
 bool dbe_cfg_usenewbtreelocking;
@@ -675,6 +685,13 @@ static su_initparam_t dbe_parameters[] = {
         SU_PARAM_TYPE_LONG, SU_PARAM_AM_RWSTARTUP,
         "Number of writer I/O-threads per device"
     },
+    {
+        SU_DBE_GENERALSECTION, SU_DBE_USEIOURING,
+        NULL, 0, 0.0, DBE_DEFAULT_USEIOURING,
+        conf_param_rwstartup_set_cb, NULL,
+        SU_PARAM_TYPE_BOOL, SU_PARAM_AM_RWSTARTUP,
+        "If set to yes, batched I/O requests use io_uring when available"
+    },
     {
         SU_DBE_GENERALSECTION, SU_DBE_DEFAULTSTOREISMEMORY,
         NULL, 0, 0.0, DBE_DEFAULT_DEFAULTSTOREISMEMORY,
@@ -763,6 +780,27 @@ static su_initparam_t dbe_parameters[] = {
         SU_PARAM_TYPE_LONG, SU_PARAM_AM_RWSTARTUP,
         "Percentage of page buffer which is kept clean by preflush thread"
     },
+    {
+        SU_DBE_INDEXSECTION, SU_DBE_CACHELRUPARTITIONS,
+        NULL, DBE_DEFAULT_CACHELRUPARTITIONS, 0.0, 0,
+        conf_param_rwstartup_set_cb, NULL,
+        SU_PARAM_TYPE_LONG, SU_PARAM_AM_RWSTARTUP,
+        "Number of LRU partitions in page buffer, each partition has its own mutex"
+    },
+    {
+        SU_DBE_INDEXSECTION, SU_DBE_CACHEPOLICY,
+        NULL, DBE_DEFAULT_CACHEPOLICY, 0.0, 0,
+        conf_param_rwstartup_set_cb, NULL,
+        SU_PARAM_TYPE_LONG, SU_PARAM_AM_RWSTARTUP,
+        "Page buffer replacement policy, 0 = priority LRU, 1 = midpoint insertion with probation time"
+    },
+    {
+        SU_DBE_INDEXSECTION, SU_DBE_CACHEPROBATIONTIME,
+        NULL, DBE_DEFAULT_CACHEPROBATIONTIME, 0.0, 0,
+        conf_param_rwstartup_set_cb, NULL,
+        SU_PARAM_TYPE_LONG, SU_PARAM_AM_RWSTARTUP,
+        "Time in milliseconds a page read from disk stays in probation when midpoint insertion replacement policy is used"
+    },
     {
         SU_DBE_INDEXSECTION, SU_DBE_USENEWKEYCHECK,
         NULL, 0, 0.0, DBE_DEFAULT_USENEWKEYCHECK,
@@ -1325,21 +1363,33 @@ static dbe_cfg_t* cfg_init(
         if (!foundp) {
             dbe_cfg_fastdeadlockdetect = DBE_DEFAULT_FASTDEADLOCKDETECT;
         }
-        foundp = su_inifile_getbool(
+        foundp = su_inifile_getlong(
                     cfg_file,
                     SU_DBE_GENERALSECTION,
                     SU_DBE_DEADLOCKDETECTMAXDEPTH,
-                    &dbe_cfg_deadlockdetectmaxdepth);
-        if (!foundp) {
+                    &l);
+        if (!foundp || l <= 0) {
             dbe_cfg_deadlockdetectmaxdepth = DBE_DEFAULT_DEADLOCKDETECTMAXDEPTH;
+        } else {
+            dbe_cfg_deadlockdetectmaxdepth = (int)l;
         }
-        foundp = su_inifile_getbool(
+        foundp = su_inifile_getlong(
                     cfg_file,
                     SU_DBE_GENERALSECTION,
                     SU_DBE_DEADLOCKDETECTMAXLOCKS,
-                    &dbe_cfg_deadlockdetectmaxlocks);
-        if (!foundp) {
+                    &l);
+        if (!foundp || l <= 0) {
             dbe_cfg_deadlockdetectmaxlocks = DBE_DEFAULT_DEADLOCKDETECTMAXLOCKS;
+        } else {
+            dbe_cfg_deadlockdetectmaxlocks = (int)l;
+        }
+        foundp = su_inifile_getlong(
+                    cfg_file,
+                    SU_DBE_GENERALSECTION,
+                    SU_DBE_DEADLOCKDETECTINTERVAL,
+                    &dbe_cfg_deadlockdetectinterval);
+        if (!foundp || dbe_cfg_deadlockdetectinterval <= 0) {
+            dbe_cfg_deadlockdetectinterval = DBE_DEFAULT_DEADLOCKDETECTINTERVAL;
         }
 
         foundp = su_inifile_getbool(
@@ -1389,6 +1439,28 @@ static dbe_cfg_t* cfg_init(
         } else {
             dbe_cfg_maxmergeparts = (int)l;
         }
+        foundp = su_inifile_getlong(
+                    cfg_file,
+                    SU_DBE_GENERALSECTION,
+                    SU_DBE_MAXMERGETASKS,
+                    &l);
+        if (!foundp || l < 0) {
+            /* Zero means one merge task per processor. */
+            dbe_cfg_maxmergetasks = 0;
+        } else {
+            dbe_cfg_maxmergetasks = (int)l;
+        }
+        foundp = su_inifile_getlong(
+                    cfg_file,
+                    SU_DBE_GENERALSECTION,
+                    SU_DBE_RECOVERYTHREADS,
+                    &l);
+        if (!foundp || l < 0) {
+            /* Zero means one recovery apply thread per processor. */
+            dbe_cfg_recoverythreads = 0;
+        } else {
+            dbe_cfg_recoverythreads = (int)l;
+        }
         foundp = su_inifile_getbool(
                     cfg_file,
                     SU_DBE_GENERALSECTION,
@@ -4534,6 +4606,51 @@ bool dbe_cfg_getuseiothreads(
         return(found);
 }
 
+/*##**********************************************************************\
+ *
+ *              dbe_cfg_getuseiouring
+ *
+ * Checks whether batched I/O manager requests may use io_uring. If the
+ * kernel does not support io_uring native list I/O is used.
+ *
+ * Parameters :
+ *
+ *      dbe_cfg - in, use
+ *              configuration object
+ *
+ *      p_useiouring - out, use
+ *              pointer to bool variable where the result will be stored
+ *
+ *
+ * Return value :
+ *      TRUE if the information is found from config. file or
+ *      FALSE when the default is given.
+ *
+ * Comments :
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+bool dbe_cfg_getuseiouring(
+        dbe_cfg_t* dbe_cfg,
+        bool* p_useiouring)
+{
+        bool found;
+
+        found = su_inifile_getbool(
+                    dbe_cfg->cfg_file,
+                    SU_DBE_GENERALSECTION,
+                    SU_DBE_USEIOURING,
+                    p_useiouring);
+
+        if (!found) {
+            *p_useiouring = DBE_DEFAULT_USEIOURING;
+        }
+
+        return(found);
+}
+
 
 /*##**********************************************************************\
  *
@@ -5308,6 +5425,152 @@ bool dbe_cfg_getidxmaxpagesemcount(
         return(found);
 }
 
+/*##**********************************************************************\
+ *
+ *              dbe_cfg_getidxcachelrupartitions
+ *
+ * Gets number of LRU partitions used in index file cache. Each
+ * partition has its own mutex.
+ *
+ * Parameters :
+ *
+ *      dbe_cfg - in, use
+ *              config object
+ *
+ *      p_nlru - out
+ *              pointer to variable where the value will be stored
+ *
+ * Return value :
+ *      TRUE if the information is found from config. file or
+ *      FALSE when the default is given.
+ *
+ * Comments :
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+bool dbe_cfg_getidxcachelrupartitions(
+        dbe_cfg_t* dbe_cfg,
+        uint* p_nlru)
+{
+        bool found;
+        long l;
+
+        found = su_inifile_getlong(
+                    dbe_cfg->cfg_file,
+                    SU_DBE_INDEXSECTION,
+                    SU_DBE_CACHELRUPARTITIONS,
+                    &l);
+
+        if (found) {
+            if (l < 1L) {
+                l = 1L;
+            } else if (l > DBE_MAX_CACHELRUPARTITIONS) {
+                l = DBE_MAX_CACHELRUPARTITIONS;
+            }
+            *p_nlru = (uint)l;
+        } else {
+            *p_nlru = DBE_DEFAULT_CACHELRUPARTITIONS;
+        }
+        return(found);
+}
+
+/*##**********************************************************************\
+ *
+ *              dbe_cfg_getidxcachepolicy
+ *
+ * Gets index file cache page replacement policy.
+ *
+ * Parameters :
+ *
+ *      dbe_cfg - in, use
+ *              config object
+ *
+ *      p_policy - out
+ *              pointer to variable where the value will be stored,
+ *              0 = priority LRU, 1 = midpoint insertion
+ *
+ * Return value :
+ *      TRUE if the information is found from config. file or
+ *      FALSE when the default is given.
+ *
+ * Comments :
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+bool dbe_cfg_getidxcachepolicy(
+        dbe_cfg_t* dbe_cfg,
+        uint* p_policy)
+{
+        bool found;
+        long l;
+
+        found = su_inifile_getlong(
+                    dbe_cfg->cfg_file,
+                    SU_DBE_INDEXSECTION,
+                    SU_DBE_CACHEPOLICY,
+                    &l);
+
+        if (found && l >= 0L && l <= DBE_MAX_CACHEPOLICY) {
+            *p_policy = (uint)l;
+        } else {
+            *p_policy = DBE_DEFAULT_CACHEPOLICY;
+        }
+        return(found);
+}
+
+/*##**********************************************************************\
+ *
+ *              dbe_cfg_getidxcacheprobationtime
+ *
+ * Gets time in milliseconds a page read from disk is kept in probation
+ * when midpoint insertion cache replacement policy is used.
+ *
+ * Parameters :
+ *
+ *      dbe_cfg - in, use
+ *              config object
+ *
+ *      p_probationtime - out
+ *              pointer to variable where the value will be stored
+ *
+ * Return value :
+ *      TRUE if the information is found from config. file or
+ *      FALSE when the default is given.
+ *
+ * Comments :
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+bool dbe_cfg_getidxcacheprobationtime(
+        dbe_cfg_t* dbe_cfg,
+        long* p_probationtime)
+{
+        bool found;
+        long l;
+
+        found = su_inifile_getlong(
+                    dbe_cfg->cfg_file,
+                    SU_DBE_INDEXSECTION,
+                    SU_DBE_CACHEPROBATIONTIME,
+                    &l);
+
+        if (found) {
+            if (l < 0L) {
+                l = 0L;
+            }
+            *p_probationtime = l;
+        } else {
+            *p_probationtime = DBE_DEFAULT_CACHEPROBATIONTIME;
+        }
+        return(found);
+}
+
 /*##**********************************************************************\
  *
  *              dbe_cfg_getdefaultstoreismemory
@@ -5835,6 +6098,13 @@ void dbe_cfg_addtocfgl(
             SU_DBE_PESSIMISTIC,
             DBE_DEFAULT_PESSIMISTIC,
             advancedflags);
+        su_cfgl_addbool(
+            cfgl,
+            dbe_cfg->cfg_file,
+            SU_DBE_GENERALSECTION,
+            SU_DBE_USEIOURING,
+            DBE_DEFAULT_USEIOURING,
+            advancedflags);
         su_cfgl_addlong(
             cfgl,
             dbe_cfg->cfg_file,
@@ -5878,6 +6148,27 @@ void dbe_cfg_addtocfgl(
             SU_DBE_MAXPAGESEM,
             (long)DBE_DEFAULT_MAXPAGESEM,
             advancedflags);
+        su_cfgl_addlong(
+            cfgl,
+            dbe_cfg->cfg_file,
+            SU_DBE_INDEXSECTION,
+            SU_DBE_CACHELRUPARTITIONS,
+            (long)DBE_DEFAULT_CACHELRUPARTITIONS,
+            advancedflags);
+        su_cfgl_addlong(
+            cfgl,
+            dbe_cfg->cfg_file,
+            SU_DBE_INDEXSECTION,
+            SU_DBE_CACHEPOLICY,
+            (long)DBE_DEFAULT_CACHEPOLICY,
+            advancedflags);
+        su_cfgl_addlong(
+            cfgl,
+            dbe_cfg->cfg_file,
+            SU_DBE_INDEXSECTION,
+            SU_DBE_CACHEPROBATIONTIME,
+            (long)DBE_DEFAULT_CACHEPROBATIONTIME,
+            advancedflags);
         su_cfgl_addbool(
             cfgl,
             dbe_cfg->cfg_file,
@@ -269,6 +269,7 @@ dbe_gtrs_t* dbe_gtrs_init(
         gtrs->gtrs_pendingmergewrites = 0;
         gtrs->gtrs_atcache = NULL;
         gtrs->gtrs_ncachedats = 0;
+        gtrs->gtrs_mergetrxnum = DBE_TRXNUM_NULL;
         ss_debug(gtrs->gtrs_insidemutex = FALSE);
         ss_debug(gtrs->gtrs_lastcommittrxnum = DBE_TRXNUM_NULL;)
         ss_debug(gtrs->gtrs_lastmaxtrxnum = DBE_TRXNUM_NULL;)
@@ -519,16 +520,20 @@ void dbe_gtrs_begintrx(dbe_gtrs_t* gtrs, dbe_trxinfo_t* trxinfo, rs_sysi_t* cd)
         ss_dprintf_1(("dbe_gtrs_begintrx:maxtrxnum=%ld, usertrxid=%ld\n",
             DBE_TRXNUM_GETLONG(trxinfo->ti_maxtrxnum), DBE_TRXID_GETLONG(trxinfo->ti_usertrxid)));
         CHK_TRXINFO(trxinfo);
-
-        SsFlatMutexLock(gtrs->gtrs_sem);
-
-        ss_debug(gtrs->gtrs_insidemutex = TRUE);
         ss_dassert(trxinfo->ti_actlistnode == NULL);
 
+        /* The trxinfo is not yet visible through gtrs, so the link is
+         * done outside the trx gate. This keeps the trxbuf mutex out of
+         * the gate at every transaction start.
+         */
         trxbufsem = dbe_trxbuf_getsembytrxid(gtrs->gtrs_trxbuf, trxinfo->ti_usertrxid);
 
         dbe_trxinfo_link(trxinfo, trxbufsem);
 
+        SsFlatMutexLock(gtrs->gtrs_sem);
+
+        ss_debug(gtrs->gtrs_insidemutex = TRUE);
+
         if (gtrs->gtrs_atcache != NULL) {
             ss_dassert(gtrs->gtrs_ncachedats > 0);
             at = gtrs->gtrs_atcache;
@@ -1087,13 +1092,18 @@ void dbe_gtrs_endtrx(
             mergetrxnum = dbe_counter_getmaxtrxnum(gtrs->gtrs_ctr);
         }
         if (!DBE_TRXNUM_EQUAL(mergetrxnum, DBE_TRXNUM_NULL)) {
-            /* Set the new merge level.
+            /* Set the new merge level. Most transactions end without
+             * moving the oldest read level, so the counter and the aborted
+             * relations list are touched only when the level advances.
              */
-            ss_dprintf_2(("dbe_gtrs_endtrx:new mergetrxnum=%ld\n", DBE_TRXNUM_GETLONG(mergetrxnum)));
-            if (!dbe_gtrs_mergecleanup_recovery) {
+            if (dbe_gtrs_mergecleanup_recovery) {
+                gtrs_purge_abortedrelhs(gtrs, mergetrxnum);
+            } else if (DBE_TRXNUM_CMP_EX(mergetrxnum, gtrs->gtrs_mergetrxnum) > 0) {
+                ss_dprintf_2(("dbe_gtrs_endtrx:new mergetrxnum=%ld\n", DBE_TRXNUM_GETLONG(mergetrxnum)));
                 dbe_counter_setmergetrxnum(gtrs->gtrs_ctr, mergetrxnum);
+                gtrs->gtrs_mergetrxnum = mergetrxnum;
+                gtrs_purge_abortedrelhs(gtrs, mergetrxnum);
             }
-            gtrs_purge_abortedrelhs(gtrs, mergetrxnum);
 
             /* Update abort trx id. First read off all ended transactions
              * and remember the last trx number that was smaller than the
@@ -691,6 +691,18 @@ struct dbe_logfile_st {
         bool                lf_lazyflush_extendfile;
         uint                lf_lazyflush_extendincrement;
 
+        /* Leader/follower group commit. The writer thread only writes
+         * the batch and advances lf_gcwriteseq, the physical sync is
+         * done by the first committer that finds it missing.
+         */
+        SsFlatMutexT        lf_gcmutex;         /* protects lf_gc* state */
+        SsSemT*             lf_gcsyncsem;       /* serializes sync with file close */
+        bool                lf_gcdeferflush;    /* TRUE when logfile_flush skips sync */
+        bool                lf_gcsyncactive;    /* TRUE when leader is syncing */
+        long                lf_gcwriteseq;      /* # of written flush batches */
+        long                lf_gcsyncseq;       /* lf_gcwriteseq covered by sync */
+        su_meswaitlist_t*   lf_gcmeswaitlist;   /* followers */
+
 #endif /* DBE_GROUPCOMMIT_QUEUE */
 
 #ifdef SS_HSBG2
@@ -1303,6 +1315,15 @@ static dbe_ret_t logfile_flush(
             }
         }
 
+#ifdef DBE_GROUPCOMMIT_QUEUE
+        if (logfile->lf_gcdeferflush) {
+            /* Physical sync is left to logfile_groupcommit_sync. */
+            ss_pprintf_3(("logfile_flush:defer physical flush\n"));
+            su_profile_stop("logfile_flush:su_vfh_flush");
+            return(SU_SUCCESS);
+        }
+#endif /* DBE_GROUPCOMMIT_QUEUE */
+
         ss_pprintf_3(("logfile_flush:do physical flush\n"));
         SsBFlush(logfile->lf_bfile);
 
@@ -1900,6 +1921,16 @@ static dbe_ret_t logfile_split(
                                         logfile->lf_nametemplate,
                                         logfile->lf_logfnum,
                                         logfile->lf_digittemplate);
+#ifdef DBE_GROUPCOMMIT_QUEUE
+            if (logfile->lf_groupcommitqueue) {
+                /* Wait for a running group commit sync and make
+                 * sure writes whose sync was deferred are on disk
+                 * before the file is closed.
+                 */
+                SsSemEnter(logfile->lf_gcsyncsem);
+                SsBFlush(logfile->lf_bfile);
+            }
+#endif /* DBE_GROUPCOMMIT_QUEUE */
             SsBClose(logfile->lf_bfile);
             logfile->lf_writebuffer_address = -1;
             logfile->lf_writebuffer_nbytes = 0;
@@ -1907,6 +1938,11 @@ static dbe_ret_t logfile_split(
                                     logfile->lf_filename,
                                     logfile->lf_openflags,
                                     logfile->lf_bufsize);
+#ifdef DBE_GROUPCOMMIT_QUEUE
+            if (logfile->lf_groupcommitqueue) {
+                SsSemExit(logfile->lf_gcsyncsem);
+            }
+#endif /* DBE_GROUPCOMMIT_QUEUE */
             logfile->lf_lp.lp_daddr = logfile_getsize(logfile);
             if (logfile->lf_lp.lp_daddr != 0L) {
                 su_informative_exit(
@@ -3190,6 +3226,116 @@ static bool logfile_logdata_mustclose(dbe_logrectype_t logrectype)
         }
 }
 
+/*#***********************************************************************\
+ *
+ *              logfile_groupcommit_sync
+ *
+ * Makes sure that all flush batches written by the writer thread before
+ * the call are physically on disk. The first committer that finds the
+ * sync missing becomes the leader and syncs the file outside the logfile
+ * mutex so the writer thread can keep appending the next batches. Other
+ * committers wait as followers until the leader sync covers their batch.
+ *
+ * Parameters :
+ *
+ *      logfile - in out, use
+ *              pointer to logfile object
+ *
+ * Return value :
+ *      DBE_RC_SUCC when ok or
+ *      error code otherwise
+ *
+ * Comments :
+ *      Called after the writer thread has returned DBE_RC_WAITFLUSH
+ *      to the committer.
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+static dbe_ret_t logfile_groupcommit_sync(
+        dbe_logfile_t* logfile)
+{
+        long target;
+        long syncseq;
+        bool succp;
+        su_mes_t* mes = NULL;
+        su_meswaitlist_t* meswaitlist;
+
+        ss_dassert(logfile->lf_groupcommitqueue);
+
+        SsFlatMutexLock(logfile->lf_gcmutex);
+
+        target = logfile->lf_gcwriteseq;
+
+        while (logfile->lf_gcsyncseq < target) {
+            if (!logfile->lf_gcsyncactive) {
+                /* Leader, sync everything written so far. */
+                logfile->lf_gcsyncactive = TRUE;
+                syncseq = logfile->lf_gcwriteseq;
+                SsFlatMutexUnlock(logfile->lf_gcmutex);
+
+                ss_pprintf_2(("logfile_groupcommit_sync:leader, syncseq=%ld\n", syncseq));
+                SS_PMON_ADD(SS_PMON_LOGGROUPCOMMIT_LEADER);
+
+                /* The writer thread keeps writing to the file, so sync
+                 * the descriptor without touching the file state. The
+                 * sync semaphore keeps the file open.
+                 */
+                SsSemEnter(logfile->lf_gcsyncsem);
+                succp = SsBSync(logfile->lf_bfile);
+                SsSemExit(logfile->lf_gcsyncsem);
+                SS_PMON_ADD(SS_PMON_LOGFLUSHES_PHYSICAL);
+
+                SsFlatMutexLock(logfile->lf_gcmutex);
+                ss_dassert(logfile->lf_gcsyncseq < syncseq);
+                if (!succp) {
+                    /* A failed sync cannot be retried reliably, fail
+                     * this and all later commits.
+                     */
+                    ss_pprintf_1(("logfile_groupcommit_sync:sync failed\n"));
+                    logfile->lf_errorflag = TRUE;
+                }
+                logfile->lf_gcsyncseq = syncseq;
+                logfile->lf_gcsyncactive = FALSE;
+                meswaitlist = logfile->lf_gcmeswaitlist;
+                logfile->lf_gcmeswaitlist = su_meswaitlist_init();
+                SsFlatMutexUnlock(logfile->lf_gcmutex);
+
+                su_meswaitlist_wakeupall(meswaitlist);
+
+                SsFlatMutexLock(logfile->lf_gcmutex);
+            } else {
+                /* Follower, wait for the running sync. If it does not
+                 * cover our batch we may become the next leader.
+                 */
+                if (mes == NULL) {
+                    mes = su_meslist_mesinit(logfile->lf_wqinfo.wqi_writequeue_meslist);
+                    SS_PMON_ADD(SS_PMON_LOGGROUPCOMMIT_FOLLOWER);
+                }
+                su_meswaitlist_add(logfile->lf_gcmeswaitlist, mes);
+                SsFlatMutexUnlock(logfile->lf_gcmutex);
+
+                ss_pprintf_2(("logfile_groupcommit_sync:follower, target=%ld\n", target));
+                su_mes_wait(mes);
+
+                SsFlatMutexLock(logfile->lf_gcmutex);
+            }
+        }
+
+        succp = !logfile->lf_errorflag;
+
+        SsFlatMutexUnlock(logfile->lf_gcmutex);
+
+        if (mes != NULL) {
+            su_meslist_mesdone(logfile->lf_wqinfo.wqi_writequeue_meslist, mes);
+        }
+        if (!succp) {
+            return(SU_ERR_FILE_WRITE_FAILURE);
+        }
+        return(DBE_RC_SUCC);
+}
+
 static void SS_CALLBACK logf_writequeue_flushthr(void* data)
 {
         logf_writequeinfo_t* wqinfo = data;
@@ -3208,6 +3354,7 @@ static void SS_CALLBACK logf_writequeue_flushthr(void* data)
             logf_writequeue_t* wq_first;
             logf_writequeue_t* wq_last;
             bool flush;
+            bool deferflush;
             bool splitlog = FALSE;
             size_t logdatalenwritten;
             int qlen;
@@ -3264,6 +3411,7 @@ static void SS_CALLBACK logf_writequeue_flushthr(void* data)
             su_meswaitlist_wakeupall(meswaitlist);
 
             flush = FALSE;
+            deferflush = FALSE;
             wq_last = NULL;
             rc = DBE_RC_SUCC;
             written_now = 0;
@@ -3382,11 +3530,33 @@ static void SS_CALLBACK logf_writequeue_flushthr(void* data)
 
             if (rc == DBE_RC_SUCC) {
                 if (flush) {
-                    ss_pprintf_1(("logf_writequeue_flushthr:FLUSH:call logfile_writebuf\n"));
-                    wqinfo->wqi_logfile->lf_lazyflush_do = FALSE;
-                    rc = logfile_writebuf(wqinfo->wqi_logfile, TRUE, FALSE);
+                    dbe_logfile_t* logfile = wqinfo->wqi_logfile;
+
+                    /* Physical sync is deferred to the committers when
+                     * write order does not depend on it.
+                     */
+#ifdef SS_BSYNC_AVAILABLE
+                    deferflush = logfile->lf_wrmode != DBE_LOGWR_PINGPONG
+                                 && logfile->lf_hsbsvc == NULL
+                                 && !logfile->lf_transform;
+#else
+                    /* No sync that can run concurrently with writes. */
+                    deferflush = FALSE;
+#endif /* SS_BSYNC_AVAILABLE */
+                    ss_pprintf_1(("logf_writequeue_flushthr:FLUSH:call logfile_writebuf, deferflush=%d\n", deferflush));
+                    logfile->lf_lazyflush_do = FALSE;
+                    logfile->lf_gcdeferflush = deferflush;
+                    rc = logfile_writebuf(logfile, TRUE, FALSE);
+                    logfile->lf_gcdeferflush = FALSE;
                     if (rc != DBE_RC_SUCC) {
                         ss_pprintf_1(("logf_writequeue_flushthr:ERROR, rc=%d\n", rc));
+                    } else if (deferflush) {
+                        for (wq = wq_first; wq != NULL; wq = wq->wq_next) {
+                            if (wq->wq_p_rc != NULL) {
+                                ss_dassert(*wq->wq_p_rc == DBE_RC_SUCC);
+                                *wq->wq_p_rc = DBE_RC_WAITFLUSH;
+                            }
+                        }
                     }
                 }
             }
@@ -3409,6 +3579,13 @@ static void SS_CALLBACK logf_writequeue_flushthr(void* data)
 
             logfile_exit_mutex2(wqinfo->wqi_logfile);
 
+            if (rc == DBE_RC_SUCC && deferflush) {
+                /* Waiters sync up to this batch before returning. */
+                SsFlatMutexLock(wqinfo->wqi_logfile->lf_gcmutex);
+                wqinfo->wqi_logfile->lf_gcwriteseq++;
+                SsFlatMutexUnlock(wqinfo->wqi_logfile->lf_gcmutex);
+            }
+
             ss_pprintf_1(("logf_writequeue_flushthr:wakeupall flushmeswaitlist\n"));
             su_meswaitlist_wakeupall(flushmeswaitlist);
 
@@ -4128,6 +4305,14 @@ dbe_logfile_t* dbe_logfile_init(
             logfile->lf_wqinfo.wqi_writeactive = FALSE;
             logfile->lf_wqinfo.wqi_done = FALSE;
 
+            SsFlatMutexInit(&logfile->lf_gcmutex, SS_SEMNUM_DBE_LOGGROUPCOMMIT);
+            logfile->lf_gcsyncsem = SsSemCreateLocal(SS_SEMNUM_DBE_LOGGROUPCOMMITSYNC);
+            logfile->lf_gcdeferflush = FALSE;
+            logfile->lf_gcsyncactive = FALSE;
+            logfile->lf_gcwriteseq = 0;
+            logfile->lf_gcsyncseq = 0;
+            logfile->lf_gcmeswaitlist = su_meswaitlist_init();
+
             ss_pprintf_2(("dbe_logfile_init:start logf_writequeue_flushthr\n"));
             thr = SsThrInitParam(
                     logf_writequeue_flushthr,
@@ -4214,6 +4399,10 @@ void dbe_logfile_done(dbe_logfile_t* logfile)
             su_meslist_done(&logfile->lf_wqinfo.wqi_writequeue_meslist_buf);
             su_meswaitlist_done(logfile->lf_wqinfo.wqi_writequeue_meswaitlist);
             su_meswaitlist_done(logfile->lf_wqinfo.wqi_writequeue_flushmeswaitlist);
+            ss_dassert(!logfile->lf_gcsyncactive);
+            su_meswaitlist_done(logfile->lf_gcmeswaitlist);
+            SsSemFree(logfile->lf_gcsyncsem);
+            SsFlatMutexDone(logfile->lf_gcmutex);
             if (!logfile->lf_transform) {
                 ss_dassert(logfile->lf_wqinfo.wqi_writequeue_first == NULL);
                 ss_dassert(logfile->lf_wqinfo.wqi_writequeue_last == NULL);
@@ -4886,6 +5075,9 @@ static dbe_ret_t logfile_putdata_splitif_writequeue(
                     ss_dassert(rc != 0xffff);
                     ss_pprintf_2(("logfile_putdata_splitif_writequeue:wakeup from flush\n"));
                     su_meslist_mesdone(logfile->lf_wqinfo.wqi_writequeue_meslist, mes);
+                    if (rc == DBE_RC_WAITFLUSH) {
+                        rc = logfile_groupcommit_sync(logfile);
+                    }
                 } else {
                     ss_pprintf_2(("logfile_putdata_splitif_writequeue:set wait mes to cd\n"));
                     rs_sysi_setlogwaitmes(cd, logfile->lf_wqinfo.wqi_writequeue_meslist, mes);
@@ -5138,6 +5330,11 @@ dbe_ret_t dbe_logfile_waitflushmes(
             rc = *rs_sysi_getlogwaitrc(cd);
             ss_pprintf_2(("dbe_logfile_waitflushmes:wakeup from flush, rc = %d\n", rc));
             rs_sysi_removelogwaitmes(cd);
+#ifdef DBE_GROUPCOMMIT_QUEUE
+            if (rc == DBE_RC_WAITFLUSH) {
+                rc = logfile_groupcommit_sync(logfile);
+            }
+#endif /* DBE_GROUPCOMMIT_QUEUE */
         } else {
             ss_pprintf_2(("dbe_logfile_waitflushmes:no need to wait for flush\n"));
             rc = DBE_RC_SUCC;
@@ -260,11 +260,13 @@ dbe_trxbuf_t* dbe_trxbuf_init(
         tb->tb_visiblealltrxid = aborttrxid;
         tb->tb_aborttrxid = aborttrxid;
         tb->tb_disabletrxid = DBE_TRXID_NULL;
-        tb->tb_nbufslots = 16; /* This should be configurable */
+        tb->tb_nbufslots = DBE_TRXBUF_NBUFSLOTS;
         tb->tb_tbslottable = SsMemAlloc(tb->tb_nbufslots * sizeof(dbe_trxbufslot_t*));
+        tb->tb_tbslotarray = SsMemAlloc(tb->tb_nbufslots * sizeof(dbe_trxbufpaddedslot_t));
         tb->tb_trxinfo_sem = SsMemAlloc(tb->tb_nbufslots * sizeof(tb->tb_trxinfo_sem[0]));
+        ss_dassert(sizeof(dbe_trxbufslot_t) <= sizeof(tb->tb_tbslotarray[0].ps_pad));
         for (i=0;i<tb->tb_nbufslots;i++ ) {
-            tbs = SsMemAlloc(sizeof(dbe_trxbufslot_t)); 
+            tbs = &tb->tb_tbslotarray[i].ps_slot;
 
             ss_debug(tbs->tbs_chk = DBE_CHK_TRXBUFSLOT);
             tbs->tbs_list = NULL;
@@ -320,8 +322,8 @@ void dbe_trxbuf_done(dbe_trxbuf_t* tb)
                 trxbuf_listdeletefun(del_ts);
             }
             SsFlatMutexDone(tbs->tbs_sem);
-            SsMemFree(tbs);
         }
+        SsMemFree(tb->tb_tbslotarray);
         for (i=0;i<tb->tb_nbufslots;i++ ) {
             SsQsemFree(tb->tb_trxinfo_sem[i]);
         }
@@ -50,6 +50,28 @@ reached it is removed from the LRU list. If the requested block is not
 already in memory, a free block is taken from the tail of the LRU list.
 When the block is released, it is put to the head of the LRU list.
 
+Replacement policy can be either priority LRU or midpoint insertion
+(see dbe_cache_setreplacementpolicy). In both policies slots released
+with LASTUSE hint are put to the low priority LRU and slots released
+with IGNORE hint directly to the victim area. With midpoint insertion
+also a page that is read from disk is first released to the low
+priority (probation) LRU, which works as the midpoint of the whole LRU.
+It is promoted to high priority LRU only when it is referenced again
+after the probation time has elapsed since it was read. Thus a large
+table scan that touches each page only during a short time can replace
+only the probation part of the LRU and frequently used index pages stay
+in cache. This is a time based variant of midpoint insertion, not 2Q:
+there are no separate A1in and A1out queues and no ghost entries of
+evicted pages.
+
+The LRU is split into several partitions (configurable, see
+dbe_cache_init) each having its own mutex, LRU lists, victim area and
+flush batch lists. Every slot belongs permanently to one partition.
+A victim for a new page is first searched from the partition selected
+by hashing the page address and only if that partition is exhausted
+from the other partitions. This way concurrent page replacements of
+different addresses seldom compete for the same LRU mutex.
+
 All external functions are reentrant, and need not be called from a mutex
 section. All static function, unless otherwise specified, must be called
 inside the cache mutex.
@@ -102,6 +124,16 @@ later one is locked using bounce-request for the semaphore and making a
 retry when locking fails. In cases when the slot is reached to write
 mode access by another thread the requesting thread sleep into event
 wait. For that purpose each cache slot has a message semaphore.
+When a slot is moved in LRU, only the mutex of the LRU partition of
+that slot is locked.
+
+In product builds a read-only reach of a slot that is already shared
+by other readers is done without the hash bucket mutex. The hash chain
+is read optimistically, the in use counter is incremented with compare
+and swap and the result is validated against a per bucket sequence
+number. Releases that leave other readers on the slot are also done
+without the mutex. Transitions of the in use counter from and to zero
+always take the mutex.
 
 
 Example:
@@ -118,7 +150,7 @@ void main(void)
         svfil = ...;
 
         /* Open cache with 1000 memory blocks */
-        cache = dbe_cache_init(svfil, 1000, 100);
+        cache = dbe_cache_init(svfil, 1000, 100, 0);
 
         /* Get the first address. */
         slot = dbe_cache_reach(
@@ -154,6 +186,7 @@ void main(void)
 #include <sspmon.h>
 #include <sstime.h>
 #include <ssmemtrc.h>
+#include <ssatomic.h>
 
 #include <su0rbtr.h>
 #include <su0error.h>
@@ -220,6 +253,30 @@ static char cache_alloc_ctx[] = "CACHE Alloc";
 #define SLOT_REACH_HISTORY
 #endif
 
+/* Shared read-only slots can be pinned without the hash bucket mutex.
+ * Debug builds keep reach bookkeeping in the slot that needs the mutex,
+ * so the optimistic path is used only in product builds.
+ */
+#if defined(SS_MT) && defined(SS_ATOMIC) && !defined(SS_DEBUG) && !defined(SLOT_REACH_HISTORY)
+#define CACHE_OPTIMISTIC_READ
+#endif
+
+#ifdef CACHE_OPTIMISTIC_READ
+
+#define CACHE_OPTREAD_MAXCHAIN  8   /* Max hash chain steps without mutex. */
+
+#define SLOT_INUSE_INC(s)       SsAtomicIntInc(&(s)->slot_inuse)
+#define SLOT_INUSE_DEC(s)       SsAtomicIntDec(&(s)->slot_inuse)
+#define SLOT_SETRMODE(s, m)     { (s)->slot_rmode = (m); SsMemoryBarrier(); }
+
+#else /* CACHE_OPTIMISTIC_READ */
+
+#define SLOT_INUSE_INC(s)       (++(s)->slot_inuse)
+#define SLOT_INUSE_DEC(s)       (--(s)->slot_inuse)
+#define SLOT_SETRMODE(s, m)     (s)->slot_rmode = (m)
+
+#endif /* CACHE_OPTIMISTIC_READ */
+
 #ifdef SLOT_QUEUE
 
 typedef struct cache_slotqticket_st cache_slotqticket_t;
@@ -362,6 +419,10 @@ struct dbe_cacheslot_st {
         dbe_cache_t*          slot_cache;
         int                   slot_lruindex; /* LRU index for this slot */
         lrulist_t*            slot_lrulist;
+        SsTimeT               slot_loadtime; /* Time in ms when read from
+                                                disk, zero after probation */
+        bool                  slot_prefetched; /* Flag: read by prefetch and
+                                                  not yet reached */
         ss_debug(FOUR_BYTE_T  slot_crc;)
         ss_debug(char*        slot_debug[CACHE_MAXSLOTCTX];)
         ss_debug(char**       slot_callstack;)
@@ -385,6 +446,8 @@ struct dbe_cacheslot_st {
 typedef struct {
         SsMutexT*           hb_mutex;
         dbe_cacheslot_t*    hb_slot;
+        volatile uint       hb_seq;     /* Incremented on every chain change,
+                                           validates optimistic reads. */
 } hashbucket_t;
 
 /* Hash structure used to search blocks.
@@ -404,7 +467,8 @@ FOUR_BYTE_T cache_crc_array[CACHE_CRC_ARRAY_SIZE];
 /* ** PLRU START ** */
 
 /* PLRU constants */
-#define PLRU_NLRU           16
+#define PLRU_DEFAULTNLRU    16
+#define PLRU_MAXNLRU        DBE_CACHE_MAXLRU
 
 /* Priority LRU (PLRU) structure */
 
@@ -486,6 +550,7 @@ SS_INLINE size_t lrulist_nslots(lrulist_t* ll)
 typedef enum {
     PLRU_CLASS_NORMAL,
     PLRU_CLASS_LASTUSE,
+    PLRU_CLASS_PROBATION,
     PLRU_CLASS_IGNORE
 } plru_class_t;
 
@@ -503,6 +568,12 @@ typedef struct {
 
         size_t            pl_nslots; /* original # of slots */
         int               pl_lruindex;
+        long              pl_nreplace; /* # of victims taken */
+        long              pl_nsteal;   /* # of victims taken for pages
+                                          of another partition */
+        long              pl_nprobation; /* # of inserts to probation */
+        long              pl_npromote; /* # of pages promoted from
+                                          probation */
         ss_debug(SsMutexT*  pl_mutex;)
 } plru_t;
 
@@ -517,6 +588,10 @@ static void plru_initbuf(plru_t* plru, int lruindex)
         plru->pl_victimarea_minsize = 0;
         plru->pl_nslots = 0;
         plru->pl_lruindex = lruindex;
+        plru->pl_nreplace = 0;
+        plru->pl_nsteal = 0;
+        plru->pl_nprobation = 0;
+        plru->pl_npromote = 0;
 }
 
 static void plru_donebuf(plru_t* plru)
@@ -615,6 +690,10 @@ static void plru_insert(
             case PLRU_CLASS_LASTUSE:
                 lrulist_insertfirst(&plru->pl_lrulist2, slot);
                 break;
+            case PLRU_CLASS_PROBATION:
+                lrulist_insertfirst(&plru->pl_lrulist2, slot);
+                plru->pl_nprobation++;
+                break;
             default:
                 ss_rc_derror(class);
                 /* FALLTHROUGH, not reached */
@@ -747,7 +826,8 @@ struct dbe_cache_st {
         int                 cac_nslot;      /* Number of cache slots. */
         size_t              cac_blocksize;  /* Memory block size. */
         su_svfil_t*         cac_svfil;      /* Cache file. */
-        SsFlatMutexT        cac_lrumutex[PLRU_NLRU];
+        uint                cac_nlru;       /* Number of LRU partitions. */
+        SsFlatMutexT        cac_lrumutex[PLRU_MAXNLRU];
 
 #ifdef SS_MT
         uint                cac_npagemtx;
@@ -764,7 +844,7 @@ struct dbe_cache_st {
         SsSemT*             cac_slotwaitmutex;
 
 #endif
-        plru_t              cac_plru[PLRU_NLRU];
+        plru_t              cac_plru[PLRU_MAXNLRU];
         cache_hash_t        cac_hash;       /* Hash table. */
         dbe_cache_info_t    cac_info;       /* Cache info storage. */
 
@@ -792,6 +872,9 @@ struct dbe_cache_st {
         uint                cac_cleanpagesearchlimit;
 #endif /* 0 */
         uint                cac_extpreflushreq; /* External preflush req count. */
+        dbe_cache_policy_t  cac_policy;     /* Replacement policy. */
+        long                cac_probationtime; /* Midpoint insertion probation
+                                                  time in ms. */
         bool                cac_readonly;
         ss_profile(SsSemDbgT* cac_semdbg_meswait;)
         ss_profile(SsSemDbgT* cac_semdbg_retry;)
@@ -800,6 +883,9 @@ struct dbe_cache_st {
 #define HASH_INDEX(hash, daddr) (uint)((daddr) % (hash)->h_tablesize)
 #define HASH_BUCKET(hash, daddr) (&(hash)->h_table[HASH_INDEX(hash, daddr)])
 
+/* Home LRU partition of a disk address. */
+#define CACHE_LRUINDEX(cache, daddr) (int)((daddr) % (cache)->cac_nlru)
+
 extern bool dbefile_diskless; /* for diskless, no physical dbfile */
 
 static volatile uint cache_lruindex;
@@ -813,6 +899,7 @@ static void cache_preflush(
 
 static dbe_cacheslot_t* cache_selectslot_enterlrumutex(
         dbe_cache_t* cache,
+        su_daddr_t daddr,
         bool lrulimit,
         int* p_lruindex,
         bool* p_preflushflag);
@@ -870,6 +957,8 @@ char* dbe_cache_reachmodetostr(dbe_cache_reachmode_t mode)
                 return("DBE_CACHE_READWRITE_IFHIT");
             case DBE_CACHE_PREFETCH:
                 return("DBE_CACHE_PREFETCH");
+            case DBE_CACHE_PREFETCHBATCH:
+                return("DBE_CACHE_PREFETCHBATCH");
             default:
                 ss_derror;
                 return("ERROR!");
@@ -1356,6 +1445,10 @@ static void hashbucket_insert(
         hashbucket_t* bucket,
         dbe_cacheslot_t* s)
 {
+        bucket->hb_seq++;
+#ifdef CACHE_OPTIMISTIC_READ
+        SsMemoryBarrier();
+#endif
         /* put new slot to the head of the chain */
         s->slot_hashnext = bucket->hb_slot;
         bucket->hb_slot = s;
@@ -1399,6 +1492,10 @@ static void hashbucket_remove(
 
         ss_dassert(slot != NULL);
 
+        bucket->hb_seq++;
+#ifdef CACHE_OPTIMISTIC_READ
+        SsMemoryBarrier();
+#endif
         cur_slot = bucket->hb_slot;
         ss_dassert(cur_slot != NULL);
 
@@ -1654,6 +1751,67 @@ static void slot_dowrite(
         s->slot_oldvers = FALSE;
 }
 
+/*#**********************************************************************\
+ *
+ *		slot_readdone
+ *
+ * Updates slot state and read statistics after slot data has been
+ * read from the disk.
+ *
+ * Parameters :
+ *
+ *	cache - in, use
+ *		cache pointer
+ *
+ *	s - in out, use
+ *		slot into which the data was read
+ *
+ *	daddr - in
+ *		disk block number of data
+ *
+ *	infoflags - in
+ *		info flags of the read
+ *
+ * Return value :
+ *
+ * Limitations  :
+ *
+ * Globals used :
+ */
+static void slot_readdone(
+        dbe_cache_t* cache,
+        dbe_cacheslot_t* s,
+        su_daddr_t daddr __attribute__ ((unused)),
+        dbe_info_flags_t infoflags)
+{
+#ifdef CACHE_CRC_CHECK
+    FOUR_BYTE_T crc;
+#endif /* CACHE_CRC_CHECK */
+
+        s->slot_oldvers = FALSE;
+        s->slot_dirty = FALSE;
+
+        /* NOTE! The following line is not reentrant, but who cares? */
+        cache->cac_info.cachei_nread++;
+        if (infoflags & DBE_INFO_MERGE) {
+            SS_PMON_ADD(SS_PMON_MERGEFILEREAD);
+        }
+        if (infoflags & DBE_INFO_CHECKPOINT) {
+            SS_PMON_ADD(SS_PMON_CHECKPOINTFILEREAD);
+        }
+#ifdef CACHE_CRC_CHECK
+    crc = 0;
+    su_crc32(s->slot_data, cache->cac_blocksize, &crc);
+    if ((daddr < CACHE_CRC_ARRAY_SIZE) && cache_crc_array[daddr] && (cache_crc_array[daddr] != crc)) {
+      printf("cache crc error, crc: %ld, cache_crc_array[daddr]: %ld, (daddr: %ld)\n", crc, cache_crc_array[daddr], daddr);
+    } else {
+      printf("crc ok\n");
+    }
+#endif /* CACHE_CRC_CHECK */
+        crc_debug(s->slot_crc = 0L);
+        crc_debug(su_crc32(s->slot_data, cache->cac_blocksize, &s->slot_crc));
+}
+
 /*#**********************************************************************\
  *
  *		slot_doread
@@ -1692,9 +1850,6 @@ static void slot_doread(
         su_ret_t rc;
         size_t sizeread;
         su_profile_timer;
-#ifdef CACHE_CRC_CHECK
-    FOUR_BYTE_T crc;
-#endif /* CACHE_CRC_CHECK */
 
         ss_dprintf_2(("slot_doread:daddr = %ld, file size = %ld\n",
             (long)daddr, (long)su_svf_getsize(cache->cac_svfil)));
@@ -1708,6 +1863,7 @@ static void slot_doread(
         if (prefetch) {
             cache->cac_info.cachei_nprefetch++;
         }
+        s->slot_prefetched = prefetch;
 
         if (!dbefile_diskless) {
            rc = su_svf_read(
@@ -1740,28 +1896,8 @@ static void slot_doread(
 
         ss_dprintf_2(("slot_doread:done, blocktype = %d, dataptr = %ld\n", (int)*(dbe_blocktype_t*)(s->slot_data), (long)s->slot_data));
 
-        s->slot_oldvers = FALSE;
-        s->slot_dirty = FALSE;
+        slot_readdone(cache, s, daddr, infoflags);
 
-        /* NOTE! The following line is not reentrant, but who cares? */
-        cache->cac_info.cachei_nread++;
-        if (infoflags & DBE_INFO_MERGE) {
-            SS_PMON_ADD(SS_PMON_MERGEFILEREAD);
-        }
-        if (infoflags & DBE_INFO_CHECKPOINT) {
-            SS_PMON_ADD(SS_PMON_CHECKPOINTFILEREAD);
-        }
-#ifdef CACHE_CRC_CHECK
-    crc = 0;
-    su_crc32(s->slot_data, cache->cac_blocksize, &crc);
-    if ((daddr < CACHE_CRC_ARRAY_SIZE) && cache_crc_array[daddr] && (cache_crc_array[daddr] != crc)) {
-      printf("cache crc error, crc: %ld, cache_crc_array[daddr]: %ld, (daddr: %ld)\n", crc, cache_crc_array[daddr], daddr);
-    } else {
-      printf("crc ok\n");
-    }
-#endif /* CACHE_CRC_CHECK */
-        crc_debug(s->slot_crc = 0L);
-        crc_debug(su_crc32(s->slot_data, cache->cac_blocksize, &s->slot_crc));
         su_profile_stop("slot_doread");
 }
 
@@ -1788,6 +1924,9 @@ static void slot_doread(
  *		max number of semaphores to use for protecting
  *          cache block operations
  *
+ *	nlru - in
+ *		number of LRU partitions, 0 means default
+ *
  * Return value - give :
  *
  *      cache pointer
@@ -1799,7 +1938,8 @@ static void slot_doread(
 dbe_cache_t* dbe_cache_init(
         su_svfil_t* svfil,
         uint nblock,
-        uint nsem)
+        uint nsem,
+        uint nlru)
 {
         uint i;
         dbe_cacheslot_t* s;
@@ -1818,6 +1958,14 @@ dbe_cache_t* dbe_cache_init(
             nsem = nblock;
         }
         ss_dassert(nsem >= 1);
+        if (nlru == 0) {
+            nlru = PLRU_DEFAULTNLRU;
+        } else if (nlru > PLRU_MAXNLRU) {
+            nlru = PLRU_MAXNLRU;
+        }
+        if (nlru > nblock) {
+            nlru = nblock;
+        }
         cache = SsMemAlloc(sizeof(dbe_cache_t));
         ss_dassert(cache != NULL);
 
@@ -1826,8 +1974,9 @@ dbe_cache_t* dbe_cache_init(
         cache->cac_blocksize = su_svf_getblocksize(svfil);
         cache->cac_svfil = svfil;
         cache->cac_readonly = su_svf_isreadonly(svfil);
+        cache->cac_nlru = nlru;
 
-        for (i = 0; i < PLRU_NLRU; i++) {
+        for (i = 0; i < cache->cac_nlru; i++) {
             plru_initbuf(&cache->cac_plru[i], i);
             SsFlatMutexInit(&(cache->cac_lrumutex[i]),
                             SS_SEMNUM_DBE_CACHE_LRU);
@@ -1885,6 +2034,8 @@ dbe_cache_t* dbe_cache_init(
             cache->cac_preflushportion = PREFLUSHPORTION_MAX;
         }
         cache->cac_extpreflushreq = 0;
+        cache->cac_policy = DBE_CACHE_POLICY_LRU;
+        cache->cac_probationtime = 0;
         for (i = 0; i < nblock; i++) {
             s = SsMemAlloc(sizeof(dbe_cacheslot_t));
             ss_dassert(s != NULL);
@@ -1911,8 +2062,10 @@ dbe_cache_t* dbe_cache_init(
             s->slot_hashnext = NULL;
             s->slot_flushctr = cache->cac_flushctr;
             s->slot_cache = cache;
-            s->slot_lruindex = i % PLRU_NLRU;
+            s->slot_lruindex = i % cache->cac_nlru;
             s->slot_lrulist = NULL;
+            s->slot_loadtime = 0;
+            s->slot_prefetched = FALSE;
 #ifdef SLOT_REACH_HISTORY
             memset(s->slot_history, '\0', sizeof(s->slot_history));
             s->slot_historypos = 0;
@@ -1923,16 +2076,17 @@ dbe_cache_t* dbe_cache_init(
             ss_debug(s->slot_callstack = NULL);
             ss_debug(SsFlatMutexLock(cache->cac_lrumutex[s->slot_lruindex]));
             plru_ignore(&cache->cac_plru[s->slot_lruindex], s);
+            cache->cac_plru[s->slot_lruindex].pl_nslots++;
             ss_debug(SsFlatMutexUnlock(cache->cac_lrumutex[s->slot_lruindex]));
         }
         {
             size_t lru_victimarea_minsize;
 
-            lru_victimarea_minsize = cache->cac_preflushportion / PLRU_NLRU;
+            lru_victimarea_minsize = cache->cac_preflushportion / cache->cac_nlru;
             if (lru_victimarea_minsize < 2) {
                 lru_victimarea_minsize = 2;
             }
-            for (i = 0; i < PLRU_NLRU; i++) {
+            for (i = 0; i < cache->cac_nlru; i++) {
                 plru_setvictimarea_minsize(&cache->cac_plru[i],
                                                lru_victimarea_minsize);
             }
@@ -1970,7 +2124,7 @@ void dbe_cache_done(cache)
 
         hash_done(&cache->cac_hash);
 
-        for (i = 0; i < PLRU_NLRU; i++) {
+        for (i = 0; i < cache->cac_nlru; i++) {
             ss_debug(SsFlatMutexLock(cache->cac_lrumutex[i]));
             while ((s = plru_find_victim(&cache->cac_plru[i], FALSE))
                    != NULL)
@@ -1989,7 +2143,7 @@ void dbe_cache_done(cache)
             ss_debug(SsFlatMutexUnlock(cache->cac_lrumutex[i]));
         }
         SsCacMemDone(cache->cac_cacmem);
-        for (i = 0; i < PLRU_NLRU; i++) {
+        for (i = 0; i < cache->cac_nlru; i++) {
             SsFlatMutexDone(cache->cac_lrumutex[i]);
         }
 #ifdef SLOT_QUEUE
@@ -2000,7 +2154,7 @@ void dbe_cache_done(cache)
         if (cache->cac_preflushctx != NULL) {
             SsMemFree(cache->cac_preflushctx);
         }
-        for (i = 0; i < PLRU_NLRU; i++) {
+        for (i = 0; i < cache->cac_nlru; i++) {
             plru_donebuf(&cache->cac_plru[i]);
         }
         if (cache->cac_flushpool != NULL) {
@@ -2184,6 +2338,146 @@ static void cache_retrysleep(uint retries)
         }
 }
 
+#ifdef CACHE_OPTIMISTIC_READ
+
+/*#***********************************************************************\
+ *
+ *		cache_optimistic_unpin
+ *
+ * Decrements the in use counter of a slot without the hash bucket
+ * mutex. Only a transition that leaves the slot still in use is done
+ * here, the last release must go through the mutex protected path
+ * because it links the slot back to the LRU.
+ *
+ * Parameters :
+ *
+ *	slot - in out, use
+ *		cache slot
+ *
+ * Return value :
+ *
+ *      TRUE    - counter decremented
+ *      FALSE   - caller is possibly the last user, use the locked path
+ *
+ * Comments :
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+static bool cache_optimistic_unpin(dbe_cacheslot_t* slot)
+{
+        int inuse;
+
+        for (;;) {
+            inuse = *(volatile int*)&slot->slot_inuse;
+            if (inuse < 2) {
+                return (FALSE);
+            }
+            if (SsAtomicIntCas(&slot->slot_inuse, inuse, inuse - 1)) {
+                return (TRUE);
+            }
+        }
+}
+
+/*#***********************************************************************\
+ *
+ *		cache_optimistic_reach
+ *
+ * Tries to reach a slot in read-only mode without locking the hash
+ * bucket. Succeeds only if the slot is already shared by other
+ * read-only users, so the in use counter never goes from zero to one
+ * here and the slot need not be removed from the LRU.
+ *
+ * The hash chain is traversed without the mutex. Slots are never freed
+ * while the cache exists, so a stale chain pointer only leads to a
+ * wrong slot, which is detected by validating the slot state and the
+ * bucket sequence number after the slot is pinned.
+ *
+ * Parameters :
+ *
+ *	cache - in out, use
+ *		cache pointer
+ *
+ *	bucket - in, use
+ *		hash bucket of daddr
+ *
+ *	daddr - in
+ *		disk block address
+ *
+ * Return value - ref :
+ *
+ *      pointer to pinned slot, or
+ *      NULL if the locked path must be used
+ *
+ * Comments :
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+static dbe_cacheslot_t* cache_optimistic_reach(
+        dbe_cache_t* cache,
+        hashbucket_t* bucket,
+        su_daddr_t daddr)
+{
+        dbe_cacheslot_t* slot;
+        uint seq;
+        uint nstep;
+        int inuse;
+
+        seq = bucket->hb_seq;
+        SsMemoryBarrier();
+
+        slot = *(dbe_cacheslot_t* volatile*)&bucket->hb_slot;
+        for (nstep = 0; ; nstep++) {
+            if (slot == NULL || nstep == CACHE_OPTREAD_MAXCHAIN) {
+                return (NULL);
+            }
+            if (*(volatile su_daddr_t*)&slot->slot_daddr == daddr) {
+                break;
+            }
+            slot = *(dbe_cacheslot_t* volatile*)&slot->slot_hashnext;
+        }
+
+        /* Pin the slot if it is shared by readers. */
+        for (;;) {
+            inuse = *(volatile int*)&slot->slot_inuse;
+            if (inuse < 1
+                || *(volatile dbe_cache_reachmode_t*)&slot->slot_rmode
+                   != DBE_CACHE_READONLY
+                || *(volatile bool*)&slot->slot_oldvers
+                || *(volatile bool*)&slot->slot_prefetched)
+            {
+                return (NULL);
+            }
+            if (SsAtomicIntCas(&slot->slot_inuse, inuse, inuse + 1)) {
+                break;
+            }
+        }
+
+        /* Validate that the pinned slot is still the current read-only
+         * version of daddr and nobody waits for exclusive access.
+         */
+        if (bucket->hb_seq == seq
+            && slot->slot_daddr == daddr
+            && slot->slot_rmode == DBE_CACHE_READONLY
+            && !slot->slot_oldvers
+#ifdef SLOT_QUEUE
+            && slot->slot_queue.sq_first == NULL
+#endif
+            )
+        {
+            return (slot);
+        }
+        if (!cache_optimistic_unpin(slot)) {
+            dbe_cache_release(cache, slot, DBE_CACHE_CLEAN, NULL);
+        }
+        return (NULL);
+}
+
+#endif /* CACHE_OPTIMISTIC_READ */
+
 /*##**********************************************************************\
  *
  *		dbe_cache_reachwithhitinfo
@@ -2233,6 +2527,7 @@ dbe_cacheslot_t* dbe_cache_reachwithhitinfo(
         bool succp;
         bool preflushflag = FALSE;
         bool prefetch;
+        bool batchread = FALSE;
         uint retries;
         int coming_from_slotwait = 0;
 #ifdef SLOT_REACH_HISTORY
@@ -2255,9 +2550,43 @@ dbe_cacheslot_t* dbe_cache_reachwithhitinfo(
                 prefetch = TRUE;
                 mode = DBE_CACHE_READONLY;
                 break;
+            case DBE_CACHE_PREFETCHBATCH:
+                /* Slot is held exclusively until the caller has read
+                 * the data, so other accessors wait for it.
+                 */
+                ss_dassert(daddr != SU_DADDR_NULL);
+                prefetch = TRUE;
+                batchread = TRUE;
+                mode = DBE_CACHE_READWRITE;
+                break;
             default:
                 break;
         }
+#ifdef CACHE_OPTIMISTIC_READ
+        if ((mode == DBE_CACHE_READONLY || mode == DBE_CACHE_READONLY_IFHIT)
+            && !prefetch
+            && daddr != SU_DADDR_NULL)
+        {
+            slot = cache_optimistic_reach(
+                        cache,
+                        HASH_BUCKET(&cache->cac_hash, daddr),
+                        daddr);
+            if (slot != NULL) {
+                /* NOTE! Counters are updated without the mutex, so they
+                 * are approximate. They are used only for statistics.
+                 */
+                cache->cac_info.cachei_nfind++;
+                cache->cac_info.cachei_noptread++;
+                *p_hit = TRUE;
+                if (p_data != NULL) {
+                    *p_data = slot->slot_data;
+                }
+                ss_dprintf_2(("dbe_cache_reach:optimistic hit\n"));
+                SS_POPNAME;
+                return (slot);
+            }
+        }
+#endif /* CACHE_OPTIMISTIC_READ */
         for (retries = 0;;) {
             bucket1 = NULL;
             bucket2 = NULL;
@@ -2297,7 +2626,7 @@ dbe_cacheslot_t* dbe_cache_reachwithhitinfo(
                         break;
                 }
                 /* Select a victim slot from LRU */
-                slot = cache_selectslot_enterlrumutex(cache, TRUE, &lruindex, &preflushflag);
+                slot = cache_selectslot_enterlrumutex(cache, daddr, TRUE, &lruindex, &preflushflag);
                 if (slot == NULL) {
                     cache_outofslots(cache);
                 }
@@ -2359,6 +2688,11 @@ dbe_cacheslot_t* dbe_cache_reachwithhitinfo(
                         continue;   /* retry! */
                     }
 #endif /* DBE_NONBLOCKING_PAGEFLUSH */
+                    if (slot->slot_prefetched) {
+                        /* Prefetched page was never used. */
+                        cache->cac_info.cachei_nprefetchwasted++;
+                        SS_PMON_ADD(SS_PMON_CACHEPREFETCHWASTED);
+                    }
                     hashbucket_remove(bucket2, slot);
                     CACHE_LRUUNLOCK();
                     SsFlatMutexUnlock(cache->cac_lrumutex[lruindex]);
@@ -2395,16 +2729,32 @@ dbe_cacheslot_t* dbe_cache_reachwithhitinfo(
                 }
                 slot->slot_daddr = daddr;
                 ss_dassert(!slot->slot_dirty);
+                if (cache->cac_policy == DBE_CACHE_POLICY_MIDPOINT
+                    && daddr != SU_DADDR_NULL
+                    && mode != DBE_CACHE_WRITEONLY)
+                {
+                    /* Page read from disk starts in probation. */
+                    slot->slot_loadtime = SsTimeMs();
+                } else {
+                    slot->slot_loadtime = 0;
+                }
+                slot->slot_prefetched = batchread;
                 if (daddr != SU_DADDR_NULL) {
                     /* Insert the recycled slot to new hash position */
                     hashbucket_insert(bucket1, slot);
-                    if (mode != DBE_CACHE_WRITEONLY) {
+                    if (batchread) {
+                        /* caller reads contents from disk */
+                        slot->slot_level = -1;
+                        slot->slot_whichtree = -1;
+                        slot->slot_oldvers = FALSE;
+                    } else if (mode != DBE_CACHE_WRITEONLY) {
                         /* read contents from disk */
                         slot_doread(cache, slot, daddr, prefetch, infoflags);
                     }
                 }
                 ss_dprintf_2(("dbe_cache_reach:set slot->slot_inuse=1\n"));
                 ss_dassert(slot->slot_lrulist == NULL);
+                SLOT_SETRMODE(slot, mode);
                 slot->slot_inuse = 1;
                 SET_SLOT_HISTORY(orig_mode, -1);
                 SET_SLOT_RETRY;
@@ -2414,6 +2764,25 @@ dbe_cacheslot_t* dbe_cache_reachwithhitinfo(
                 SET_SLOT_HISTORY(orig_mode, -1);
                 SET_SLOT_RETRY;
                 *p_hit = TRUE;
+                if (batchread) {
+                    /* Nothing to prefetch. */
+                    hashbucket_unlock(bucket1);
+                    if (p_data != NULL) {
+                        *p_data = NULL;
+                    }
+                    ss_dprintf_2(("dbe_cache_reach:return NULL\n"));
+                    SS_POPNAME;
+                    return (NULL);
+                }
+                if (slot->slot_prefetched
+                    && !prefetch
+                    && mode != DBE_CACHE_PREFLUSHREACH)
+                {
+                    /* First reach of a prefetched page. */
+                    slot->slot_prefetched = FALSE;
+                    cache->cac_info.cachei_nprefetchused++;
+                    SS_PMON_ADD(SS_PMON_CACHEPREFETCHUSED);
+                }
                 switch (mode) {
                     case DBE_CACHE_READONLY_IFHIT:
                         mode = DBE_CACHE_READONLY;
@@ -2535,7 +2904,7 @@ dbe_cacheslot_t* dbe_cache_reachwithhitinfo(
                          * slot (slot replication)
                          */
                         dbe_cacheslot_t* copy_slot;
-                        copy_slot = cache_selectslot_enterlrumutex(cache, TRUE, &lruindex, &preflushflag);
+                        copy_slot = cache_selectslot_enterlrumutex(cache, daddr, TRUE, &lruindex, &preflushflag);
                         if (copy_slot == NULL) {
                             cache_outofslots(cache);
                         }
@@ -2597,6 +2966,10 @@ dbe_cacheslot_t* dbe_cache_reachwithhitinfo(
                                 continue;   /* retry! */
                             }
 #endif /* DBE_NONBLOCKING_PAGEFLUSH */
+                            if (copy_slot->slot_prefetched) {
+                                cache->cac_info.cachei_nprefetchwasted++;
+                                SS_PMON_ADD(SS_PMON_CACHEPREFETCHWASTED);
+                            }
                             hashbucket_remove(bucket2, copy_slot);
                             CACHE_LRUUNLOCK();
                             SsFlatMutexUnlock(cache->cac_lrumutex[lruindex]);
@@ -2633,10 +3006,14 @@ dbe_cacheslot_t* dbe_cache_reachwithhitinfo(
                             });
                         copy_slot->slot_dirty = slot->slot_dirty;
                         copy_slot->slot_flushctr = slot->slot_flushctr;
+                        /* Page is concurrently used, no probation. */
+                        copy_slot->slot_loadtime = 0;
+                        copy_slot->slot_prefetched = FALSE;
                         crc_debug(copy_slot->slot_crc = slot->slot_crc;)
                         ss_dassert(copy_slot->slot_inuse == 0);
                         ss_dprintf_2(("dbe_cache_reach:set slot->slot_inuse=1\n"));
                         ss_dassert(slot->slot_lrulist == NULL);
+                        SLOT_SETRMODE(copy_slot, mode);
                         copy_slot->slot_inuse = 1;
                         if (mode != DBE_CACHE_WRITEONLY) {
                             memcpy(copy_slot->slot_data, slot->slot_data, cache->cac_blocksize);
@@ -2670,7 +3047,7 @@ dbe_cacheslot_t* dbe_cache_reachwithhitinfo(
                     } else {
                         /* Read only access allows sharing! */
                         ss_dassert(slot->slot_lrulist == NULL);
-                        slot->slot_inuse++;
+                        SLOT_INUSE_INC(slot);
                         ss_dprintf_2(("dbe_cache_reach:set slot->slot_inuse++=%d\n", slot->slot_inuse));
                     }
                 } else {
@@ -2699,7 +3076,8 @@ dbe_cacheslot_t* dbe_cache_reachwithhitinfo(
                     CACHE_LRUUNLOCK();
                     SsFlatMutexUnlock(cache->cac_lrumutex[lruindex]);
                     ss_dassert(slot->slot_lrulist == NULL);
-                    slot->slot_inuse++;
+                    SLOT_SETRMODE(slot, mode);
+                    SLOT_INUSE_INC(slot);
                     ss_dprintf_2(("dbe_cache_reach:set slot->slot_inuse++=%d\n", slot->slot_inuse));
                 }
                 if (mode == DBE_CACHE_WRITEONLY
@@ -2803,8 +3181,10 @@ dbe_cacheslot_t* dbe_cache_reachwithhitinfo(
                 (*cache->cac_preflushcallback)(
                     cache->cac_preflushctx);
             }
-            ss_dprintf_2(("dbe_cache_reach:return slot, blocktype = %d, dataptr = %ld\n", (int)*(dbe_blocktype_t*)(slot->slot_data), (long)slot->slot_data));
-            CHK_SLOT(slot, prefetch);
+            if (!batchread) {
+                ss_dprintf_2(("dbe_cache_reach:return slot, blocktype = %d, dataptr = %ld\n", (int)*(dbe_blocktype_t*)(slot->slot_data), (long)slot->slot_data));
+                CHK_SLOT(slot, prefetch);
+            }
 #ifdef SS_DEBUG
             if (dbefile_diskless) {
                 crc_debug(slot->slot_crc = 0L;
@@ -2949,6 +3329,17 @@ void dbe_cache_release(
             (int)*(dbe_blocktype_t*)(slot->slot_data), (long)slot->slot_data, slot->slot_inuse));
 
         ss_dassert(slot->slot_inuse > 0);
+#ifdef CACHE_OPTIMISTIC_READ
+        if (slot->slot_rmode == DBE_CACHE_READONLY
+            && (mode == DBE_CACHE_CLEAN || mode == DBE_CACHE_CLEANLASTUSE)
+            && cache_optimistic_unpin(slot))
+        {
+            /* Other readers still hold the slot. */
+            SS_POPNAME;
+            ss_dprintf_2(("dbe_cache_release:return0\n"));
+            return;
+        }
+#endif /* CACHE_OPTIMISTIC_READ */
         if (slot->slot_daddr != SU_DADDR_NULL) {
             bucket = HASH_BUCKET(&cache->cac_hash, slot->slot_daddr);
             CACHE_LOCK(slot->slot_daddr, bucket);
@@ -2956,7 +3347,7 @@ void dbe_cache_release(
             CACHE_LOCKED(slot->slot_daddr, bucket);
             SET_SLOT_HISTORY(-1, mode);
             ss_debug(cacheslot_removectx(slot, ctx));
-            slot->slot_inuse--;
+            SLOT_INUSE_DEC(slot);
             ss_dprintf_2(("dbe_cache_release:set slot->slot_inuse--=%d\n", slot->slot_inuse));
             if (slot->slot_oldvers) {
                 if (slot->slot_inuse == 0) {
@@ -3039,7 +3430,7 @@ void dbe_cache_release(
             }
         } else {
             ss_debug(cacheslot_removectx(slot, ctx));
-            slot->slot_inuse--;
+            SLOT_INUSE_DEC(slot);
             ss_dprintf_2(("dbe_cache_release:set slot->slot_inuse--=%d\n", slot->slot_inuse));
             ss_dassert(slot->slot_inuse == 0);
             ignore = TRUE;
@@ -3083,6 +3474,7 @@ void dbe_cache_release(
         CHK_SLOT(slot, FALSE);
         if (slot->slot_inuse == 0) {
             plru_class_t pclass;
+            bool promote = FALSE;
 
 #ifdef SLOT_QUEUE
             if (slot->slot_oldvers) {
@@ -3118,10 +3510,24 @@ void dbe_cache_release(
                 default:
                     ss_rc_error(mode);
             }
+            if (slot->slot_loadtime != 0 && pclass == PLRU_CLASS_NORMAL) {
+                /* Midpoint insertion: slot is still in probation. */
+                if (SsTimeMs() - slot->slot_loadtime
+                    < (SsTimeT)cache->cac_probationtime)
+                {
+                    pclass = PLRU_CLASS_PROBATION;
+                } else {
+                    slot->slot_loadtime = 0;
+                    promote = TRUE;
+                }
+            }
             lruindex = slot->slot_lruindex;
             CACHE_LRULOCK();
             SsFlatMutexLock(cache->cac_lrumutex[lruindex]);
             CACHE_LRULOCKED();
+            if (promote) {
+                cache->cac_plru[lruindex].pl_npromote++;
+            }
             plru_insert(&cache->cac_plru[lruindex], slot, pclass);
             CACHE_LRUUNLOCK();
             SsFlatMutexUnlock(cache->cac_lrumutex[lruindex]);
@@ -3721,6 +4127,27 @@ static void dbe_cache_getinfo_internal(
             cache->cac_info.cachei_avgchain = (double)0.0;
         }
 
+        /* Note: partition counters are read without the LRU mutexes,
+         * slight inexactness is allowed.
+         */
+        cache->cac_info.cachei_policy = cache->cac_policy;
+        cache->cac_info.cachei_nprobation = 0;
+        cache->cac_info.cachei_npromote = 0;
+        cache->cac_info.cachei_nlru = cache->cac_nlru;
+        for (i = 0; i < cache->cac_nlru; i++) {
+            plru_t* plru;
+            dbe_cache_lruinfo_t* lruinfo;
+
+            plru = &cache->cac_plru[i];
+            lruinfo = &cache->cac_info.cachei_lruinfo[i];
+            lruinfo->cachelrui_nslot = (long)plru->pl_nslots;
+            lruinfo->cachelrui_ntoflush = (long)plru_ntoflush(plru);
+            lruinfo->cachelrui_nreplace = plru->pl_nreplace;
+            lruinfo->cachelrui_nsteal = plru->pl_nsteal;
+            cache->cac_info.cachei_nprobation += plru->pl_nprobation;
+            cache->cac_info.cachei_npromote += plru->pl_npromote;
+        }
+
         *info = cache->cac_info;
 }
 
@@ -3746,11 +4173,15 @@ static void dbe_cache_getinfo_internal(
 static void cache_info_init(dbe_cache_info_t* info)
 {
         info->cachei_nfind = 0;
+        info->cachei_noptread = 0;
         info->cachei_nread = 0;
         info->cachei_nwrite = 0;
         info->cachei_nprefetch = 0;
+        info->cachei_nprefetchused = 0;
+        info->cachei_nprefetchwasted = 0;
         info->cachei_npreflush = 0;
         info->cachei_ndirtyrelease = 0;
+        info->cachei_nlru = 0;
 }
 
 /*##**********************************************************************\
@@ -4704,6 +5135,115 @@ void dbe_cache_flushaddr_n(
         }
         su_profile_stop("dbe_cache_flushaddr_n");
 }
+
+/*##**********************************************************************\
+ *
+ *		dbe_cache_prefetch_n
+ *
+ * Reads a batch of pages into the cache. Pages that are already in
+ * the cache are skipped. Slots for the missing pages are reserved
+ * first and then all of them are read with a single list I/O request,
+ * so that the reads can proceed in parallel in the device.
+ *
+ * Parameters :
+ *
+ *	cache - in out, use
+ *		cache pointer
+ *
+ *	addrs - in
+ *		page addresses
+ *
+ *	naddrs - in
+ *		number of addresses, at most DBE_CACHE_MAXNFLUSHES
+ *
+ *	infoflags - in
+ *		info flags of the reads
+ *
+ * Return value :
+ *
+ * Comments :
+ *
+ *      A failed read is not an error here, the slot is discarded and
+ *      the page is read again when it is really needed.
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+void dbe_cache_prefetch_n(
+        dbe_cache_t*            cache,
+        su_daddr_t*             addrs,
+        ulong                   naddrs,
+        dbe_info_flags_t        infoflags)
+{
+        dbe_cacheslot_t*        s;
+        su_svf_lioreq_t         ioreq[DBE_CACHE_MAXNFLUSHES];
+        dbe_cacheslot_t*        slots[DBE_CACHE_MAXNFLUSHES];
+        char*                   data;
+        ulong                   i;
+        ulong                   j;
+        su_profile_timer;
+
+        ss_dassert(cache != NULL);
+        ss_dassert(cache->cac_check == DBE_CHK_CACHE);
+        ss_dassert(naddrs <= DBE_CACHE_MAXNFLUSHES);
+
+        if (dbefile_diskless) {
+            for (i = 0; i < naddrs; i++) {
+                s = dbe_cache_reach(
+                        cache,
+                        addrs[i],
+                        DBE_CACHE_PREFETCH,
+                        infoflags,
+                        NULL,
+                        NULL);
+                dbe_cache_release(cache, s, DBE_CACHE_CLEAN, NULL);
+            }
+            return;
+        }
+
+        su_profile_start;
+
+        for (i = 0, j = 0; i < naddrs; i++) {
+            s = dbe_cache_reach(
+                    cache,
+                    addrs[i],
+                    DBE_CACHE_PREFETCHBATCH,
+                    infoflags,
+                    &data,
+                    NULL);
+            if (s == NULL) {
+                /* already in cache */
+                continue;
+            }
+            ioreq[j].lr_reqtype = SS_LIO_READ;
+            ioreq[j].lr_daddr = addrs[i];
+            ioreq[j].lr_data = data;
+            ioreq[j].lr_size = cache->cac_blocksize;
+            ioreq[j].lr_rc = SU_SUCCESS;
+            slots[j] = s;
+            j++;
+        }
+        if (j > 0) {
+            su_svf_listio(cache->cac_svfil, ioreq, j);
+        }
+        for (i = 0; i < j; i++) {
+            s = slots[i];
+            if (ioreq[i].lr_rc == SU_SUCCESS) {
+                ss_bprintf_2(("dbe_cache_prefetch_n:addr=%ld\n",
+                              (long)ioreq[i].lr_daddr));
+                cache->cac_info.cachei_nprefetch++;
+                slot_readdone(cache, s, ioreq[i].lr_daddr, infoflags);
+                CHK_SLOT(s, TRUE);
+                dbe_cache_release(cache, s, DBE_CACHE_CLEAN, NULL);
+            } else {
+                ss_dprintf_1(("dbe_cache_prefetch_n:addr=%ld, rc=%d\n",
+                              (long)ioreq[i].lr_daddr, ioreq[i].lr_rc));
+                dbe_cache_release(cache, s, DBE_CACHE_IGNORE, NULL);
+            }
+        }
+        su_profile_stop("dbe_cache_prefetch_n");
+}
 #endif /* MME_CP_FIX */
 
 #endif /* DBE_MTFLUSH */
@@ -4972,8 +5512,8 @@ static void cache_preflush(
             max_k = 1;
         }
         lrustart = cache_lruindex++;
-        for (lruloop = 0; lruloop < PLRU_NLRU; lruloop++) {
-            lruindex = (lrustart + lruloop) % PLRU_NLRU;
+        for (lruloop = 0; lruloop < (int)cache->cac_nlru; lruloop++) {
+            lruindex = (lrustart + lruloop) % cache->cac_nlru;
             plru = cache->cac_plru[lruindex];
             for (i = PLRU_NCLASS - 1; i >= 0; i--) {
                 slot = plru->pl_head[i]->slot_.prev;
@@ -4997,7 +5537,7 @@ static void cache_preflush(
                         ss_dassert(k == max_k);
                         goto loop_exit;
                     }
-                    if (k >= max_k / PLRU_NLRU) {
+                    if (k >= max_k / (int)cache->cac_nlru) {
                         /* Max proportinal part of this LRU reached
                          */
                         goto lru_exit;
@@ -5044,8 +5584,6 @@ void dbe_cache_printinfo(
         void* fp,
         dbe_cache_t* cache)
 {
-        uint nitem;
-        uint ndirty;
         dbe_cache_info_t info;
         int lruindex;
 
@@ -5074,15 +5612,28 @@ void dbe_cache_printinfo(
             info.cachei_nfind,
             info.cachei_nread,
             info.cachei_nwrite);
-
-        for (lruindex = 0; lruindex < PLRU_NLRU; lruindex++) {
-            nitem = 0;
-            ndirty = 0;
-            CACHE_LRULOCK();
-            SsFlatMutexLock(cache->cac_lrumutex[lruindex]);
-            CACHE_LRULOCKED();
-            CACHE_LRUUNLOCK();
-            SsFlatMutexUnlock(cache->cac_lrumutex[lruindex]);
+        SsFprintf(fp, "    Optimistic reads %ld\n", info.cachei_noptread);
+        SsFprintf(fp, "    Prefetch %ld used %ld wasted %ld\n",
+            info.cachei_nprefetch,
+            info.cachei_nprefetchused,
+            info.cachei_nprefetchwasted);
+
+        SsFprintf(fp, "    Policy %s nprobation %ld npromote %ld\n",
+            dbe_cache_policytostr(info.cachei_policy),
+            info.cachei_nprobation,
+            info.cachei_npromote);
+
+        SsFprintf(fp, "    LRU partitions %d\n", info.cachei_nlru);
+        for (lruindex = 0; lruindex < info.cachei_nlru; lruindex++) {
+            dbe_cache_lruinfo_t* lruinfo;
+
+            lruinfo = &info.cachei_lruinfo[lruindex];
+            SsFprintf(fp, "    LRU %2d nslot %ld ntoflush %ld nreplace %ld nsteal %ld\n",
+                lruindex,
+                lruinfo->cachelrui_nslot,
+                lruinfo->cachelrui_ntoflush,
+                lruinfo->cachelrui_nreplace,
+                lruinfo->cachelrui_nsteal);
         }
 }
 #endif /* SS_LIGHT */
@@ -5150,11 +5701,11 @@ bool dbe_cache_setpreflushinfo(
             size_t lru_victimarea_minsize;
             size_t i;
 
-            lru_victimarea_minsize = cache->cac_preflushportion / PLRU_NLRU;
+            lru_victimarea_minsize = cache->cac_preflushportion / cache->cac_nlru;
             if (lru_victimarea_minsize < 2) {
                 lru_victimarea_minsize = 2;
             }
-            for (i = 0; i < PLRU_NLRU; i++) {
+            for (i = 0; i < cache->cac_nlru; i++) {
                 plru_setlastuseskippercent(&cache->cac_plru[i],
                                            lastuseskippercent);
                 plru_setvictimarea_minsize(&cache->cac_plru[i],
@@ -5165,6 +5716,80 @@ bool dbe_cache_setpreflushinfo(
 }
 
 
+/*##**********************************************************************\
+ *
+ *		dbe_cache_setreplacementpolicy
+ *
+ * Sets the page replacement policy of the cache. Should be called
+ * before the cache is used.
+ *
+ * Parameters :
+ *
+ *	cache - in out, use
+ *		pointer to cache object
+ *
+ *	policy - in
+ *		replacement policy
+ *
+ *	probationtime - in
+ *		with DBE_CACHE_POLICY_MIDPOINT, time in milliseconds a page read
+ *          from disk is kept in probation; references during that
+ *          time do not promote the page to high priority LRU
+ *
+ * Return value :
+ *
+ * Comments :
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+void dbe_cache_setreplacementpolicy(
+        dbe_cache_t* cache,
+        dbe_cache_policy_t policy,
+        long probationtime)
+{
+        ss_dassert(cache->cac_check == DBE_CHK_CACHE);
+
+        if (probationtime < 0) {
+            probationtime = 0;
+        }
+        cache->cac_policy = policy;
+        cache->cac_probationtime = probationtime;
+}
+
+/*##**********************************************************************\
+ *
+ *		dbe_cache_policytostr
+ *
+ * Returns string representation of dbe_cache_policy_t.
+ *
+ * Parameters :
+ *
+ *	policy - in
+ *
+ *
+ * Return value - ref:
+ *
+ * Comments :
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+char* dbe_cache_policytostr(dbe_cache_policy_t policy)
+{
+        switch (policy) {
+            case DBE_CACHE_POLICY_LRU:
+                return("LRU");
+            case DBE_CACHE_POLICY_MIDPOINT:
+                return("MIDPOINT");
+            default:
+                ss_derror;
+                return("ERROR!");
+        }
+}
+
 /*##**********************************************************************\
  *
  *		dbe_cache_addpreflushpage
@@ -5238,11 +5863,19 @@ bool dbe_cacheslot_isoldversion(dbe_cacheslot_t* slot)
  * Parameters :
  *
  *	    cache - in out, use
+ *		pointer to cache object
+ *
+ *      daddr - in
+ *          address of the page the slot is needed for, used to select
+ *          the LRU partition where the search is started. If
+ *          SU_DADDR_NULL, partitions are used in round robin order.
  *
  *      lrulimit - in
  *          limit the victim search to clean pages only
  *
- *		pointer to cache object
+ *      p_lruindex - out
+ *          index of the LRU partition where the slot was found, the
+ *          mutex of that partition is left entered
  *
  *      p_preflushflag - out
  *          pointer to boolean variable which indicates need
@@ -5259,6 +5892,7 @@ bool dbe_cacheslot_isoldversion(dbe_cacheslot_t* slot)
  */
 static dbe_cacheslot_t* cache_selectslot_enterlrumutex(
         dbe_cache_t* cache,
+        su_daddr_t daddr,
         bool lrulimit,
         int* p_lruindex,
         bool* p_preflushflag)
@@ -5270,10 +5904,14 @@ static dbe_cacheslot_t* cache_selectslot_enterlrumutex(
         int lruloop;
         size_t ndirty;
 
-        lrustart = cache_lruindex++;
-        for (lruloop = 0; lruloop < PLRU_NLRU; lruloop++) {
+        if (daddr != SU_DADDR_NULL) {
+            lrustart = CACHE_LRUINDEX(cache, daddr);
+        } else {
+            lrustart = cache_lruindex++;
+        }
+        for (lruloop = 0; lruloop < (int)cache->cac_nlru; lruloop++) {
         
-            lruindex = (lrustart + lruloop) % PLRU_NLRU;
+            lruindex = (lrustart + lruloop) % cache->cac_nlru;
             plru = &cache->cac_plru[lruindex];
             CACHE_LRULOCK();
             SsFlatMutexLock(cache->cac_lrumutex[lruindex]);
@@ -5289,6 +5927,7 @@ static dbe_cacheslot_t* cache_selectslot_enterlrumutex(
             ss_bprintf_2(("cache_selectslot: no slot, try recusive call without lrulimit\n"));
             ss_dassert(SsSemThreadIsNotEntered(cache->cac_lrumutex[lruindex]));
             slot = cache_selectslot_enterlrumutex(cache, 
+                                                  daddr,
                                                   FALSE,
                                                   p_lruindex, 
                                                   p_preflushflag);
@@ -5296,9 +5935,13 @@ static dbe_cacheslot_t* cache_selectslot_enterlrumutex(
         goto ret_cleanup;
 victim_slot_found:;
         ss_dassert(slot != NULL);
+        plru->pl_nreplace++;
+        if (lruloop > 0) {
+            plru->pl_nsteal++;
+        }
         *p_preflushflag = FALSE;
         ndirty = 0;
-        for (lruloop = 0; lruloop < PLRU_NLRU; lruloop++) {
+        for (lruloop = 0; lruloop < (int)cache->cac_nlru; lruloop++) {
             /* Note: this is a dirty read from most of the LRU pools!
                It is safe because sligh inexactness is
                allowed.
@@ -5384,8 +6027,8 @@ bool dbe_cache_getpreflusharr(
             SsMemAlloc(preflush_array_size * sizeof(su_daddr_t));
 
         lrustart = cache_lruindex++;
-        for (lruloop = 0; lruloop < PLRU_NLRU; lruloop++) {
-            lruindex = (lrustart + lruloop) % PLRU_NLRU;
+        for (lruloop = 0; lruloop < (int)cache->cac_nlru; lruloop++) {
+            lruindex = (lrustart + lruloop) % cache->cac_nlru;
             plru = &cache->cac_plru[lruindex];
 
             if (plru_ntoflush(plru) != 0) {
@@ -5488,6 +6131,7 @@ void dbe_cache_setpreflushcallback(
 # error Not updated!!!!
 static dbe_cacheslot_t* cache_selectslot_enterlrumutex(
         dbe_cache_t* cache, 
+        su_daddr_t daddr,
         bool lrulimit,
         int* p_lruindex,
         bool* p_preflushflag)
@@ -5499,8 +6143,8 @@ static dbe_cacheslot_t* cache_selectslot_enterlrumutex(
 
         *p_preflushflag = FALSE;
         lrustart = cache_lruindex++;
-        for (lruloop = 0; lruloop < PLRU_NLRU; lruloop++) {
-            lruindex = (lrustart + lruloop) % PLRU_NLRU;
+        for (lruloop = 0; lruloop < (int)cache->cac_nlru; lruloop++) {
+            lruindex = (lrustart + lruloop) % cache->cac_nlru;
             CACHE_LRULOCK();
             SsFlatMutexLock(cache->cac_lrumutex[lruindex]);
             CACHE_LRULOCKED();
@@ -5521,3 +6165,42 @@ int dbe_cache_getnslot(
 {
         return(cache->cac_nslot);
 }
+
+/*##**********************************************************************\
+ *
+ *		dbe_cache_getprefetchinfo
+ *
+ * Returns the number of prefetched pages that were later reached and
+ * the number of prefetched pages that were replaced before they were
+ * reached. The counters are not protected, they are used only as
+ * a hint for read-ahead sizing.
+ *
+ * Parameters :
+ *
+ *	cache - in, use
+ *		cache pointer
+ *
+ *	p_nused - out
+ *		number of used prefetches
+ *
+ *	p_nwasted - out
+ *		number of wasted prefetches
+ *
+ * Return value :
+ *
+ * Comments :
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+void dbe_cache_getprefetchinfo(
+        dbe_cache_t* cache,
+        long* p_nused,
+        long* p_nwasted)
+{
+        ss_dassert(cache->cac_check == DBE_CHK_CACHE);
+
+        *p_nused = cache->cac_info.cachei_nprefetchused;
+        *p_nwasted = cache->cac_info.cachei_nprefetchwasted;
+}
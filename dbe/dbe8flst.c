@@ -154,6 +154,7 @@ main()
 #include <ssstdlib.h>
 #include <ssstring.h>
 #include <ssdebug.h>
+#include <sspmon.h>
 #include <su0bsrch.h>
 #include <su0rbtr.h>
 #include <su0error.h>
@@ -264,6 +265,12 @@ struct dbe_freelist_st {
         long                fl_freeblocks;
         bool                fl_freeblocks_known;
         int                 fl_maxspareblocks;
+        ulong               fl_nnearalloc;  /* # of near allocations */
+        ulong               fl_nfaralloc;   /* # of failed near allocations */
+        ulong               fl_nshrunk;     /* # of blocks cut from file end */
+        bool                fl_truncpending; /* physical file is longer than
+                                            ** fl_filesize after a shrink
+                                            */
         su_ret_t            fl_rc;
         dbe_db_t*           fl_db;
 
@@ -798,6 +805,10 @@ dbe_freelist_t *dbe_fl_init(p_svfile, p_cache, superblock_disk_addr,
         p_fl->fl_freeblocks = 0L;
         p_fl->fl_freeblocks_known = FALSE;
         p_fl->fl_maxspareblocks = 0;
+        p_fl->fl_nnearalloc = 0;
+        p_fl->fl_nfaralloc = 0;
+        p_fl->fl_nshrunk = 0;
+        p_fl->fl_truncpending = FALSE;
         p_fl->fl_rc = SU_SUCCESS;
         p_fl->fl_db = db;
 
@@ -1028,6 +1039,428 @@ su_ret_t dbe_fl_alloc(
         return (rc);
 }
 
+/*#***********************************************************************\
+ * 
+ *		fl_extract_near
+ * 
+ * Extracts a free block address that is above the given address and at
+ * most fl_extendincr blocks away from it.
+ * 
+ * Parameters : 
+ * 
+ *	p_fl - in out, use
+ *		pointer to freelist object
+ *
+ *	near_daddr - in
+ *		address near which the block is searched
+ *
+ * Return value :
+ *          extracted free block disk address or SU_DADDR_NULL if
+ *          there is no free block near the given address
+ * 
+ * Limitations  : Called inside fl_mutex
+ * 
+ * Globals used : none
+ */
+static su_daddr_t fl_extract_near(
+        dbe_freelist_t *p_fl,
+        su_daddr_t near_daddr)
+{
+        su_daddr_t ret;
+        su_daddr_t limit;
+
+        if (p_fl->fl_header.bl_nblocks <= p_fl->fl_maxspareblocks
+        ||  near_daddr + 1 >= p_fl->fl_filesize)
+        {
+            return(SU_DADDR_NULL);
+        }
+        limit = near_daddr + 1 + p_fl->fl_extendincr;
+        if (limit > p_fl->fl_filesize) {
+            limit = p_fl->fl_filesize;
+        }
+        if (p_fl->fl_inmemory) {
+            long pos;
+
+            pos = su_bmap_findnext(p_fl->fl_map, limit, 1, near_daddr + 1);
+            if (pos == SU_BMAPRC_NOTFOUND) {
+                return(SU_DADDR_NULL);
+            }
+            ret = (su_daddr_t)pos;
+            ss_dassert(!p_fl->fl_locked);
+            ss_dassert(SU_BMAP_GET(p_fl->fl_map, ret));
+            SU_BMAP_SET(p_fl->fl_map, ret, 0);
+            p_fl->fl_header.bl_nblocks--;
+        } else {
+            uint lo;
+            uint hi;
+            uint mid;
+
+            /* The table is sorted in descending order, find the first
+             * entry that is not above near_daddr.
+             */
+            lo = 0;
+            hi = p_fl->fl_header.bl_nblocks;
+            while (lo < hi) {
+                mid = lo + (hi - lo) / 2;
+                if (p_fl->fl_addrtable[mid] > near_daddr) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+            if (lo == 0 || p_fl->fl_addrtable[lo - 1] >= limit) {
+                return(SU_DADDR_NULL);
+            }
+            if (!p_fl->fl_modified
+             &&  p_fl->fl_nextcpnum != p_fl->fl_header.bl_cpnum)
+            {
+                dbe_fl_addtochlist(p_fl, p_fl->fl_header.bl_cpnum, p_fl->fl_readfrom);
+            }
+            ret = p_fl->fl_addrtable[lo - 1];
+            memmove(&p_fl->fl_addrtable[lo - 1],
+                    &p_fl->fl_addrtable[lo],
+                    (p_fl->fl_header.bl_nblocks - lo) * sizeof(su_daddr_t));
+            p_fl->fl_header.bl_nblocks--;
+        }
+        p_fl->fl_modified = TRUE;
+        return(ret);
+}
+
+/*##**********************************************************************\
+ * 
+ *		dbe_fl_alloc_near
+ * 
+ * Allocates one disk block close after a given block, for example
+ * a sibling of a new B-tree node, so that blocks which are read in
+ * sequence also lie in sequence on disk. If there is no free block
+ * near the given address the block is allocated like in dbe_fl_alloc.
+ * 
+ * Parameters : 
+ * 
+ *	p_fl - in out, use
+ *		pointer to freelist object
+ *
+ *	near_daddr - in
+ *		address near which the block is allocated
+ *
+ *	p_daddr - out
+ *		pointer to variable holding the obtained block address
+ *
+ *	info - in out, use
+ *		allocation info
+ *
+ * Return value :
+ *          SU_SUCCESS when OK or
+ *          something else on error
+ *          (=return code from failed subroutine)
+ * 
+ * Limitations  : none
+ * 
+ * Globals used : none
+ */
+su_ret_t dbe_fl_alloc_near(
+    dbe_freelist_t *p_fl,
+    su_daddr_t near_daddr,
+    su_daddr_t *p_daddr,
+    dbe_info_t* info)
+{
+        su_list_t *p_deferchlist;
+        su_daddr_t daddr = SU_DADDR_NULL;
+
+        ss_dassert(near_daddr != SU_DADDR_NULL);
+
+        /***** MUTEXBEGIN *****/
+        SsSemEnter(p_fl->fl_mutex);
+        if (p_fl->fl_rc == SU_SUCCESS) {
+            daddr = fl_extract_near(p_fl, near_daddr);
+            if (daddr != SU_DADDR_NULL) {
+                p_fl->fl_freeblocks--;
+                p_fl->fl_nnearalloc++;
+            } else {
+                p_fl->fl_nfaralloc++;
+            }
+        }
+        p_deferchlist = p_fl->fl_deferchlist;
+        p_fl->fl_deferchlist = NULL;
+        SsSemExit(p_fl->fl_mutex);
+        /***** MUTEXEND *******/
+
+        if (p_deferchlist != NULL) {
+            dbe_cl_dochlist(p_fl->fl_chlist, p_deferchlist);
+        }
+        if (daddr == SU_DADDR_NULL) {
+            return(dbe_fl_alloc(p_fl, p_daddr, info));
+        }
+        ss_dprintf_2(("dbe_fl_alloc_near(near=%ld): daddr=%ld\n", near_daddr, daddr));
+        ss_dassert(daddr < su_svf_getsize(p_fl->fl_file));
+        *p_daddr = daddr;
+        return(SU_SUCCESS);
+}
+
+/*##**********************************************************************\
+ * 
+ *		dbe_fl_getfragstat
+ * 
+ * Returns free space fragmentation statistics. Free ranges are counted
+ * only if countranges is TRUE. With a globally sorted free list all free
+ * blocks are then examined, otherwise only the free blocks cached in
+ * memory. The scan holds the free list mutex and blocks allocations, so
+ * ranges should be counted only on explicit request, not in periodic
+ * statistics.
+ * 
+ * Parameters : 
+ * 
+ *	p_fl - in, use
+ *		pointer to freelist object
+ *
+ *	p_fragstat - out
+ *		fragmentation statistics
+ *
+ *	countranges - in
+ *		if TRUE, count free ranges, otherwise fs_nranges and
+ *          fs_maxrange are set to zero
+ *
+ * Return value : 
+ * 
+ * Limitations  : none
+ * 
+ * Globals used : none
+ */
+void dbe_fl_getfragstat(
+    dbe_freelist_t *p_fl,
+    dbe_fl_fragstat_t* p_fragstat,
+    bool countranges)
+{
+        ulong nranges = 0;
+        ulong maxrange = 0;
+        ulong range = 0;
+        su_daddr_t prev = SU_DADDR_NULL;
+        su_daddr_t daddr;
+        uint i;
+
+        SsSemEnter(p_fl->fl_mutex);
+        if (!countranges) {
+            /* Only the allocation counters. */
+        } else if (p_fl->fl_inmemory) {
+            long pos;
+
+            pos = su_bmap_findnext(p_fl->fl_map, p_fl->fl_filesize, 1,
+                                   p_fl->fl_map_hint);
+            while (pos != SU_BMAPRC_NOTFOUND) {
+                daddr = (su_daddr_t)pos;
+                if (prev != SU_DADDR_NULL && daddr == prev + 1) {
+                    range++;
+                } else {
+                    nranges++;
+                    range = 1;
+                }
+                if (range > maxrange) {
+                    maxrange = range;
+                }
+                prev = daddr;
+                if (daddr + 1 >= p_fl->fl_filesize) {
+                    break;
+                }
+                pos = su_bmap_findnext(p_fl->fl_map, p_fl->fl_filesize, 1,
+                                       daddr + 1);
+            }
+        } else {
+            /* The table is in descending order. */
+            for (i = p_fl->fl_header.bl_nblocks; i-- > 0; ) {
+                daddr = p_fl->fl_addrtable[i];
+                if (prev != SU_DADDR_NULL && daddr == prev + 1) {
+                    range++;
+                } else {
+                    nranges++;
+                    range = 1;
+                }
+                if (range > maxrange) {
+                    maxrange = range;
+                }
+                prev = daddr;
+            }
+        }
+        p_fragstat->fs_nranges = nranges;
+        p_fragstat->fs_maxrange = maxrange;
+        p_fragstat->fs_nnearalloc = p_fl->fl_nnearalloc;
+        p_fragstat->fs_nfaralloc = p_fl->fl_nfaralloc;
+        SsSemExit(p_fl->fl_mutex);
+}
+
+/*##**********************************************************************\
+ * 
+ *		dbe_fl_getshrinkstat
+ * 
+ * Gets the information needed to move busy blocks from the end of the
+ * file towards the beginning of the file.
+ * 
+ * Parameters : 
+ * 
+ *	p_fl - in, use
+ *		pointer to freelist object
+ *
+ *	p_shrinkstat - out
+ *		file end statistics
+ *
+ * Return value : 
+ *      TRUE if statistics are available, FALSE if the free list is
+ *      not globally sorted
+ * 
+ * Limitations  : none
+ * 
+ * Globals used : none
+ */
+bool dbe_fl_getshrinkstat(
+    dbe_freelist_t *p_fl,
+    dbe_fl_shrinkstat_t* p_shrinkstat)
+{
+        long pos;
+
+        if (!p_fl->fl_inmemory) {
+            return(FALSE);
+        }
+        SsSemEnter(p_fl->fl_mutex);
+        p_shrinkstat->ss_filesize = p_fl->fl_filesize;
+        p_shrinkstat->ss_freeblocks = p_fl->fl_freeblocks;
+        p_shrinkstat->ss_nshrunk = p_fl->fl_nshrunk;
+        pos = su_bmap_findnext(p_fl->fl_map, p_fl->fl_filesize, 1,
+                               p_fl->fl_map_hint);
+        p_shrinkstat->ss_firstfree = pos == SU_BMAPRC_NOTFOUND
+                                     ? SU_DADDR_NULL
+                                     : (su_daddr_t)pos;
+        pos = su_bmap_findlast(p_fl->fl_map, p_fl->fl_filesize, 0);
+        p_shrinkstat->ss_lastbusy = pos == SU_BMAPRC_NOTFOUND
+                                    ? SU_DADDR_NULL
+                                    : (su_daddr_t)pos;
+        SsSemExit(p_fl->fl_mutex);
+        return(TRUE);
+}
+
+/*##**********************************************************************\
+ * 
+ *		dbe_fl_shrink
+ * 
+ * Cuts free blocks at the end of the file out of the logical file
+ * size. Called just before the free list is saved at a checkpoint, so
+ * the new size goes to the checkpoint record. The physical file is
+ * truncated by dbe_fl_truncatefile after the headers that contain the
+ * new size have been written. Nothing is done unless at least one
+ * extend increment worth of blocks can be cut, so that a file which
+ * is growing does not shrink and grow at every checkpoint.
+ * 
+ * Parameters : 
+ * 
+ *	p_fl - in out, use
+ *		pointer to freelist object
+ *
+ * Return value : 
+ * 
+ * Limitations  : Only with a globally sorted free list.
+ * 
+ * Globals used : none
+ */
+void dbe_fl_shrink(
+    dbe_freelist_t *p_fl)
+{
+        long pos;
+        su_daddr_t newsize;
+        su_daddr_t i;
+
+        if (!p_fl->fl_inmemory) {
+            return;
+        }
+        SsSemEnter(p_fl->fl_mutex);
+        ss_dassert(!p_fl->fl_locked);
+        pos = su_bmap_findlast(p_fl->fl_map, p_fl->fl_filesize, 0);
+        if (pos == SU_BMAPRC_NOTFOUND) {
+            SsSemExit(p_fl->fl_mutex);
+            return;
+        }
+        /* Keep the disk full reserve inside the file. */
+        newsize = (su_daddr_t)pos + 1 + p_fl->fl_maxspareblocks;
+        if (newsize >= p_fl->fl_filesize
+        ||  p_fl->fl_filesize - newsize < p_fl->fl_extendincr)
+        {
+            SsSemExit(p_fl->fl_mutex);
+            return;
+        }
+        ss_dprintf_1(("dbe_fl_shrink:filesize %ld -> %ld\n",
+                      (long)p_fl->fl_filesize, (long)newsize));
+        for (i = newsize; i < p_fl->fl_filesize; i++) {
+            ss_dassert(SU_BMAP_GET(p_fl->fl_map, i));
+            SU_BMAP_SET(p_fl->fl_map, i, 0);
+        }
+        /* In memory bl_nblocks is only a hint, see
+         * fl_allocate_from_memory.
+         */
+        if (p_fl->fl_header.bl_nblocks > p_fl->fl_filesize - newsize) {
+            p_fl->fl_header.bl_nblocks -= p_fl->fl_filesize - newsize;
+        } else {
+            p_fl->fl_header.bl_nblocks = 0;
+        }
+        p_fl->fl_freeblocks -= p_fl->fl_filesize - newsize;
+        ss_dassert(!p_fl->fl_freeblocks_known || p_fl->fl_freeblocks >= 0);
+        p_fl->fl_nshrunk += p_fl->fl_filesize - newsize;
+        p_fl->fl_filesize = newsize;
+        if (p_fl->fl_map_hint > newsize) {
+            p_fl->fl_map_hint = newsize;
+        }
+        p_fl->fl_modified = TRUE;
+        p_fl->fl_truncpending = TRUE;
+        SsSemExit(p_fl->fl_mutex);
+}
+
+/*##**********************************************************************\
+ * 
+ *		dbe_fl_truncatefile
+ * 
+ * Truncates the physical file to the logical file size after
+ * dbe_fl_shrink. Must be called only after the database headers that
+ * contain the shrunk file size have been written, otherwise a crash
+ * could leave a header whose file size is larger than the file.
+ * 
+ * Parameters : 
+ * 
+ *	p_fl - in out, use
+ *		pointer to freelist object
+ *
+ * Return value :
+ *          SU_SUCCESS when OK or
+ *          something else on error
+ *          (=return code from failed subroutine)
+ * 
+ * Limitations  : none
+ * 
+ * Globals used : none
+ */
+su_ret_t dbe_fl_truncatefile(
+    dbe_freelist_t *p_fl)
+{
+        su_ret_t rc = SU_SUCCESS;
+        su_daddr_t physical_filesize;
+
+        SsSemEnter(p_fl->fl_mutex);
+        if (p_fl->fl_truncpending) {
+            /* The file may have grown again after dbe_fl_shrink, so the
+             * current logical size is used. It is never smaller than the
+             * size saved to the headers.
+             */
+            physical_filesize = su_svf_getsize(p_fl->fl_file);
+            if (physical_filesize > p_fl->fl_filesize) {
+                ss_dprintf_1(("dbe_fl_truncatefile:%ld -> %ld\n",
+                              (long)physical_filesize, (long)p_fl->fl_filesize));
+                rc = su_svf_decreasesize(p_fl->fl_file, p_fl->fl_filesize);
+                if (rc == SU_SUCCESS) {
+                    SS_PMON_ADD_N(SS_PMON_DBSHRINK,
+                                  physical_filesize - p_fl->fl_filesize);
+                }
+            }
+            p_fl->fl_truncpending = FALSE;
+        }
+        SsSemExit(p_fl->fl_mutex);
+        return(rc);
+}
+
 /*##**********************************************************************\
  * 
  *		dbe_fl_save
@@ -107,6 +107,7 @@
 #define UNKNOWN_NUMBER_OF_TUPLES_IN_TABLE 0.0
 /* #define SOLID_TRUNCATE */
 #define EST_MIN_SELECTIVITY     (1E-20)
+#define DISK_FETCH_NSLOTS       32 /* Row block size for disk table SELECT cursors. */
 #define WRONG_KEY_NO UINT_MAX32
 
 #define ss_printf       printf
@@ -312,6 +313,8 @@ static PSI_cond_info    all_soliddb_cache_conds[] = {
         longlong soliddb_pmon_cachefilewrite;
         longlong soliddb_pmon_cacheprefetch;
         longlong soliddb_pmon_cacheprefetchwait;
+        longlong soliddb_pmon_cacheprefetchused;
+        longlong soliddb_pmon_cacheprefetchwasted;
         longlong soliddb_pmon_cachepreflush;
         longlong soliddb_pmon_cachelruwrite;
         longlong soliddb_pmon_cacheslotwait;
@@ -345,6 +348,15 @@ static PSI_cond_info    all_soliddb_cache_conds[] = {
         longlong soliddb_pmon_srchnactive;
         longlong soliddb_pmon_dbsize;
         longlong soliddb_pmon_dbfreesize;
+        longlong soliddb_pmon_dbnearalloc;
+        longlong soliddb_pmon_dbfaralloc;
+        longlong soliddb_pmon_dbdefragmove;
+        longlong soliddb_pmon_dbshrink;
+        longlong soliddb_pmon_condpush;
+        longlong soliddb_pmon_keyfilter;
+        longlong soliddb_pmon_dataseaprefetch;
+        longlong soliddb_pmon_trxchkalloc;
+        longlong soliddb_pmon_trxchkreuse;
         longlong soliddb_pmon_memsize;
         longlong soliddb_pmon_mergequickstep;
         longlong soliddb_pmon_mergestep;
@@ -367,6 +379,11 @@ static PSI_cond_info    all_soliddb_cache_conds[] = {
         longlong soliddb_pmon_logflushes_logical;
         longlong soliddb_pmon_logflushes_physical;
         longlong soliddb_pmon_loggroupcommit_wakeups;
+        longlong soliddb_pmon_loggroupcommit_leader;
+        longlong soliddb_pmon_loggroupcommit_follower;
+        longlong soliddb_pmon_sorter_spillwrite;
+        longlong soliddb_pmon_sorter_spillread;
+        longlong soliddb_pmon_sorter_spillio;
         longlong soliddb_pmon_logflushes_fullpages;
         longlong soliddb_pmon_logwaitflush;
         longlong soliddb_pmon_logmaxwritequeuerecords;
@@ -376,6 +393,8 @@ static PSI_cond_info    all_soliddb_cache_conds[] = {
         longlong soliddb_pmon_dbe_lock_ok;
         longlong soliddb_pmon_dbe_lock_timeout;
         longlong soliddb_pmon_dbe_lock_deadlock;
+        longlong soliddb_pmon_dbe_lock_deadlockcheck;
+        longlong soliddb_pmon_dbe_lock_deadlockchecktime;
         longlong soliddb_pmon_dbe_lock_wait;
         longlong soliddb_pmon_mysql_rnd_init;
         longlong soliddb_pmon_mysql_index_read;
@@ -442,6 +461,8 @@ struct show_var_st soliddb_status_variables[] = {
 {"pmon_cachefilewrite", (char *)&solid_export_vars.soliddb_pmon_cachefilewrite, SHOW_LONGLONG },
 {"pmon_cacheprefetch", (char *)&solid_export_vars.soliddb_pmon_cacheprefetch, SHOW_LONGLONG },
 {"pmon_cacheprefetchwait", (char *)&solid_export_vars.soliddb_pmon_cacheprefetchwait, SHOW_LONGLONG },
+{"pmon_cacheprefetchused", (char *)&solid_export_vars.soliddb_pmon_cacheprefetchused, SHOW_LONGLONG },
+{"pmon_cacheprefetchwasted", (char *)&solid_export_vars.soliddb_pmon_cacheprefetchwasted, SHOW_LONGLONG },
 {"pmon_cachepreflush", (char *)&solid_export_vars.soliddb_pmon_cachepreflush, SHOW_LONGLONG },
 {"pmon_cachelruwrite", (char *)&solid_export_vars.soliddb_pmon_cachelruwrite, SHOW_LONGLONG },
 {"pmon_cacheslotwait", (char *)&solid_export_vars.soliddb_pmon_cacheslotwait, SHOW_LONGLONG },
@@ -475,6 +496,15 @@ struct show_var_st soliddb_status_variables[] = {
 {"pmon_srchnactive", (char *)&solid_export_vars.soliddb_pmon_srchnactive, SHOW_LONGLONG },
 {"pmon_dbsize", (char *)&solid_export_vars.soliddb_pmon_dbsize, SHOW_LONGLONG },
 {"pmon_dbfreesize", (char *)&solid_export_vars.soliddb_pmon_dbfreesize, SHOW_LONGLONG },
+{"pmon_dbnearalloc", (char *)&solid_export_vars.soliddb_pmon_dbnearalloc, SHOW_LONGLONG },
+{"pmon_dbfaralloc", (char *)&solid_export_vars.soliddb_pmon_dbfaralloc, SHOW_LONGLONG },
+{"pmon_dbdefragmove", (char *)&solid_export_vars.soliddb_pmon_dbdefragmove, SHOW_LONGLONG },
+{"pmon_dbshrink", (char *)&solid_export_vars.soliddb_pmon_dbshrink, SHOW_LONGLONG },
+{"pmon_condpush", (char *)&solid_export_vars.soliddb_pmon_condpush, SHOW_LONGLONG },
+{"pmon_keyfilter", (char *)&solid_export_vars.soliddb_pmon_keyfilter, SHOW_LONGLONG },
+{"pmon_dataseaprefetch", (char *)&solid_export_vars.soliddb_pmon_dataseaprefetch, SHOW_LONGLONG },
+{"pmon_trxchkalloc", (char *)&solid_export_vars.soliddb_pmon_trxchkalloc, SHOW_LONGLONG },
+{"pmon_trxchkreuse", (char *)&solid_export_vars.soliddb_pmon_trxchkreuse, SHOW_LONGLONG },
 {"pmon_memsize", (char *)&solid_export_vars.soliddb_pmon_memsize, SHOW_LONGLONG },
 {"pmon_mergequickstep", (char *)&solid_export_vars.soliddb_pmon_mergequickstep, SHOW_LONGLONG },
 {"pmon_mergestep", (char *)&solid_export_vars.soliddb_pmon_mergestep, SHOW_LONGLONG },
@@ -497,6 +527,11 @@ struct show_var_st soliddb_status_variables[] = {
 {"pmon_logflushes_logical", (char *)&solid_export_vars.soliddb_pmon_logflushes_logical, SHOW_LONGLONG },
 {"pmon_logflushes_physical", (char *)&solid_export_vars.soliddb_pmon_logflushes_physical, SHOW_LONGLONG },
 {"pmon_loggroupcommit_wakeups", (char *)&solid_export_vars.soliddb_pmon_loggroupcommit_wakeups, SHOW_LONGLONG },
+{"pmon_loggroupcommit_leader", (char *)&solid_export_vars.soliddb_pmon_loggroupcommit_leader, SHOW_LONGLONG },
+{"pmon_loggroupcommit_follower", (char *)&solid_export_vars.soliddb_pmon_loggroupcommit_follower, SHOW_LONGLONG },
+{"pmon_sorter_spillwrite", (char *)&solid_export_vars.soliddb_pmon_sorter_spillwrite, SHOW_LONGLONG },
+{"pmon_sorter_spillread", (char *)&solid_export_vars.soliddb_pmon_sorter_spillread, SHOW_LONGLONG },
+{"pmon_sorter_spillio", (char *)&solid_export_vars.soliddb_pmon_sorter_spillio, SHOW_LONGLONG },
 {"pmon_logflushes_fullpages", (char *)&solid_export_vars.soliddb_pmon_logflushes_fullpages, SHOW_LONGLONG },
 {"pmon_logwaitflush", (char *)&solid_export_vars.soliddb_pmon_logwaitflush, SHOW_LONGLONG },
 {"pmon_logmaxwritequeuerecords", (char *)&solid_export_vars.soliddb_pmon_logmaxwritequeuerecords, SHOW_LONGLONG },
@@ -506,6 +541,8 @@ struct show_var_st soliddb_status_variables[] = {
 {"pmon_dbe_lock_ok", (char *)&solid_export_vars.soliddb_pmon_dbe_lock_ok, SHOW_LONGLONG },
 {"pmon_dbe_lock_timeout", (char *)&solid_export_vars.soliddb_pmon_dbe_lock_timeout, SHOW_LONGLONG },
 {"pmon_dbe_lock_deadlock", (char *)&solid_export_vars.soliddb_pmon_dbe_lock_deadlock, SHOW_LONGLONG },
+{"pmon_dbe_lock_deadlockcheck", (char *)&solid_export_vars.soliddb_pmon_dbe_lock_deadlockcheck, SHOW_LONGLONG },
+{"pmon_dbe_lock_deadlockchecktime", (char *)&solid_export_vars.soliddb_pmon_dbe_lock_deadlockchecktime, SHOW_LONGLONG },
 {"pmon_dbe_lock_wait", (char *)&solid_export_vars.soliddb_pmon_dbe_lock_wait, SHOW_LONGLONG },
 {"pmon_mysql_rnd_init", (char *)&solid_export_vars.soliddb_pmon_mysql_rnd_init, SHOW_LONGLONG },
 {"pmon_mysql_index_read", (char *)&solid_export_vars.soliddb_pmon_mysql_index_read, SHOW_LONGLONG },
@@ -537,6 +574,7 @@ static su_ret_t do_backup( rs_sysi_t* cd, char* parameters, su_err_t** p_errh );
 static su_ret_t do_backup( rs_sysi_t* cd, char* parameters, su_err_t** p_errh );
 static su_ret_t do_performance_monitor(rs_sysi_t* cd, char* parameters, su_err_t** p_errh);
 static su_ret_t do_checkpoint(rs_sysi_t* cd, char* parameters, su_err_t** p_errh);
+static su_ret_t do_defragment(rs_sysi_t* cd, char* parameters, su_err_t** p_errh);
 static su_ret_t do_ssdebug(rs_sysi_t* cd, char* parameters, su_err_t** p_errh);
 static su_ret_t do_command(rs_sysi_t* cd, tb_trans_t* trans, const char* cmd, const char* parameters, su_err_t** p_errh);
 
@@ -561,6 +599,7 @@ static solid_admin_commands_t solid_admin_commands [] =
     {"backup", do_backup},
     {"pmon", do_performance_monitor},
     {"checkpoint", do_checkpoint},
+    {"defragment", do_defragment},
     {"ssdebug", do_ssdebug},
 
 #if !defined(MYSQL_DYNAMIC_PLUGIN) && defined(SS_DEBUG)
@@ -3460,7 +3499,8 @@ static void solid_relcur_free_cursor(
         if (solid_relcur->sr_fetchtval != NULL) {
             ss_debug(rs_tval_resetexternalflatva(cd, solid_relcur->sr_ttype, solid_relcur->sr_fetchtval));
 
-            if (!solid_relcur->sr_mainmem) {
+            /* With a row block the tuple value belongs to the block. */
+            if (!solid_relcur->sr_mainmem && solid_relcur->sr_vbuf == NULL) {
                 rs_tval_free(cd, solid_relcur->sr_ttype, solid_relcur->sr_fetchtval);
             }
 
@@ -3676,7 +3716,7 @@ static void solid_free_connection_nomutex(SOLID_CONN* con)
                 if (solid_relcur->sr_fetchtval != NULL) {
                     ss_debug(rs_tval_resetexternalflatva(con->sc_cd, solid_relcur->sr_ttype, solid_relcur->sr_fetchtval));
 
-                    if (!solid_relcur->sr_mainmem) {
+                    if (!solid_relcur->sr_mainmem && solid_relcur->sr_vbuf == NULL) {
                         rs_tval_free(con->sc_cd, solid_relcur->sr_ttype, solid_relcur->sr_fetchtval);
                     }
                     solid_relcur->sr_fetchtval = NULL;
@@ -6106,6 +6146,8 @@ ha_soliddb::ha_soliddb(
         extra_replace_duplicate = FALSE;
         extra_update_duplicate = FALSE;
 
+        n_pushed_cond = 0;
+
         DBUG_VOID_RETURN;
 }
 
@@ -7169,6 +7211,96 @@ static su_ret_t do_checkpoint(
         DBUG_RETURN(rc);
 }
 
+/*#***********************************************************************\
+ *
+ *              do_defragment
+ *
+ * Moves permanent tree nodes from the end of the database file towards
+ * the beginning of the file and then creates two checkpoints: the first
+ * one releases the old node blocks and the second one cuts the free
+ * blocks off the end of the file. Nodes changed in the current
+ * checkpoint are moved after an extra checkpoint. Fails with
+ * DBE_ERR_DEFRAGACT if another defragment is already running. Nodes are moved in steps of
+ * 'blocks' examined blocks with 'sleep' milliseconds between steps so
+ * that the server keeps serving users. Progress can be followed from
+ * INFORMATION_SCHEMA.SOLIDDB_SYS_DEFRAG.
+ *
+ * Usage: defragment [blocks [sleep]]
+ *
+ * Parameters :
+ *
+ *     rs_sysi_t*  cd, in, use
+ *     char* parameters,  in, use, parameters
+ *     su_err_t**  p_errh, in out, NULL
+ *
+ * Return value : solidDB return code
+ *
+ * Globals used:
+ */
+static su_ret_t do_defragment(
+        rs_sysi_t* cd,
+        char* parameters,
+        su_err_t** p_errh)
+{
+        su_ret_t rc;
+        tb_connect_t* tc;
+        dbe_db_t* soliddb;
+        uint nblocks = 64;
+        uint sleepms = 10;
+        ulong nmoved;
+        int i;
+
+        DBUG_ENTER("solid:do_defragment");
+        ss_pprintf_1(("do_defragment\n"));
+
+        ss_dassert(cd != NULL);
+
+        if (parameters != NULL) {
+            su_pars_match_t m;
+            su_pars_match_init(&m, parameters);
+
+            if (su_pars_get_uint(&m, &nblocks)) {
+                su_pars_get_uint(&m, &sleepms);
+            }
+            if (!su_pars_match_const(&m, (char *)"") || nblocks == 0) {
+                su_err_init(p_errh, DBE_ERR_FAILED);
+                DBUG_RETURN(DBE_ERR_FAILED);
+            }
+        }
+
+        soliddb = (dbe_db_t*)rs_sysi_db(cd);
+        tc = tb_sysconnect_init((tb_database_t*)rs_sysi_tabdb(cd));
+
+        do {
+            rc = dbe_db_defragstep(soliddb, nblocks, &nmoved);
+            if (rc == DBE_RC_RETRY) {
+                /* Remaining nodes are changed in the current checkpoint. */
+                dbe_db_logflushtodisk(soliddb);
+                rc = tb_createcheckpoint(tc, /*splitlog = */ FALSE);
+                if (rc == DBE_RC_SUCC) {
+                    rc = DBE_RC_CONT;
+                }
+            } else if (rc == DBE_RC_CONT && sleepms > 0) {
+                SsThrSleep(sleepms);
+            }
+        } while (rc == DBE_RC_CONT);
+
+        if (rc == DBE_RC_END) {
+            dbe_db_logflushtodisk(soliddb);
+            rc = DBE_RC_SUCC;
+            for (i = 0; i < 2 && rc == DBE_RC_SUCC; i++) {
+                rc = tb_createcheckpoint(tc, /*splitlog = */ i == 0);
+            }
+        }
+        tb_sysconnect_done(tc);
+
+        if (rc != DBE_RC_SUCC) {
+            su_err_init(p_errh, rc);
+        }
+
+        DBUG_RETURN(rc);
+}
+
 
 /*#***********************************************************************\
  *
@@ -9566,6 +9698,121 @@ static inline int mysql_record_is_null(
         }
 }
 
+/*#***********************************************************************\
+ *
+ *              solid_relcur_addkeycons
+ *
+ * Adds pushed integer comparisons as key constraints of a disk table
+ * search. Key constraints are checked against the index entry before
+ * the data tuple is dereferenced. Only ascending user defined key parts
+ * of an integer column in the used key are constrained.
+ *
+ * Parameters :
+ *
+ *     rs_sysi_t*       cd, in, use
+ *     rs_ttype_t*      ttype, in, use, table type
+ *     rs_key_t*        key, in, use, search key
+ *     su_list_t*       key_constraints, use, plan key constraint list
+ *     const SOLIDDB_PUSHED_COND* pushed_cond, in, use, pushed comparisons
+ *     uint             n_pushed_cond, in, use, number of pushed comparisons
+ *
+ * Return value : -
+ *
+ * Globals used :
+ */
+static void solid_relcur_addkeycons(
+        rs_sysi_t* cd,
+        rs_ttype_t* ttype,
+        rs_key_t* key,
+        su_list_t* key_constraints,
+        const SOLIDDB_PUSHED_COND* pushed_cond,
+        uint n_pushed_cond)
+{
+        uint i;
+
+        for (i = 0; i < n_pushed_cond; i++) {
+            const SOLIDDB_PUSHED_COND* pc;
+            rs_ano_t physano;
+            rs_ano_t kpno;
+            rs_atype_t* atype;
+            rs_aval_t avalbuf;
+            RS_AVALRET_T avret;
+            rs_pla_cons_t* pla_cons;
+
+            pc = &pushed_cond[i];
+
+            physano = rs_ttype_sqlanotophys(cd, ttype, pc->pc_fieldno);
+            kpno = rs_key_searchkpno_data(cd, key, physano);
+            if (kpno == RS_ANO_NULL
+                || rs_keyp_isconstvalue(cd, key, kpno)
+                || rs_keyp_parttype(cd, key, kpno) != RSAT_USER_DEFINED
+                || !rs_keyp_isascending(cd, key, kpno))
+            {
+                continue;
+            }
+
+            atype = rs_ttype_atype(cd, ttype, physano);
+            rs_aval_createbuf(cd, atype, &avalbuf);
+
+            switch (rs_atype_datatype(cd, atype)) {
+                case RSDT_INTEGER:
+                    if (pc->pc_value < SS_INT4_MIN || pc->pc_value > SS_INT4_MAX) {
+                        avret = RSAVR_FAILURE;
+                    } else {
+                        avret = rs_aval_setlong_ext(cd, atype, &avalbuf,
+                                                    (long)pc->pc_value, NULL);
+                    }
+                    break;
+                case RSDT_BIGINT:
+                    {
+                        ss_int8_t i8;
+
+                        SsInt8SetNativeUint8(&i8, (ulonglong)pc->pc_value);
+                        avret = rs_aval_setint8_ext(cd, atype, &avalbuf, i8, NULL);
+                    }
+                    break;
+                default:
+                    avret = RSAVR_FAILURE;
+                    break;
+            }
+
+            if (avret == RSAVR_SUCCESS) {
+                rs_aval_t* defaval;
+                va_t* defva;
+
+                ss_pprintf_2(("solid_relcur_addkeycons:kpno=%d, relop=%d\n",
+                              kpno, pc->pc_relop));
+
+                /* Key entries written before an ADD COLUMN hold VA_DEFAULT. */
+                defaval = rs_atype_getoriginaldefault(cd, atype);
+                if (defaval != NULL) {
+                    defva = rs_aval_va(cd, atype, defaval);
+                } else {
+                    defva = NULL;
+                }
+
+                pla_cons = rs_pla_cons_init(
+                                cd,
+                                kpno,
+                                pc->pc_relop,
+                                rs_aval_va(cd, atype, &avalbuf),
+                                RS_CONS_NOESCCHAR,
+                                0,
+                                defva
+#ifdef SS_COLLATION
+                                , NULL
+#endif /* SS_COLLATION */
+                            );
+                su_list_insertlast_nodebuf(
+                    key_constraints,
+                    rs_pla_cons_listnode(cd, pla_cons),
+                    pla_cons);
+            }
+
+            rs_aval_freebuf(cd, atype, &avalbuf);
+        }
+}
+
 /*#***********************************************************************\
  *
  *              solid_relcur_setconstr
@@ -9583,6 +9830,8 @@ static inline int mysql_record_is_null(
  *     const SS_MYSQL_ROW*      keyconstr_ptr, in, use, key constraint
  *     uint             keyconstr_len, in, use, key constraint length
  *     enum ha_rkey_function find_flag, in, use
+ *     const SOLIDDB_PUSHED_COND* pushed_cond, in, use, pushed comparisons
+ *     uint             n_pushed_cond, in, use, number of pushed comparisons
  *
  *
  * Return value : 0 or error code
@@ -9600,7 +9849,9 @@ static int solid_relcur_setconstr(
         TABLE* table,
         const SS_MYSQL_ROW* keyconstr_ptr,
         uint keyconstr_len,
-        enum ha_rkey_function find_flag)
+        enum ha_rkey_function find_flag,
+        const SOLIDDB_PUSHED_COND* pushed_cond,
+        uint n_pushed_cond)
 {
         KEY_PART_INFO* key_part;
         const SS_MYSQL_ROW* ptr;
@@ -9612,6 +9863,7 @@ static int solid_relcur_setconstr(
         va_t* range_start_last_va;
         va_t* range_end_last_va;
         su_list_t* tuple_reference;
+        su_list_t* key_constraints;
         rs_ttype_t* ttype;
         bool newindex;
         bool newplan;
@@ -10175,6 +10427,20 @@ static int solid_relcur_setconstr(
         }
         ss_dassert(su_list_length(tuple_reference) > 0);
 
+        if (mainmem) {
+            key_constraints = NULL;
+        } else {
+            rs_pla_clear_key_constraints_buf(cd, solid_relcur->sr_pla);
+            key_constraints = rs_pla_get_key_constraints_buf(cd, solid_relcur->sr_pla);
+            solid_relcur_addkeycons(
+                cd,
+                ttype,
+                key,
+                key_constraints,
+                pushed_cond,
+                n_pushed_cond);
+        }
+
         if (newplan) {
             ss_pprintf_2(("ha_solid::solid_relcur_setconstr:rs_pla_initbuf\n"));
 
@@ -10188,7 +10454,7 @@ static int solid_relcur_setconstr(
                 TRUE,
                 range_end,
                 TRUE,
-                NULL,
+                key_constraints,
                 NULL,
                 solid_relcur->sr_constraints,
                 tuple_reference,
@@ -10212,7 +10478,7 @@ static int solid_relcur_setconstr(
                 TRUE,
                 range_end,
                 TRUE,
-                NULL,
+                key_constraints,
                 NULL,
                 solid_relcur->sr_constraints,
                 tuple_reference,
@@ -10441,12 +10707,24 @@ int ha_soliddb::solid_fetch(
                         } else {
                             solid_relcur->sr_vbuf = rs_vbuf_init(cd, solid_relcur->sr_ttype, 2);
                         }
+                    } else if (solid_relcur->sr_cursor_type == DBE_CURSOR_SELECT &&
+                               soliddb_sql_command(thd) == SQLCOM_SELECT) {
+                        /* Plain SELECT from a disk table, fetch rows
+                         * in blocks. Fetched rows point to the block.
+                         */
+                        ss_dassert(solid_relcur->sr_vbuf == NULL);
+                        if (solid_relcur->sr_fetchtval != NULL) {
+                            ss_debug(rs_tval_resetexternalflatva(cd, solid_relcur->sr_ttype, solid_relcur->sr_fetchtval));
+                            rs_tval_free(cd, solid_relcur->sr_ttype, solid_relcur->sr_fetchtval);
+                            solid_relcur->sr_fetchtval = NULL;
+                        }
+                        solid_relcur->sr_vbuf = rs_vbuf_init(cd, solid_relcur->sr_ttype, DISK_FETCH_NSLOTS);
                     }
 
                 } else {
                     ss_pprintf_2(("ha_solid::solid_fetch:dbe_cursor_reset\n"));
 
-                    if (nextp && rowbuf != NULL && !solid_relcur->sr_mainmem) {
+                    if (nextp && rowbuf != NULL && solid_relcur->sr_vbuf == NULL) {
                         SS_PMON_ADD(SS_PMON_MYSQL_CURSOR_RESET_FETCH);
 
                         rc = dbe_cursor_reset_fetch(
@@ -10571,6 +10849,35 @@ int ha_soliddb::solid_fetch(
                 } while (rs_sysi_lockwait(cd) || rc == DBE_RC_WAITLOCK);
 
                 ss_dassert(rc != DBE_RC_NOTFOUND);
+            } else if (solid_relcur->sr_vbuf != NULL) {
+                do {
+                    /* The search steps back over unread rows when the
+                     * direction changes, so call it also then.
+                     */
+                    if (solid_relcur->sr_prevnextp != nextp ||
+                        !rs_vbuf_hasdata(cd, solid_relcur->sr_vbuf)) {
+                        rc = dbe_cursor_nextorprev_n(
+                                solid_relcur->sr_relcur,
+                                nextp,
+                                tb_trans_dbtrx(cd, trans),
+                                solid_relcur->sr_vbuf,
+                                &errh);
+                        solid_relcur->sr_prevnextp = nextp;
+
+                        ss_debug(if (steps == 10000000) SsDbgSet("/LEV:4/FIL:ha,dbe4srch,dbe5isea,dbe6bsea,su0err/LOG/NOD/THR/TIM/LIM:500000000");)
+                        ss_rc_dassert(steps < 11000000, steps);
+                        ss_debug(steps++;)
+                    } else {
+                        rc = DBE_RC_FOUND;
+                    }
+
+                    if (rc == DBE_RC_FOUND) {
+                        solid_relcur->sr_fetchtval = rs_vbuf_readtval(cd, solid_relcur->sr_vbuf);
+                        if (solid_relcur->sr_fetchtval == NULL) {
+                            rc = DBE_RC_END;
+                        }
+                    }
+                } while (rs_sysi_lockwait(cd) || rc == DBE_RC_WAITLOCK || rc == DBE_RC_NOTFOUND);
             } else {
                 do {
                     if(command == SQLCOM_ALTER_TABLE ||
@@ -11018,7 +11325,9 @@ int ha_soliddb::solid_index_read_idx(
                 table,
                 key,
                 key_len,
-                find_flag);
+                find_flag,
+                pushed_cond,
+                n_pushed_cond);
 
         if (rc == 0) {
             if (!firstp) {
@@ -11498,7 +11807,9 @@ int ha_soliddb::rnd_next(SS_MYSQL_ROW* buf)
                     NULL,
                     NULL,
                     0,
-                    HA_READ_AFTER_KEY);
+                    HA_READ_AFTER_KEY,
+                    pushed_cond,
+                    n_pushed_cond);
 
             rnd_mustinit = FALSE;
 
@@ -11736,7 +12047,9 @@ int ha_soliddb::rnd_pos(SS_MYSQL_ROW* buf, SS_MYSQL_ROW* pos)
                     NULL,
                     NULL,
                     0,
-                    HA_READ_AFTER_KEY);
+                    HA_READ_AFTER_KEY,
+                    NULL,
+                    0);
 
             rnd_mustinit = FALSE;
 
@@ -17069,6 +17382,8 @@ void soliddb_export_status(void)
         solid_export_vars.soliddb_pmon_cachefilewrite = pmon.pm_values[SS_PMON_CACHEFILEWRITE];
         solid_export_vars.soliddb_pmon_cacheprefetch = pmon.pm_values[SS_PMON_CACHEPREFETCH];
         solid_export_vars.soliddb_pmon_cacheprefetchwait = pmon.pm_values[SS_PMON_CACHEPREFETCHWAIT];
+        solid_export_vars.soliddb_pmon_cacheprefetchused = pmon.pm_values[SS_PMON_CACHEPREFETCHUSED];
+        solid_export_vars.soliddb_pmon_cacheprefetchwasted = pmon.pm_values[SS_PMON_CACHEPREFETCHWASTED];
         solid_export_vars.soliddb_pmon_cachepreflush = pmon.pm_values[SS_PMON_CACHEPREFLUSH];
         solid_export_vars.soliddb_pmon_cachelruwrite = pmon.pm_values[SS_PMON_CACHELRUWRITE];
         solid_export_vars.soliddb_pmon_cacheslotwait = pmon.pm_values[SS_PMON_CACHESLOTWAIT];
@@ -17102,6 +17417,15 @@ void soliddb_export_status(void)
         solid_export_vars.soliddb_pmon_srchnactive = pmon.pm_values[SS_PMON_SRCHNACTIVE];
         solid_export_vars.soliddb_pmon_dbsize = pmon.pm_values[SS_PMON_DBSIZE];
         solid_export_vars.soliddb_pmon_dbfreesize = pmon.pm_values[SS_PMON_DBFREESIZE];
+        solid_export_vars.soliddb_pmon_dbnearalloc = pmon.pm_values[SS_PMON_DBNEARALLOC];
+        solid_export_vars.soliddb_pmon_dbfaralloc = pmon.pm_values[SS_PMON_DBFARALLOC];
+        solid_export_vars.soliddb_pmon_dbdefragmove = pmon.pm_values[SS_PMON_DBDEFRAGMOVE];
+        solid_export_vars.soliddb_pmon_dbshrink = pmon.pm_values[SS_PMON_DBSHRINK];
+        solid_export_vars.soliddb_pmon_condpush = pmon.pm_values[SS_PMON_CONDPUSH];
+        solid_export_vars.soliddb_pmon_keyfilter = pmon.pm_values[SS_PMON_KEYFILTER];
+        solid_export_vars.soliddb_pmon_dataseaprefetch = pmon.pm_values[SS_PMON_DATASEA_PREFETCH];
+        solid_export_vars.soliddb_pmon_trxchkalloc = pmon.pm_values[SS_PMON_TRXCHKALLOC];
+        solid_export_vars.soliddb_pmon_trxchkreuse = pmon.pm_values[SS_PMON_TRXCHKREUSE];
         solid_export_vars.soliddb_pmon_memsize = pmon.pm_values[SS_PMON_MEMSIZE];
         solid_export_vars.soliddb_pmon_mergequickstep = pmon.pm_values[SS_PMON_MERGEQUICKSTEP];
         solid_export_vars.soliddb_pmon_mergestep = pmon.pm_values[SS_PMON_MERGESTEP];
@@ -17124,6 +17448,11 @@ void soliddb_export_status(void)
         solid_export_vars.soliddb_pmon_logflushes_logical = pmon.pm_values[SS_PMON_LOGFLUSHES_LOGICAL];
         solid_export_vars.soliddb_pmon_logflushes_physical = pmon.pm_values[SS_PMON_LOGFLUSHES_PHYSICAL];
         solid_export_vars.soliddb_pmon_loggroupcommit_wakeups = pmon.pm_values[SS_PMON_LOGGROUPCOMMIT_WAKEUPS];
+        solid_export_vars.soliddb_pmon_loggroupcommit_leader = pmon.pm_values[SS_PMON_LOGGROUPCOMMIT_LEADER];
+        solid_export_vars.soliddb_pmon_loggroupcommit_follower = pmon.pm_values[SS_PMON_LOGGROUPCOMMIT_FOLLOWER];
+        solid_export_vars.soliddb_pmon_sorter_spillwrite = pmon.pm_values[SS_PMON_SORTER_SPILLWRITE];
+        solid_export_vars.soliddb_pmon_sorter_spillread = pmon.pm_values[SS_PMON_SORTER_SPILLREAD];
+        solid_export_vars.soliddb_pmon_sorter_spillio = pmon.pm_values[SS_PMON_SORTER_SPILLIO];
         solid_export_vars.soliddb_pmon_logflushes_fullpages = pmon.pm_values[SS_PMON_LOGFLUSHES_FULLPAGES];
         solid_export_vars.soliddb_pmon_logwaitflush = pmon.pm_values[SS_PMON_LOGWAITFLUSH];
         solid_export_vars.soliddb_pmon_logmaxwritequeuerecords = pmon.pm_values[SS_PMON_LOGMAXWRITEQUEUERECORDS];
@@ -17133,6 +17462,8 @@ void soliddb_export_status(void)
         solid_export_vars.soliddb_pmon_dbe_lock_ok = pmon.pm_values[SS_PMON_DBE_LOCK_OK];
         solid_export_vars.soliddb_pmon_dbe_lock_timeout = pmon.pm_values[SS_PMON_DBE_LOCK_TIMEOUT];
         solid_export_vars.soliddb_pmon_dbe_lock_deadlock = pmon.pm_values[SS_PMON_DBE_LOCK_DEADLOCK];
+        solid_export_vars.soliddb_pmon_dbe_lock_deadlockcheck = pmon.pm_values[SS_PMON_DBE_LOCK_DEADLOCKCHECK];
+        solid_export_vars.soliddb_pmon_dbe_lock_deadlockchecktime = pmon.pm_values[SS_PMON_DBE_LOCK_DEADLOCKCHECKTIME];
         solid_export_vars.soliddb_pmon_dbe_lock_wait = pmon.pm_values[SS_PMON_DBE_LOCK_WAIT];
         solid_export_vars.soliddb_pmon_mysql_rnd_init = pmon.pm_values[SS_PMON_MYSQL_RND_INIT];
         solid_export_vars.soliddb_pmon_mysql_index_read = pmon.pm_values[SS_PMON_MYSQL_INDEX_READ];
@@ -18938,9 +19269,199 @@ int ha_soliddb::reset()
         extra_replace_duplicate = FALSE;
         extra_update_duplicate = FALSE;
 
+        n_pushed_cond = 0;
+
         DBUG_RETURN(0);
 }
 
+/*#***********************************************************************\
+ *
+ *              solid_cond_push_item
+ *
+ * Checks if a condition item is a simple comparison between an integer
+ * column of this table and an integer constant. Such comparisons can be
+ * evaluated against the index entry before the data tuple is read.
+ *
+ * Parameters :
+ *
+ *     TABLE*               table, in, use, MySQL table
+ *     Item*                item, in, use, condition item
+ *     SOLIDDB_PUSHED_COND* pc, out, pushed comparison
+ *
+ * Return value : TRUE if the comparison was stored to pc
+ *
+ * Globals used :
+ */
+static bool solid_cond_push_item(
+        TABLE* table,
+        Item* item,
+        SOLIDDB_PUSHED_COND* pc)
+{
+        Item_func* func;
+        Item** args;
+        Item* const_item;
+        Field* field;
+        bool swapped;
+        uint relop;
+        longlong value;
+
+        if (item->type() != Item::FUNC_ITEM) {
+            return(FALSE);
+        }
+        func = (Item_func*)item;
+        if (func->argument_count() != 2) {
+            return(FALSE);
+        }
+        args = func->arguments();
+
+        if (args[0]->type() == Item::FIELD_ITEM) {
+            field = ((Item_field*)args[0])->field;
+            const_item = args[1];
+            swapped = FALSE;
+        } else if (args[1]->type() == Item::FIELD_ITEM) {
+            field = ((Item_field*)args[1])->field;
+            const_item = args[0];
+            swapped = TRUE;
+        } else {
+            return(FALSE);
+        }
+
+        switch (func->functype()) {
+            case Item_func::EQ_FUNC:
+                relop = RS_RELOP_EQUAL;
+                break;
+            case Item_func::LT_FUNC:
+                relop = swapped ? RS_RELOP_GT : RS_RELOP_LT;
+                break;
+            case Item_func::LE_FUNC:
+                relop = swapped ? RS_RELOP_GE : RS_RELOP_LE;
+                break;
+            case Item_func::GT_FUNC:
+                relop = swapped ? RS_RELOP_LT : RS_RELOP_GT;
+                break;
+            case Item_func::GE_FUNC:
+                relop = swapped ? RS_RELOP_LE : RS_RELOP_GE;
+                break;
+            default:
+                return(FALSE);
+        }
+
+        if (field->table != table) {
+            return(FALSE);
+        }
+
+        switch (field->type()) {
+            case MYSQL_TYPE_TINY:
+            case MYSQL_TYPE_SHORT:
+            case MYSQL_TYPE_INT24:
+            case MYSQL_TYPE_LONG:
+                break;
+            case MYSQL_TYPE_LONGLONG:
+                if (((Field_num*)field)->unsigned_flag) {
+                    /* Stored as a signed BIGINT, ordering differs. */
+                    return(FALSE);
+                }
+                break;
+            default:
+                return(FALSE);
+        }
+
+        if (!const_item->const_item()
+            || !const_item->basic_const_item()
+            || const_item->result_type() != INT_RESULT)
+        {
+            return(FALSE);
+        }
+
+        value = const_item->val_int();
+        if (const_item->null_value) {
+            return(FALSE);
+        }
+        if (const_item->unsigned_flag && value < 0) {
+            return(FALSE);
+        }
+
+        ss_pprintf_2(("solid_cond_push_item:field %s, relop %d, value %ld\n",
+                      field->field_name, relop, (long)value));
+
+        pc->pc_fieldno = field->field_index;
+        pc->pc_relop = relop;
+        pc->pc_value = value;
+
+        return(TRUE);
+}
+
+/*#***********************************************************************\
+ *
+ *              ::cond_push
+ *
+ * Condition pushdown. Integer comparisons between a column and a constant
+ * are stored and later given to the search as key constraints, so rows
+ * are rejected on the index entry before the data tuple is read. The
+ * whole condition is still returned to MySQL which evaluates it
+ * for every row we return.
+ *
+ * Parameters :
+ *
+ *     const COND*      cond, in, use, condition for this table
+ *
+ * Return value : cond, MySQL must evaluate the full condition
+ *
+ * Globals used :
+ */
+const COND* ha_soliddb::cond_push(const COND* cond)
+{
+        Item* item;
+
+        DBUG_ENTER("ha_soliddb::cond_push");
+
+        item = (Item*)cond;
+
+        if (item->type() == Item::COND_ITEM
+            && ((Item_cond*)item)->functype() == Item_func::COND_AND_FUNC)
+        {
+            List_iterator<Item> li(*((Item_cond*)item)->argument_list());
+            Item* arg;
+
+            while ((arg = li++) != NULL && n_pushed_cond < SOLIDDB_MAX_PUSHED_COND) {
+                if (solid_cond_push_item(table, arg, &pushed_cond[n_pushed_cond])) {
+                    n_pushed_cond++;
+                    SS_PMON_ADD(SS_PMON_CONDPUSH);
+                }
+            }
+        } else if (n_pushed_cond < SOLIDDB_MAX_PUSHED_COND) {
+            if (solid_cond_push_item(table, item, &pushed_cond[n_pushed_cond])) {
+                n_pushed_cond++;
+                SS_PMON_ADD(SS_PMON_CONDPUSH);
+            }
+        }
+
+        DBUG_RETURN(cond);
+}
+
+/*#***********************************************************************\
+ *
+ *              ::cond_pop
+ *
+ * Pops the condition stack. We keep no stack, so all pushed
+ * comparisons are dropped. Filtering less is always safe because MySQL
+ * evaluates the condition itself.
+ *
+ * Parameters : -
+ *
+ * Return value : -
+ *
+ * Globals used :
+ */
+void ha_soliddb::cond_pop()
+{
+        DBUG_ENTER("ha_soliddb::cond_pop");
+
+        n_pushed_cond = 0;
+
+        DBUG_VOID_RETURN;
+}
+
 /*#***********************************************************************\
  *
  *              ::get_auto_increment
@@ -22549,7 +23070,8 @@ i_s_soliddb_sys_sequences,
 i_s_soliddb_sys_cardinal,
 i_s_soliddb_sys_tablemodes,
 i_s_soliddb_sys_info,
-i_s_soliddb_sys_blobs
+i_s_soliddb_sys_blobs,
+i_s_soliddb_sys_defrag
 mysql_declare_plugin_end;
 
 #endif /* MYSQL_VERSION_ID >= 50100 */ 
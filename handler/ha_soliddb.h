@@ -160,6 +160,19 @@ typedef struct st_soliddb_share {
 #define MYSQL_THD THD*
 #endif
 
+/*
+  Integer comparison pushed down by ::cond_push. Pushed comparisons
+  are evaluated against index entries before the data tuple is read.
+*/
+
+#define SOLIDDB_MAX_PUSHED_COND 8
+
+typedef struct st_soliddb_pushed_cond {
+  uint pc_fieldno;                        /* Field index in table */
+  uint pc_relop;                          /* RS_RELOP_* with field on left */
+  longlong pc_value;                      /* Constant value */
+} SOLIDDB_PUSHED_COND;
+
 /*
   Class definition for the storage engine
 */
@@ -181,6 +194,9 @@ class ha_soliddb: public handler
   bool extra_replace_duplicate;
   bool extra_update_duplicate;
 
+  SOLIDDB_PUSHED_COND pushed_cond[SOLIDDB_MAX_PUSHED_COND];
+  uint n_pushed_cond;                     /* Number of pushed_cond entries */
+
 #if MYSQL_VERSION_ID >= 50100
   Table_flags int_table_flags;
 #else
@@ -418,6 +434,10 @@ public:
   int final_drop_index(TABLE *table_arg);
 
   int reset();
+
+  const COND* cond_push(const COND* cond);
+
+  void cond_pop();
 #endif /* MYSQL_VERSION_ID >= 50100 */
 
 #ifdef SS_MULTI_RANGE_READ_SUPPORTED
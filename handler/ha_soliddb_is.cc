@@ -1053,6 +1053,110 @@ static ST_FIELD_INFO soliddb_sys_blobs_fields[]=
         END_OF_ST_FIELD_INFO
 };
 
+static ST_FIELD_INFO soliddb_sys_defrag_fields[]=
+{
+#define IDX_DEFRAG_ACTIVE		0
+        {STRUCT_FLD(field_name,         "ACTIVE"),
+         STRUCT_FLD(field_length,       4),
+         STRUCT_FLD(field_type,         MYSQL_TYPE_LONG),
+         STRUCT_FLD(value,              0),
+         STRUCT_FLD(field_flags,        0),
+         STRUCT_FLD(old_name,           "Active"),
+         STRUCT_FLD(open_method,        SKIP_OPEN_TABLE)},
+
+#define IDX_DEFRAG_FILE_BLOCKS		1
+        {STRUCT_FLD(field_name,         "FILE_BLOCKS"),
+         STRUCT_FLD(field_length,       8),
+         STRUCT_FLD(field_type,         MYSQL_TYPE_LONGLONG),
+         STRUCT_FLD(value,              0),
+         STRUCT_FLD(field_flags,        0),
+         STRUCT_FLD(old_name,           "File size in blocks"),
+         STRUCT_FLD(open_method,        SKIP_OPEN_TABLE)},
+
+#define IDX_DEFRAG_LAST_BUSY_BLOCK		2
+        {STRUCT_FLD(field_name,         "LAST_BUSY_BLOCK"),
+         STRUCT_FLD(field_length,       8),
+         STRUCT_FLD(field_type,         MYSQL_TYPE_LONGLONG),
+         STRUCT_FLD(value,              0),
+         STRUCT_FLD(field_flags,        0),
+         STRUCT_FLD(old_name,           "Last allocated block"),
+         STRUCT_FLD(open_method,        SKIP_OPEN_TABLE)},
+
+#define IDX_DEFRAG_FIRST_FREE_BLOCK		3
+        {STRUCT_FLD(field_name,         "FIRST_FREE_BLOCK"),
+         STRUCT_FLD(field_length,       8),
+         STRUCT_FLD(field_type,         MYSQL_TYPE_LONGLONG),
+         STRUCT_FLD(value,              0),
+         STRUCT_FLD(field_flags,        0),
+         STRUCT_FLD(old_name,           "First free block"),
+         STRUCT_FLD(open_method,        SKIP_OPEN_TABLE)},
+
+#define IDX_DEFRAG_FREE_BLOCKS		4
+        {STRUCT_FLD(field_name,         "FREE_BLOCKS"),
+         STRUCT_FLD(field_length,       8),
+         STRUCT_FLD(field_type,         MYSQL_TYPE_LONGLONG),
+         STRUCT_FLD(value,              0),
+         STRUCT_FLD(field_flags,        0),
+         STRUCT_FLD(old_name,           "Free blocks"),
+         STRUCT_FLD(open_method,        SKIP_OPEN_TABLE)},
+
+#define IDX_DEFRAG_SCAN_POSITION		5
+        {STRUCT_FLD(field_name,         "SCAN_POSITION"),
+         STRUCT_FLD(field_length,       8),
+         STRUCT_FLD(field_type,         MYSQL_TYPE_LONGLONG),
+         STRUCT_FLD(value,              0),
+         STRUCT_FLD(field_flags,        0),
+         STRUCT_FLD(old_name,           "Next block examined"),
+         STRUCT_FLD(open_method,        SKIP_OPEN_TABLE)},
+
+#define IDX_DEFRAG_BLOCKS_SCANNED		6
+        {STRUCT_FLD(field_name,         "BLOCKS_SCANNED"),
+         STRUCT_FLD(field_length,       8),
+         STRUCT_FLD(field_type,         MYSQL_TYPE_LONGLONG),
+         STRUCT_FLD(value,              0),
+         STRUCT_FLD(field_flags,        0),
+         STRUCT_FLD(old_name,           "Blocks examined"),
+         STRUCT_FLD(open_method,        SKIP_OPEN_TABLE)},
+
+#define IDX_DEFRAG_NODES_MOVED		7
+        {STRUCT_FLD(field_name,         "NODES_MOVED"),
+         STRUCT_FLD(field_length,       8),
+         STRUCT_FLD(field_type,         MYSQL_TYPE_LONGLONG),
+         STRUCT_FLD(value,              0),
+         STRUCT_FLD(field_flags,        0),
+         STRUCT_FLD(old_name,           "Nodes moved"),
+         STRUCT_FLD(open_method,        SKIP_OPEN_TABLE)},
+
+#define IDX_DEFRAG_BLOCKS_SHRUNK		8
+        {STRUCT_FLD(field_name,         "BLOCKS_SHRUNK"),
+         STRUCT_FLD(field_length,       8),
+         STRUCT_FLD(field_type,         MYSQL_TYPE_LONGLONG),
+         STRUCT_FLD(value,              0),
+         STRUCT_FLD(field_flags,        0),
+         STRUCT_FLD(old_name,           "Blocks cut from file end"),
+         STRUCT_FLD(open_method,        SKIP_OPEN_TABLE)},
+
+#define IDX_DEFRAG_FREE_RANGES		9
+        {STRUCT_FLD(field_name,         "FREE_RANGES"),
+         STRUCT_FLD(field_length,       8),
+         STRUCT_FLD(field_type,         MYSQL_TYPE_LONGLONG),
+         STRUCT_FLD(value,              0),
+         STRUCT_FLD(field_flags,        0),
+         STRUCT_FLD(old_name,           "Contiguous free ranges"),
+         STRUCT_FLD(open_method,        SKIP_OPEN_TABLE)},
+
+#define IDX_DEFRAG_FREE_MAX_RANGE		10
+        {STRUCT_FLD(field_name,         "FREE_MAX_RANGE"),
+         STRUCT_FLD(field_length,       8),
+         STRUCT_FLD(field_type,         MYSQL_TYPE_LONGLONG),
+         STRUCT_FLD(value,              0),
+         STRUCT_FLD(field_flags,        0),
+         STRUCT_FLD(old_name,           "Blocks in largest free range"),
+         STRUCT_FLD(open_method,        SKIP_OPEN_TABLE)},
+
+        END_OF_ST_FIELD_INFO
+};
+
 static int soliddb_sys_tables_fill(MYSQL_THD thd, TABLE_LIST* tables, COND* cond);
 static int soliddb_sys_columns_fill(MYSQL_THD thd, TABLE_LIST* tables, COND* cond);
 static int soliddb_sys_columns_aux_fill(MYSQL_THD thd, TABLE_LIST* tables, COND* cond);
@@ -1068,6 +1172,7 @@ static int soliddb_sys_tablemodes_fill(MYSQL_THD thd, TABLE_LIST* tables, COND*
 static int soliddb_sys_collations_fill(MYSQL_THD thd, TABLE_LIST* tables, COND* cond);
 static int soliddb_sys_info_fill(MYSQL_THD thd, TABLE_LIST* tables, COND* cond);
 static int soliddb_sys_blobs_fill(MYSQL_THD thd, TABLE_LIST* tables, COND* cond);
+static int soliddb_sys_defrag_fill(MYSQL_THD thd, TABLE_LIST* tables, COND* cond);
 
 static struct st_mysql_information_schema       i_s_info =
 {
@@ -1869,6 +1974,59 @@ struct st_mysql_plugin      i_s_soliddb_sys_blobs=
         STRUCT_FLD(flags, 0UL),
 };
 
+struct st_mysql_plugin      i_s_soliddb_sys_defrag=
+{
+        /* the plugin type (a MYSQL_XXX_PLUGIN value) */
+        /* int */
+        STRUCT_FLD(type, MYSQL_INFORMATION_SCHEMA_PLUGIN),
+
+        /* pointer to type-specific plugin descriptor */
+        /* void* */
+        STRUCT_FLD(info, &i_s_info),
+
+        /* plugin name */
+        /* const char* */
+        STRUCT_FLD(name, "SOLIDDB_SYS_DEFRAG"),
+
+        /* plugin author (for SHOW PLUGINS) */
+        /* const char* */
+        STRUCT_FLD(author, plugin_author),
+
+        /* general descriptive text (for SHOW PLUGINS) */
+        /* const char* */
+        STRUCT_FLD(descr, "solidDB online defragmentation progress."),
+
+        /* the plugin license (PLUGIN_LICENSE_XXX) */
+        /* int */
+        STRUCT_FLD(license, PLUGIN_LICENSE_GPL),
+
+        /* the function to invoke when plugin is loaded */
+        /* int (*)(void*); */
+        STRUCT_FLD(init, soliddb_init_sys_defrag),
+
+        /* the function to invoke when plugin is unloaded */
+        /* int (*)(void*); */
+        STRUCT_FLD(deinit, soliddb_deinit_is),
+
+        /* plugin version (for SHOW PLUGINS) */
+        /* unsigned int */
+        STRUCT_FLD(version, 0x0100),
+
+        /* struct st_mysql_show_var* */
+        STRUCT_FLD(status_vars, NULL),
+
+        /* struct st_mysql_sys_var** */
+        STRUCT_FLD(system_vars, NULL),
+
+        /* reserved for dependency checking */
+        /* void* */
+        STRUCT_FLD(__reserved1, NULL),
+
+        /* Plugin flags */
+        /* unsigned long */
+        STRUCT_FLD(flags, 0UL),
+};
+
 /*#***********************************************************************\
  *
  *              soliddb_sys_tables_fill
@@ -2966,6 +3124,66 @@ static int soliddb_sys_blobs_fill(
         DBUG_RETURN(0);
 }
 
+/*#***********************************************************************\
+ *
+ *              soliddb_sys_defrag_fill
+ *
+ * Fill INFORMATION_SCHEMA.SOLIDDB_SYS_DEFRAG table
+ *
+ * Parameters :
+ *
+ *     MYSQL_THD    thd, in, use, MySQL thread
+ *     TABLE_LIST   tables, in, use, MySQL table
+ *     COND*        cond, in, not used
+ *
+ * Return value : 0 or error code
+ *
+ * Globals used :
+ */
+static int soliddb_sys_defrag_fill(
+        MYSQL_THD   thd,
+        TABLE_LIST* tables,
+        COND*       cond)
+{
+        SOLID_CONN*   con;
+        TABLE *table = tables->table;
+        dbe_defragstat_t dfs;
+
+        DBUG_ENTER("soliddb_sys_defrag_fill");
+        SS_PUSHNAME("soliddb_sys_defrag_fill");
+        con = (SOLID_CONN*) get_solid_ha_data_connection(legacy_soliddb_hton, thd);
+
+        CHK_CONN(con);
+
+        dbe_db_getdefragstat((dbe_db_t*)rs_sysi_db(con->sc_cd), &dfs);
+
+        if (!dfs.dfs_supported) {
+            /* Not a globally sorted free list, nothing can be moved. */
+            SS_POPNAME;
+            DBUG_RETURN(0);
+        }
+
+        table->field[IDX_DEFRAG_ACTIVE]->store((longlong)dfs.dfs_active, FALSE);
+        table->field[IDX_DEFRAG_FILE_BLOCKS]->store((longlong)dfs.dfs_filesize, TRUE);
+        table->field[IDX_DEFRAG_LAST_BUSY_BLOCK]->store((longlong)dfs.dfs_lastbusy, TRUE);
+        table->field[IDX_DEFRAG_FIRST_FREE_BLOCK]->store((longlong)dfs.dfs_firstfree, TRUE);
+        table->field[IDX_DEFRAG_FREE_BLOCKS]->store((longlong)dfs.dfs_freeblocks, TRUE);
+        table->field[IDX_DEFRAG_SCAN_POSITION]->store((longlong)dfs.dfs_scanpos, TRUE);
+        table->field[IDX_DEFRAG_BLOCKS_SCANNED]->store((longlong)dfs.dfs_nscanned, TRUE);
+        table->field[IDX_DEFRAG_NODES_MOVED]->store((longlong)dfs.dfs_nmoved, TRUE);
+        table->field[IDX_DEFRAG_BLOCKS_SHRUNK]->store((longlong)dfs.dfs_nshrunk, TRUE);
+        table->field[IDX_DEFRAG_FREE_RANGES]->store((longlong)dfs.dfs_freeranges, TRUE);
+        table->field[IDX_DEFRAG_FREE_MAX_RANGE]->store((longlong)dfs.dfs_freemaxrange, TRUE);
+
+        if (schema_table_store_record(thd, table)) {
+            SS_POPNAME;
+            DBUG_RETURN(1);
+        }
+
+        SS_POPNAME;
+        DBUG_RETURN(0);
+}
+
 
 /*#***********************************************************************\
  *
@@ -3357,6 +3575,32 @@ int soliddb_init_sys_blobs(void *p)
         DBUG_RETURN(0);
 }
 
+/*#***********************************************************************\
+ *
+ *              soliddb_init_sys_defrag
+ *
+ * Init INFORMATION_SCHEMA.SOLIDDB_SYS_DEFRAG table
+ *
+ * Parameters :
+ *
+ *    void* p, in, use, ST_SCHEMA_TABLE pointer
+ *
+ * Return value : 0
+ *
+ * Globals used :
+ */
+int soliddb_init_sys_defrag(void *p)
+{
+        DBUG_ENTER("soliddb_init_sys_defrag");
+        ST_SCHEMA_TABLE *schema = (ST_SCHEMA_TABLE *)p;
+        ss_dassert(schema != NULL);
+
+        schema->fields_info = soliddb_sys_defrag_fields;
+        schema->fill_table  = soliddb_sys_defrag_fill;
+        
+        DBUG_RETURN(0);
+}
+
 /*#***********************************************************************\
  *
  *              soliddb_deinit_is
@@ -58,6 +58,7 @@ extern struct st_mysql_plugin   i_s_soliddb_sys_cardinal;
 extern struct st_mysql_plugin   i_s_soliddb_sys_tablemodes;
 extern struct st_mysql_plugin   i_s_soliddb_sys_info;
 extern struct st_mysql_plugin   i_s_soliddb_sys_blobs;
+extern struct st_mysql_plugin   i_s_soliddb_sys_defrag;
 
 int soliddb_init_sys_tables(void *p);
 int soliddb_init_sys_columns(void *p);
@@ -74,6 +75,7 @@ int soliddb_init_sys_tablemodes(void *p);
 int soliddb_init_sys_collations(void *p);
 int soliddb_init_sys_info(void *p);
 int soliddb_init_sys_blobs(void *p);
+int soliddb_init_sys_defrag(void *p);
 static int soliddb_deinit_is(void *p);
 
 
@@ -111,6 +111,9 @@ typedef struct {
         size_t  dbst_ind_mergeact;      /* Is merge active?. */
         size_t  dbst_ind_filesize;      /* Index (database) file size in bytes. */
         size_t  dbst_ind_freesize;
+        size_t  dbst_ind_nearalloccnt;  /* Count of blocks allocated near
+                                           a sibling. */
+        size_t  dbst_ind_faralloccnt;   /* Count of failed near allocations. */
 
         size_t  dbst_log_writecnt;      /* Count of log writes. */
         size_t  dbst_log_writecntsincecp; /* Count of log writes after last checkpoint. */
@@ -122,6 +125,23 @@ typedef struct {
         float   dbst_cp_thruput;        /* Disk thruput of checkpoint writing. */
 } dbe_dbstat_t;
 
+/* Online defragmentation progress. Block counts are in file blocks. */
+typedef struct {
+        bool    dfs_active;             /* Is a defragmentation step running? */
+        bool    dfs_supported;          /* Is the free list globally sorted? */
+        ulong   dfs_filesize;           /* Logical file size. */
+        ulong   dfs_lastbusy;           /* Highest allocated block. */
+        ulong   dfs_firstfree;          /* Lowest free block. */
+        ulong   dfs_freeblocks;         /* Count of free blocks. */
+        ulong   dfs_scanpos;            /* Next block examined. */
+        ulong   dfs_nscanned;           /* Count of blocks examined. */
+        ulong   dfs_nmoved;             /* Count of tree nodes moved. */
+        ulong   dfs_nshrunk;            /* Count of blocks cut from the file
+                                           end. */
+        ulong   dfs_freeranges;         /* Count of contiguous free ranges. */
+        ulong   dfs_freemaxrange;       /* Blocks in the largest free range. */
+} dbe_defragstat_t;
+
 typedef enum {
         DBE_DB_OPEN_NONE,
         DBE_DB_OPEN_DBFILE,
@@ -195,6 +215,17 @@ struct dbe_db_st {
         bool            db_changed;
         bool            db_force_checkpoint;
         int             db_final_checkpoint;    /* 0=No, 1=Pending, 2=Started */
+        bool            db_defragactive;        /* Defragmentation step running. */
+        su_daddr_t      db_defragpos;           /* Next block to examine,
+                                                   SU_DADDR_NULL = file end. */
+        su_rbt_t*       db_defragnodes;         /* Candidates of the current
+                                                   pass, NULL = no pass. */
+        bool            db_defragmore;          /* More candidates below
+                                                   db_defragpos. */
+        dbe_cpnum_t     db_defragwaitcpnum;     /* Checkpoint in which
+                                                   a candidate was skipped. */
+        ulong           db_defragnscanned;
+        ulong           db_defragnmoved;
         SsSemT*         db_changedsem;
         SsSemT*         db_sem;
         int             db_ddopactivecnt;       /* Number of active dd operation */
@@ -957,6 +988,15 @@ void dbe_db_getstat(
         dbe_db_t* db,
         dbe_dbstat_t* p_dbst);
 
+dbe_ret_t dbe_db_defragstep(
+        dbe_db_t* db,
+        uint maxblocks,
+        ulong* p_nmoved);
+
+void dbe_db_getdefragstat(
+        dbe_db_t* db,
+        dbe_defragstat_t* p_dfs);
+
 void dbe_db_setlogerrorhandler(
         dbe_db_t* db,
         void (*errorfunc)(void*),
@@ -276,6 +276,10 @@ struct dbe_trx_st {
         bool*           trx_openflag;
         trx_flags_t     trx_flags;
         dbe_trxinfo_t*  trx_infocache;
+        void*           trx_chkcache;       /* Free list of check records
+                                               kept over transactions that
+                                               use the same trx buffer. */
+        int             trx_chkcachelen;
         ss_debug(int    trx_thrid;)
 
         dstr_t          trx_uniquerrorkeyvalue;
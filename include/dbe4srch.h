@@ -131,6 +131,21 @@ struct dbe_search_st {
         bool                    sea_isupdatable;
         bool                    sea_versionedpessimistic;
         dynvtpl_t               sea_posdvtpl;
+        rs_vbuf_t*              sea_batchvb;    /* Row block filled by
+                                                   dbe_search_nextorprev_n,
+                                                   or NULL. */
+        dbe_tref_t**            sea_batchtref;  /* Tuple references of the
+                                                   rows in sea_batchvb,
+                                                   one per vbuf slot. */
+        ulong                   sea_batchntref; /* Length of sea_batchtref,
+                                                   the row block may be
+                                                   released before the
+                                                   search. */
+        bool                    sea_batchnextp; /* Direction of the rows
+                                                   in sea_batchvb. */
+        ulong                   sea_batchnskip; /* Rows still to be stepped
+                                                   over after a direction
+                                                   change. */
 };
 
 /*
@@ -225,6 +240,12 @@ dbe_ret_t dbe_search_nextorprev_disk(
         bool nextp,
         rs_tval_t** p_tval);
 
+dbe_ret_t dbe_search_nextorprev_n(
+        dbe_search_t* search,
+        dbe_trx_t* trx,
+        bool nextp,
+        rs_vbuf_t* vb);
+
 dbe_ret_t dbe_search_gotoend(
         dbe_search_t* search,
         dbe_trx_t* trx);
@@ -61,6 +61,11 @@ dbe_ret_t dbe_datasea_search(
         dbe_trxid_t stmttrxid,
         dbe_srk_t** srk);
 
+void dbe_datasea_prefetch(
+        dbe_datasea_t* datasea,
+        vtpl_t** refvtpls,
+        int nrefvtpl);
+
 void dbe_datasea_setlongseqsea(
         dbe_datasea_t* datasea);
 
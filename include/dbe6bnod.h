@@ -314,6 +314,11 @@ bool dbe_bnode_getaddrinkey(
         dbe_bkey_t* k,
         su_daddr_t* p_addr);
 
+void dbe_bnode_getchildkeys(
+        dbe_bnode_t* n,
+        void (*childfun)(void* ctx, dbe_bkey_t* k),
+        void* ctx);
+
 su_daddr_t dbe_bnode_searchnode(
         dbe_bnode_t* n,
         dbe_bkey_t* k,
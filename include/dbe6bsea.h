@@ -100,7 +100,14 @@ struct dbe_btrsea_st {
                                                   during a merge search.*/
         long                    bs_nmergeremoved;
         long                    bs_nreadleafs;
-        uint                    bs_readaheadsize;
+        uint                    bs_readaheadsize; /* Current read-ahead
+                                                     window in leafs. */
+        uint                    bs_readaheadmax;  /* Upper limit for the
+                                                     window, 0 if off. */
+        long                    bs_readaheadleafs;/* bs_nreadleafs at the
+                                                     last window check. */
+        long                    bs_prefetchused;  /* Cache prefetch counters */
+        long                    bs_prefetchwasted;/* at the last check. */
         dbe_keypos_t            bs_keypos;
         dbe_ret_t               bs_mergerc;     /* Return code used during
                                                    merge. */
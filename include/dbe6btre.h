@@ -32,6 +32,7 @@
 #include <su0list.h>
 #include <su0gate.h>
 #include <su0prof.h>
+#include <su0rbtr.h>
 
 #include <rs0sysi.h>
 
@@ -71,6 +72,16 @@ typedef struct {
         dbe_dynbkey_t pi_secondkey;
 } dbe_pathinfo_t;
 
+/* Online defragmentation candidate node.
+ */
+typedef struct {
+        su_daddr_t      rn_addr;    /* Node address when collected. */
+        uint            rn_level;   /* Node level. */
+        dbe_dynbkey_t   rn_key;     /* Key value leading to the node. */
+        uint            rn_nretry;  /* Times skipped because the node was
+                                       changed in the current checkpoint. */
+} dbe_btree_relocnode_t;
+
 dbe_btree_t* dbe_btree_init(
         dbe_gobj_t* go,
         su_daddr_t root_addr,
@@ -109,6 +120,17 @@ dbe_ret_t dbe_btree_nodepath_relocate_getnewaddr(
         su_daddr_t* p_newaddr,
         dbe_info_t* info);
 
+su_rbt_t* dbe_btree_getrelocatenodes(
+        dbe_btree_t* b,
+        su_daddr_t minaddr,
+        su_daddr_t maxaddr,
+        uint maxnodes);
+
+dbe_ret_t dbe_btree_relocatenode(
+        dbe_btree_t* b,
+        dbe_btree_relocnode_t* rn,
+        su_daddr_t* p_newaddr);
+
 void dbe_btree_nodepath_done(
         su_list_t* path);
 
@@ -197,6 +219,11 @@ bool dbe_btree_exists(
         dbe_btree_t* b,
         dbe_bkey_t* k);
 
+int dbe_btree_prefetchleaves(
+        dbe_btree_t* b,
+        vtpl_t** vtpls,
+        int nvtpl);
+
 dbe_ret_t dbe_btree_readpathforwrite(
         dbe_btree_t* b,
         dbe_bkey_t* k);
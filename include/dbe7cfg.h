@@ -108,6 +108,8 @@ extern bool dbe_cfg_versionedpessimisticreadcommitted;
 extern bool dbe_cfg_versionedpessimisticrepeatableread;
 extern long dbe_cfg_readlevelmaxtime;
 extern int  dbe_cfg_maxmergeparts;
+extern int  dbe_cfg_maxmergetasks;
+extern int  dbe_cfg_recoverythreads;
 extern bool dbe_cfg_splitpurge;
 extern bool dbe_cfg_mergecleanup;
 extern bool dbe_cfg_usenewbtreelocking;
@@ -115,8 +117,9 @@ extern bool dbe_cfg_userandomkeysampleread;
 extern bool dbe_cfg_singledeletemark;
 extern bool dbe_cfg_startupforcemerge;
 extern bool dbe_cfg_fastdeadlockdetect;
-extern bool dbe_cfg_deadlockdetectmaxdepth;
-extern bool dbe_cfg_deadlockdetectmaxlocks;
+extern int  dbe_cfg_deadlockdetectmaxdepth;
+extern int  dbe_cfg_deadlockdetectmaxlocks;
+extern long dbe_cfg_deadlockdetectinterval;
 extern bool dbe_cfg_physicaldroptable;
 extern int  dbe_cfg_relaxedbtreelocking;
 
@@ -406,6 +409,10 @@ bool dbe_cfg_getuseiothreads(
         dbe_cfg_t* dbe_cfg,
         bool* p_useiothreads);
 
+bool dbe_cfg_getuseiouring(
+        dbe_cfg_t* dbe_cfg,
+        bool* p_useiouring);
+
 bool dbe_cfg_getpessimistic(
         dbe_cfg_t* dbe_cfg,
         bool* p_pessimistic);
@@ -475,6 +482,18 @@ bool dbe_cfg_getidxmaxpagesemcount(
         dbe_cfg_t* dbe_cfg,
         ulong* p_maxpagesemcnt);
 
+bool dbe_cfg_getidxcachelrupartitions(
+        dbe_cfg_t* dbe_cfg,
+        uint* p_nlru);
+
+bool dbe_cfg_getidxcachepolicy(
+        dbe_cfg_t* dbe_cfg,
+        uint* p_policy);
+
+bool dbe_cfg_getidxcacheprobationtime(
+        dbe_cfg_t* dbe_cfg,
+        long* p_probationtime);
+
 bool dbe_cfg_getdefaultstoreismemory(
         dbe_cfg_t* dbe_cfg,
         bool* p_defaultstoreismemory);
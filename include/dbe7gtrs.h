@@ -102,6 +102,8 @@ struct dbe_gtrs_st {
         su_rbt_t*       gtrs_abortedrelhs_rbt;
         gtrs_activetrx_t*   gtrs_atcache;
         ulong           gtrs_ncachedats;
+        dbe_trxnum_t    gtrs_mergetrxnum;     /* Merge level last published
+                                                 to the counter object. */
         ss_debug(dbe_trxnum_t gtrs_lastcommittrxnum;)
         ss_debug(dbe_trxnum_t gtrs_lastmaxtrxnum;)
         ss_debug(dbe_trxid_t  gtrs_lastaborttrxid;)
@@ -68,6 +68,19 @@ struct dbe_trxbufslot_st {
         SsFlatMutexT     tbs_sem;
 };
 
+/* Number of mutex protected slots in the transaction buffer. Every
+ * visibility check in a search locks one slot, so use enough of them
+ * to keep concurrent searches from colliding.
+ */
+#define DBE_TRXBUF_NBUFSLOTS    64
+
+/* Buffer slot padded so that two slots never share a cache line.
+ */
+typedef union {
+        dbe_trxbufslot_t ps_slot;
+        char             ps_pad[128];
+} dbe_trxbufpaddedslot_t;
+
 /* ---------------------------------------------------------------
  *
  */
@@ -87,6 +100,7 @@ struct dbe_trxbuf_st {
                                                 transactions are visible. */
         bool             tb_usevisiblealltrxid;
         dbe_trxbufslot_t** tb_tbslottable;
+        dbe_trxbufpaddedslot_t* tb_tbslotarray; /* Storage for slots. */
         uint             tb_nbufslots;
 
         SsQsemT**        tb_trxinfo_sem;
@@ -47,9 +47,13 @@ typedef enum {
         DBE_CACHE_READWRITE_IFHIT,
         DBE_CACHE_PREFETCH,     /* Used by preflusher only, translated to
                                    DBE_CACHE_READONLY */
-        DBE_CACHE_READWRITE_NOCOPY /* The slot is used for both reading and
+        DBE_CACHE_READWRITE_NOCOPY, /* The slot is used for both reading and
                                       writing. Do not make a copy of
                                       read-only block. */
+        DBE_CACHE_PREFETCHBATCH /* Used by I/O manager only. Returns NULL
+                                   if the page is in cache, otherwise
+                                   reserves the slot exclusively without
+                                   reading it. */
 } dbe_cache_reachmode_t;
 
 typedef enum {
@@ -73,6 +77,32 @@ typedef enum {
                                    position (used by preflusher only) */
 } dbe_cache_releasemode_t;
 
+/* Cache page replacement policy.
+ */
+typedef enum {
+        DBE_CACHE_POLICY_LRU,       /* Priority LRU, every released page
+                                       goes to the high priority LRU unless
+                                       released with LASTUSE hint. */
+        DBE_CACHE_POLICY_MIDPOINT   /* Midpoint insertion, page read from
+                                       disk is kept in low priority
+                                       (probation) LRU until it is
+                                       referenced again after the probation
+                                       time has elapsed since it was read. */
+} dbe_cache_policy_t;
+
+/* Max number of LRU partitions in cache. */
+#define DBE_CACHE_MAXLRU        64
+
+/* Per LRU partition info structure.
+ */
+typedef struct {
+        long    cachelrui_nslot;     /* Number of slots in partition. */
+        long    cachelrui_ntoflush;  /* Number of slots waiting preflush. */
+        long    cachelrui_nreplace;  /* Number of victims taken. */
+        long    cachelrui_nsteal;    /* Number of victims taken for pages
+                                        hashed to another partition. */
+} dbe_cache_lruinfo_t;
+
 /* Cache info structure.
  */
 typedef struct {
@@ -84,9 +114,15 @@ typedef struct {
         int     cachei_nitem;        /* Number of cache items. */
         int     cachei_ndirty;       /* Number of dirty cache items. */
         long    cachei_nfind;        /* Number of finds done in cache. */
+        long    cachei_noptread;     /* Number of finds done without
+                                        hash bucket mutex. Approximate,
+                                        updated without the mutex. */
         long    cachei_nread;        /* Number of disk reads. */
         long    cachei_nwrite;       /* Number of disk writes. */
         long    cachei_nprefetch;
+        long    cachei_nprefetchused;  /* Prefetched pages later reached. */
+        long    cachei_nprefetchwasted;/* Prefetched pages replaced before
+                                          they were reached. */
         long    cachei_npreflush;
         long    cachei_ndirtyrelease;/* Number of releases with dirty flag */
         double  cachei_writeperfind; /* Number of disk writes per finds.(%) */
@@ -94,6 +130,12 @@ typedef struct {
 
         double  cachei_writeavoidrate;/* lazy write I/O avoidance % */
         double  cachei_readhitrate;  /* cache read hit rate % */
+        dbe_cache_policy_t cachei_policy; /* Replacement policy in use. */
+        long    cachei_nprobation;   /* Number of releases to probation LRU. */
+        long    cachei_npromote;     /* Number of pages promoted from
+                                        probation to high priority LRU. */
+        int     cachei_nlru;         /* Number of LRU partitions. */
+        dbe_cache_lruinfo_t cachei_lruinfo[DBE_CACHE_MAXLRU];
 } dbe_cache_info_t;
 
 #ifdef MME_CP_FIX
@@ -105,13 +147,14 @@ typedef struct dbe_cache_flushaddr_st {
         dbe_info_flags_t fa_infoflags;
 } dbe_cache_flushaddr_t;
 
-#define DBE_CACHE_MAXNFLUSHES  20
+#define DBE_CACHE_MAXNFLUSHES  64
 #endif
 
 dbe_cache_t* dbe_cache_init(
         su_svfil_t* svfil,
         uint nblock,
-        uint nsem);
+        uint nsem,
+        uint nlru);
 
 void dbe_cache_done(
         dbe_cache_t* cache);
@@ -245,6 +288,14 @@ bool dbe_cache_setpreflushinfo(
         uint percent,
         uint lastuseskippercent);
 
+void dbe_cache_setreplacementpolicy(
+        dbe_cache_t* cache,
+        dbe_cache_policy_t policy,
+        long probationtime);
+
+char* dbe_cache_policytostr(
+        dbe_cache_policy_t policy);
+
 void dbe_cache_addpreflushpage(
         dbe_cache_t* cache);
 
@@ -273,6 +324,12 @@ void dbe_cache_flushaddr_n(
         dbe_cache_t*            cache,
         dbe_cache_flushaddr_t*  flushes,
         ulong                   nflushes);
+
+void dbe_cache_prefetch_n(
+        dbe_cache_t*            cache,
+        su_daddr_t*             addrs,
+        ulong                   naddrs,
+        dbe_info_flags_t        infoflags);
 #endif
 
 bool dbe_cache_getflusharr(
@@ -285,6 +342,11 @@ bool dbe_cache_getflusharr(
 int dbe_cache_getnslot(
         dbe_cache_t* cache);
 
+void dbe_cache_getprefetchinfo(
+        dbe_cache_t* cache,
+        long* p_nused,
+        long* p_nwasted);
+
 char* dbe_cache_reachmodetostr(
         dbe_cache_reachmode_t mode);
 
@@ -34,6 +34,23 @@
 typedef struct dbe_freelist_st dbe_freelist_t;
 typedef struct dbe_fl_diff_iter_st dbe_fl_diff_iter_t;
 
+/* Free space fragmentation statistics. */
+typedef struct {
+        ulong   fs_nranges;     /* # of contiguous free block ranges */
+        ulong   fs_maxrange;    /* # of blocks in the largest range */
+        ulong   fs_nnearalloc;  /* # of blocks allocated near a sibling */
+        ulong   fs_nfaralloc;   /* # of near allocations that failed */
+} dbe_fl_fragstat_t;
+
+/* File end statistics for shrinking the file. */
+typedef struct {
+        su_daddr_t ss_filesize;    /* logical file size in blocks */
+        su_daddr_t ss_firstfree;   /* lowest free block */
+        su_daddr_t ss_lastbusy;    /* highest allocated block */
+        long       ss_freeblocks;  /* # of free blocks */
+        ulong      ss_nshrunk;     /* # of blocks cut from the file end */
+} dbe_fl_shrinkstat_t;
+
 dbe_freelist_t *dbe_fl_init(
         su_svfil_t *p_svfile,
         dbe_cache_t *p_cache,
@@ -69,6 +86,12 @@ su_ret_t dbe_fl_alloc(
         su_daddr_t *p_daddr,
         dbe_info_t* info);
 
+su_ret_t dbe_fl_alloc_near(
+        dbe_freelist_t *p_fl,
+        su_daddr_t near_daddr,
+        su_daddr_t *p_daddr,
+        dbe_info_t* info);
+
 su_ret_t dbe_fl_save(
         dbe_freelist_t *p_fl,
         dbe_cpnum_t next_cpnum,
@@ -96,6 +119,21 @@ su_ret_t dbe_fl_save_deferch(
 ulong dbe_fl_getfreeblocks(
         dbe_freelist_t *p_fl);
 
+void dbe_fl_getfragstat(
+        dbe_freelist_t *p_fl,
+        dbe_fl_fragstat_t* p_fragstat,
+        bool countranges);
+
+bool dbe_fl_getshrinkstat(
+        dbe_freelist_t *p_fl,
+        dbe_fl_shrinkstat_t* p_shrinkstat);
+
+void dbe_fl_shrink(
+        dbe_freelist_t *p_fl);
+
+su_ret_t dbe_fl_truncatefile(
+        dbe_freelist_t *p_fl);
+
 su_daddr_t dbe_fl_first_free(
         dbe_freelist_t *p_fl);
 
@@ -278,7 +278,8 @@ typedef enum {
         DBE_INFO_MERGE              = SU_BFLAG_BIT(4),
         DBE_INFO_CHECKPOINT         = SU_BFLAG_BIT(5),
         DBE_INFO_LRU                = SU_BFLAG_BIT(6),
-        DBE_INFO_IGNOREWRONGBNODE   = SU_BFLAG_BIT(7)
+        DBE_INFO_IGNOREWRONGBNODE   = SU_BFLAG_BIT(7),
+        DBE_INFO_DEFRAG             = SU_BFLAG_BIT(8)
 } dbe_info_flag_bits_t;
 
 typedef su_bflag_t dbe_info_flags_t;
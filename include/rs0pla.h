@@ -322,6 +322,10 @@ su_list_t* rs_pla_get_key_constraints_buf(
         void* cd,
         rs_pla_t* plan);
 
+void rs_pla_clear_key_constraints_buf(
+        void*       cd,
+        rs_pla_t*   plan);
+
 SS_INLINE su_list_t* rs_pla_get_constraints(
         void*       cd,
         rs_pla_t*   plan);
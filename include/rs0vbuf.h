@@ -104,6 +104,10 @@ SS_INLINE void rs_vbuf_rewind(
         rs_sysi_t*      cd,
         rs_vbuf_t*      vb);
 
+SS_INLINE ulong rs_vbuf_nrows(
+        rs_sysi_t*      cd,
+        rs_vbuf_t*      vb);
+
 #if defined(RS0VBUF_C) || defined(SS_USE_INLINE)
 
 SS_INLINE void rs_vbuf_reset(
@@ -270,6 +274,28 @@ SS_INLINE void rs_vbuf_rewind(
         vb->vb_nitems = 0;
 }
 
+/* Returns the number of unread rows in the buffer, not counting a
+ * possible end of set mark.
+ */
+SS_INLINE ulong rs_vbuf_nrows(
+        rs_sysi_t*      cd __attribute__ ((unused)),
+        rs_vbuf_t*      vb)
+{
+        ulong           i;
+        ulong           n;
+        ulong           nrows;
+
+        CHK_VBUF(vb);
+
+        nrows = 0;
+        for (i = vb->vb_rpos, n = 0; n < vb->vb_nitems; i = (i + 1) % vb->vb_nslots, n++) {
+            if (vb->vb_slot[i].vbs_status == RS_VB_INUSE) {
+                nrows++;
+            }
+        }
+        return nrows;
+}
+
 #endif /* defined(RS0VBUF_C) || defined(SS_USE_INLINE) */
 
 #endif /* RS0VBUF_H */
@@ -0,0 +1,106 @@
+/*************************************************************************\
+**  source       * ssatomic.h
+**  directory    * ss
+**  description  * Atomic integer and pointer operations.
+**               * 
+**               * Copyright (C) 2006 Solid Information Technology Ltd
+\*************************************************************************/
+/*
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; only under version 2 of the License.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+  USA
+*/
+
+#ifdef DOCUMENTATION
+**************************************************************************
+
+Implementation:
+--------------
+
+Thin wrappers over the compiler or operating system atomic primitives.
+All operations are full memory barriers. When the platform has no
+support SS_ATOMIC is left undefined and callers must use their mutex
+protected code paths instead.
+
+Limitations:
+-----------
+
+Operations are defined only for int, long and pointer sized values.
+
+Error handling:
+--------------
+
+None.
+
+Objects used:
+------------
+
+None.
+
+Preconditions:
+-------------
+
+None.
+
+Multithread considerations:
+--------------------------
+
+Code is fully reentrant.
+
+Example:
+-------
+
+        if (SsAtomicIntCas(&n, old, old + 1)) {
+            ...
+        }
+
+**************************************************************************
+#endif /* DOCUMENTATION */
+
+#ifndef SSATOMIC_H
+#define SSATOMIC_H
+
+#include "ssenv.h"
+#include "ssc.h"
+
+#if defined(SS_NT)
+
+#include "sswindow.h"
+
+#define SS_ATOMIC
+
+#define SsAtomicIntInc(p)           ((int)InterlockedIncrement((LONG volatile*)(p)))
+#define SsAtomicIntDec(p)           ((int)InterlockedDecrement((LONG volatile*)(p)))
+#define SsAtomicIntAdd(p, v)        ((int)InterlockedExchangeAdd((LONG volatile*)(p), (LONG)(v)) + (int)(v))
+#define SsAtomicIntCas(p, o, n)     (InterlockedCompareExchange((LONG volatile*)(p), (LONG)(n), (LONG)(o)) == (LONG)(o))
+#define SsAtomicLongAdd(p, v)       ((long)InterlockedExchangeAdd((LONG volatile*)(p), (LONG)(v)) + (long)(v))
+#define SsAtomicLongCas(p, o, n)    (InterlockedCompareExchange((LONG volatile*)(p), (LONG)(n), (LONG)(o)) == (LONG)(o))
+#define SsAtomicPtrCas(p, o, n)     (InterlockedCompareExchangePointer((PVOID volatile*)(p), (PVOID)(n), (PVOID)(o)) == (PVOID)(o))
+#define SsMemoryBarrier()           MemoryBarrier()
+
+#elif defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 1))
+
+#define SS_ATOMIC
+
+#define SsAtomicIntInc(p)           __sync_add_and_fetch((p), 1)
+#define SsAtomicIntDec(p)           __sync_sub_and_fetch((p), 1)
+#define SsAtomicIntAdd(p, v)        __sync_add_and_fetch((p), (v))
+#define SsAtomicIntCas(p, o, n)     __sync_bool_compare_and_swap((p), (o), (n))
+#define SsAtomicLongAdd(p, v)       __sync_add_and_fetch((p), (v))
+#define SsAtomicLongCas(p, o, n)    __sync_bool_compare_and_swap((p), (o), (n))
+#define SsAtomicPtrCas(p, o, n)     __sync_bool_compare_and_swap((void**)(p), (void*)(o), (void*)(n))
+#define SsMemoryBarrier()           __sync_synchronize()
+
+#endif
+
+#endif /* SSATOMIC_H */
@@ -657,6 +657,7 @@ SsEnvIdT SsEnvIdByToken(const char* token);
 char*    SsEnvTokenCurr(void);
 
 char*    SsHostname(void);
+int      SsEnvNumProcessors(void);
 
 #if defined(SS_MT)
 # define DBE_MTFLUSH /* Enables Multi-threaded flushing of db files */
@@ -666,6 +667,13 @@ char*    SsHostname(void);
 #  if defined(SS_LINUX) /* listio has been deemed working only on linux so far. */
 /* #   define SS_NATIVE_LISTIO_AVAILABLE -- disabled by apl 2006-05-26 */
 #   define SS_NATIVE_LISTIO_AVAILABLE 
+/* io_uring is tried first if the build host has its kernel headers,
+ * kernel support is checked at run time */
+#   if defined(__has_include)
+#    if __has_include(<linux/io_uring.h>)
+#     define SS_NATIVE_IOURING_AVAILABLE
+#    endif
+#   endif
 #  endif /* SS_LINUX */
 #  if !defined(SS_DLLQMEM)
 #   define SS_QMEM_THREADCTX
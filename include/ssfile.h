@@ -320,6 +320,12 @@ bool SsBAppend(
 bool SsBFlush(
         SsBFileT *bfile);
 
+#if defined(SS_LINUX) || defined(SS_SOLARIS)
+#define SS_BSYNC_AVAILABLE
+bool SsBSync(
+        SsBFileT *bfile);
+#endif /* SS_LINUX || SS_SOLARIS */
+
 long SsBSize(
         SsBFileT *bfile);
 
@@ -395,6 +401,8 @@ typedef struct {
 } SsLIOReqT;
 
 bool SsFileListIO(SsLIOReqT req_array[/*nreq*/], size_t nreq);
+void SsFileListIOSetUring(bool enable);
+void SsFileListIOGlobalDone(void);
 
 #endif /* MME_CP_FIX */
 
@@ -61,6 +61,8 @@ typedef enum {
         SS_PMON_CACHEFILEWRITE,
         SS_PMON_CACHEPREFETCH,
         SS_PMON_CACHEPREFETCHWAIT,
+        SS_PMON_CACHEPREFETCHUSED,
+        SS_PMON_CACHEPREFETCHWASTED,
         SS_PMON_CACHEPREFLUSH,
         SS_PMON_CACHELRUWRITE,
         SS_PMON_CACHESLOTWAIT,
@@ -153,6 +155,8 @@ typedef enum {
         SS_PMON_LOGFLUSHES_LOGICAL,
         SS_PMON_LOGFLUSHES_PHYSICAL,
         SS_PMON_LOGGROUPCOMMIT_WAKEUPS,
+        SS_PMON_LOGGROUPCOMMIT_LEADER,
+        SS_PMON_LOGGROUPCOMMIT_FOLLOWER,
         SS_PMON_LOGFLUSHES_FULLPAGES,
         SS_PMON_LOGWAITFLUSH,
         SS_PMON_LOGMAXWRITEQUEUERECORDS,
@@ -199,6 +203,8 @@ typedef enum {
         SS_PMON_DBE_LOCK_OK,
         SS_PMON_DBE_LOCK_TIMEOUT,
         SS_PMON_DBE_LOCK_DEADLOCK,
+        SS_PMON_DBE_LOCK_DEADLOCKCHECK,
+        SS_PMON_DBE_LOCK_DEADLOCKCHECKTIME,
         SS_PMON_DBE_LOCK_WAIT,
         SS_PMON_DBE_LOCK_COUNT,
         SS_PMON_MME_NLOCKS,
@@ -254,6 +260,18 @@ typedef enum {
         SS_PMON_STORAGEGATE_WAIT,
         SS_PMON_BONSAIGATE_WAIT,
         SS_PMON_GATE_WAIT,
+        SS_PMON_SORTER_SPILLWRITE,
+        SS_PMON_SORTER_SPILLREAD,
+        SS_PMON_SORTER_SPILLIO,
+        SS_PMON_DBNEARALLOC,
+        SS_PMON_DBFARALLOC,
+        SS_PMON_DBDEFRAGMOVE,
+        SS_PMON_DBSHRINK,
+        SS_PMON_CONDPUSH,
+        SS_PMON_KEYFILTER,
+        SS_PMON_DATASEA_PREFETCH,
+        SS_PMON_TRXCHKALLOC,
+        SS_PMON_TRXCHKREUSE,
         SS_PMON_MAXVALUES
 } ss_pmon_val_t;
 
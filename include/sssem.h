@@ -407,6 +407,7 @@ typedef enum {
         SS_SEMNUM_TU =                          18500,
         
         SS_SEMNUM_DBE =                         20000,
+        SS_SEMNUM_DBE_ROLLFWD =                 20005,
         SS_SEMNUM_DBE_DB_ACTIONGATE =           20010,
         SS_SEMNUM_DBE_DB_MERGE =                20020,
         SS_SEMNUM_DBE_PESSGATE =                20022,
@@ -457,7 +458,9 @@ typedef enum {
         SS_SEMNUM_XS_TFMGR =                    20175,
         SS_SEMNUM_XS_TFDIR =                    20176,
         SS_SEMNUM_XS_MEM =                      20177,
+        SS_SEMNUM_XS_PRESORT =                  20178,
         
+        SS_SEMNUM_DBE_LOCKMGR_WAIT =            20179,
         SS_SEMNUM_DBE_LOCKMGR =                 20180,
         SS_SEMNUM_DBE_LOG_GATE =                20190,
         SS_SEMNUM_DBE_GTRS =                    20210,
@@ -487,7 +490,9 @@ typedef enum {
 
         SS_SEMNUM_DBE_LOGWRITEQUEUE =           20432,
         SS_SEMNUM_DBE_LOGFREEQUEUE =            20434,
+        SS_SEMNUM_DBE_LOGGROUPCOMMIT =          20435,
         SS_SEMNUM_DBE_LOGMESLIST =              20436,
+        SS_SEMNUM_DBE_LOGGROUPCOMMITSYNC =      20438,
 
         SS_SEMNUM_HSBG2_TRANSPORT =             20440,
         SS_SEMNUM_HSBG2_SECOPSCAN =             20450,
@@ -651,6 +656,7 @@ typedef enum {
         SS_SEMNUM_SS_THRID =                    31110,
         SS_SEMNUM_HSBG2_LINKSEM =               31115,
         SS_SEMNUM_SS_LIB =                      31120, 
+        SS_SEMNUM_SS_FILERING =                 31130,
 
         SS_SEMNUM_LAST =                        32000 
 
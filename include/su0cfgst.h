@@ -88,6 +88,7 @@ extern char su_inifile_filename[];
 #define     SU_DBE_MERGEMINTIME     "MinMergeTime"              /* int, secs */
 #define     SU_DBE_STARTUPFORCEMERGE "StartupForceMerge"        /* yes/no */
 #define     SU_DBE_MAXMERGETASKS    "MaxMergeTasks"             /* int */
+#define     SU_DBE_RECOVERYTHREADS  "RecoveryThreads"           /* int */
 #define     SU_DBE_USERMERGE        "UserMerge"                 /* yes/no */
 #define     SU_DBE_MAXMERGEPARTS    "MaxMergeParts"             /* int */
 #define     SU_DBE_MAXUSERMERGESTEPS "MaxUserMergeSteps"        /* int */
@@ -110,6 +111,7 @@ extern char su_inifile_filename[];
 #define     SU_DBE_FASTDEADLOCKDETECT "FastDeadlockDetect"      /* int */
 #define     SU_DBE_DEADLOCKDETECTMAXDEPTH "DeadlockDetectMaxDepth" /* int */
 #define     SU_DBE_DEADLOCKDETECTMAXLOCKS "DeadlockDetectMaxLocks" /* int */
+#define     SU_DBE_DEADLOCKDETECTINTERVAL "DeadlockDetectInterval" /* int, msecs */
 #define     SU_DBE_RELBUFSIZE       "TableBufferSize"           /* int */
 #define     SU_DBE_READONLY         "ReadOnly"                  /* yes/no */
 #define     SU_DBE_DISABLEIDLEMERGE "DisableIdleMerge"          /* yes/no */
@@ -122,6 +124,7 @@ extern char su_inifile_filename[];
 #define     SU_DBE_DEFAULTSTOREISMEMORY "DefaultStoreIsMemory"  /* yes/no */
 #define     SU_DBE_NUMIOTHREADS         "IOThreads"             /* int */
 #define     SU_DBE_NUMWRITERIOTHREADS   "WriterIOThreads"       /* int */
+#define     SU_DBE_USEIOURING           "UseIOUring"            /* yes/no */
 #define     SU_DBE_DEFAULTISTRANSIENT   "DefaultIsTransient"    /* yes/no */
 #define     SU_DBE_DEFAULTISGLOBALTEMPORARY "DefaultIsGlobalTemporary" /* yes/no */
 #define     SU_DBE_USENEWTRANSWAITREADLEVEL "UseNewTransWaitReadLevel" /* yes/no */
@@ -141,6 +144,9 @@ extern char su_inifile_filename[];
 #define     SU_DBE_BLOCKSIZE        "BlockSize"             /* int, bytes */
 #define     SU_DBE_CACHESIZE        "CacheSize"             /* int, bytes */
 #define     SU_DBE_MAXPAGESEM       "MaxPageSemaphores"     /* int, count */
+#define     SU_DBE_CACHELRUPARTITIONS "CacheLRUPartitions"  /* int, count */
+#define     SU_DBE_CACHEPOLICY      "CacheReplacementPolicy" /* int, 0=LRU, 1=midpoint */
+#define     SU_DBE_CACHEPROBATIONTIME "CacheProbationTime"  /* int, milliseconds */
 #define     SU_DBE_EXTENDINCR       "ExtendIncrement"       /* blocks */
 #define     SU_DBE_MAXSEQALLOC      "MaxSequentialAllocation" /* blocks */
 #define     SU_DBE_LOGFILETEMPLATE  "FileNameTemplate"
@@ -382,6 +388,8 @@ extern char su_inifile_filename[];
 #define     SU_XS_BLOCKSIZE         "BlockSize"         /* int, bytes (0=same as indexfile blocksize */
 #define     SU_XS_FILEBUFFERING     "FileBuffering"     /* yes/no */
 #define     SU_XS_SORTERENABLED     "SorterEnabled"     /* yes/no */
+#define     SU_XS_SORTTHREADS       "SortThreads"       /* int, count (0=number of processors) */
+#define     SU_XS_SEQIOSIZE         "SequentialIOSize"  /* int, bytes (0=no extent I/O) */
 
 #define SU_SF_SUPERFASTSECTION    "Accelerator"
 
@@ -176,6 +176,7 @@ typedef enum {
         DBE_ERR_OUTOFMEMORY,            /* 10102 */
         DBE_ERR_DISKERROR,              /* 10103 */
         DBE_ERR_NOTMYSQLDATABASEFILE,   /* 10104 */
+        DBE_ERR_DEFRAGACT,              /* 10105 Defragmentation is already active. */
         
         DBE_ERR_ERROREND = 10999,
 
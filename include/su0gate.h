@@ -40,6 +40,7 @@ void su_gate_enter_exclusive(su_gate_t* gate);
 void su_gate_exit(su_gate_t* gate);
 uint su_gate_ninqueue(su_gate_t* gate);
 void su_gate_setmaxexclusive(su_gate_t* gate, int maxexclusive);
+void su_gate_setbigreader(su_gate_t* gate);
 
 #ifdef SS_SEM_DBG
 # define su_gate_init(n, c) \
@@ -68,6 +69,7 @@ void su_gate_set_thread_tracking(su_gate_t* gate, bool flag);
 #define su_gate_enter_exclusive(gate)
 #define su_gate_exit(gate)
 #define su_gate_ninqueue(gate)                      (0)
+#define su_gate_setbigreader(gate)
 #define su_gate_init_dbg(c,n, file, line)           (NULL)
 
 #endif /* SS_MT */
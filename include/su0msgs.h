@@ -190,6 +190,8 @@ typedef enum {
         DBE_MSG_LOADING_MME_D,                          /* 30235 */
         DBE_MSG_LOADING_MME_FIN_D,                      /* 30236 */
         DBE_MSG_SHRINK_STARTED,                         /* 30237 */
+        DBE_MSG_RECOVERY_PROGRESS_UUU,                  /* 30238 */
+        DBE_MSG_RECOVERY_WORKERS_D,                     /* 30239 */
 
         DBE_MSG_FAILED_TO_CREATE_NEW_DB = 30240,        /* 30240 */
         DBE_MSG_FAILED_TO_LOGON_TO_DB,                  /* 30241 */
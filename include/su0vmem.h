@@ -81,6 +81,10 @@ void su_vmem_addbuffers(
         uint nblock,
         void* blocks);  /* void**, actually */
 
+void su_vmem_setseqbuf(
+        su_vmem_t* vmem,
+        uint nblocks);
+
 void su_vmem_setinfo(
         su_vmem_t* vmem,
         su_vmem_info_t* info);
@@ -71,6 +71,14 @@ bool xs_cfg_maxrowsperstep(
         xs_cfg_t* cfg,
         uint* p_maxrows);
 
+bool xs_cfg_sortthreads(
+        xs_cfg_t* cfg,
+        uint* p_nthreads);
+
+bool xs_cfg_seqiosize(
+        xs_cfg_t* cfg,
+        size_t* p_seqiosize);
+
 bool xs_cfg_getwriteflushmode(
         xs_cfg_t* cfg,
         int* p_writeflushmode);
@@ -35,6 +35,8 @@
 
 typedef struct xs_presorter_st xs_presorter_t;
 
+extern uint xs_presorter_nthreads;
+
 xs_presorter_t* xs_presorter_init(
         rs_sysinfo_t* cd,
         rs_ttype_t* ttype,
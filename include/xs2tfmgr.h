@@ -57,7 +57,8 @@ xs_tfmgr_t* xs_tfmgr_init(
         ulong maxfiles,
         xs_mem_t* memmgr,
         ulong dbid,
-        int openflags);
+        int openflags,
+        size_t seqiosize);
 void xs_tfmgr_done(xs_tfmgr_t* tfmgr);
 bool xs_tfmgr_adddir(xs_tfmgr_t* tfmgr, char* dirname, ulong maxblocks);
 xs_tf_t* xs_tfmgr_tfinit(xs_tfmgr_t* tfmgr);
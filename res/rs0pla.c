@@ -915,6 +915,46 @@ void rs_pla_clear_tuple_reference_buf(
         }
 }
 
+/*##**********************************************************************\
+ * 
+ *              rs_pla_clear_key_constraints_buf
+ * 
+ * Frees the plan constraints in the key constraint list buffer and
+ * empties the list, so that a reused plan can be given a new set of
+ * key constraints before rs_pla_reset.
+ * 
+ * Parameters : 
+ * 
+ *      cd - in, use
+ *              client data
+ *
+ *      plan - in out, use
+ *              plan object
+ *
+ * Return value : 
+ * 
+ * Limitations  : 
+ * 
+ * Globals used : 
+ */
+void rs_pla_clear_key_constraints_buf(
+        void*       cd,
+        rs_pla_t*   plan)
+{
+        su_list_node_t* n;
+        rs_pla_cons_t*  cons;
+
+        CHECK_PLAN(plan);
+
+        n = su_list_first(&plan->pla_key_constraints_buf);
+        while (n != NULL) {
+            cons = su_listnode_getdata(n);
+            n = su_list_next(&plan->pla_key_constraints_buf, n);
+            rs_pla_cons_done(cd, cons);
+        }
+        su_list_initbuf(&plan->pla_key_constraints_buf, NULL);
+}
+
 void rs_pla_clear_tuple_reference_list(
         void*       cd,
         su_list_t*  list)
@@ -808,3 +808,42 @@ char*    SsHostname(void)
         return SsMemStrdup("UNDEFINED");
 #endif
 }
+
+/*##**********************************************************************\
+ *
+ *      SsEnvNumProcessors
+ *
+ * Gives the number of online processors on the current host.
+ *
+ * Parameters:
+ *
+ * Return value:
+ *      number of processors, at least one
+ *
+ * Limitations:
+ *
+ * Globals used:
+ */
+int SsEnvNumProcessors(void)
+{
+#if defined(SS_UNIX) && defined(_SC_NPROCESSORS_ONLN)
+        long nproc;
+
+        nproc = sysconf(_SC_NPROCESSORS_ONLN);
+        if (nproc < 1) {
+            return(1);
+        }
+        return((int)nproc);
+#elif defined(SS_NT)
+        char* nproc;
+        int n;
+
+        nproc = SsGetEnv("NUMBER_OF_PROCESSORS");
+        if (nproc == NULL || (n = atoi(nproc)) < 1) {
+            return(1);
+        }
+        return(n);
+#else
+        return(1);
+#endif
+}
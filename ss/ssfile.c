@@ -95,6 +95,18 @@ Example:
 #include <aio.h>
 #endif /* SS_NATIVE_LISTIO_AVAILABLE || SS_NATIVE_WRITEV_AVAILABLE */
 
+#if defined(MME_CP_FIX) && defined(SS_NATIVE_IOURING_AVAILABLE)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#if !defined(IORING_FEAT_RW_CUR_POS)
+/* Kernel headers older than Linux 5.6 have no IORING_OP_READ and
+ * IORING_OP_WRITE, use native list I/O only.
+ */
+#undef SS_NATIVE_IOURING_AVAILABLE
+#endif
+#endif /* MME_CP_FIX && SS_NATIVE_IOURING_AVAILABLE */
+
 #include "ssstdio.h"
 #include "ssstdlib.h"
 #include "ssstring.h"
@@ -184,6 +196,8 @@ Example:
 #include "ssmem.h"
 #include "ssdebug.h"
 #include "ssthread.h"
+#include "sssem.h"
+#include "ssatomic.h"
 
 #ifdef SS_MYSQL
 #include <su0error.h>
@@ -2669,6 +2683,58 @@ bool SsBFlush(bfile)
         }
 }
 
+#ifdef SS_BSYNC_AVAILABLE
+/*##**********************************************************************\
+ *
+ *		SsBSync
+ *
+ * Forces data written to an open file to disk. Unlike SsBFlush this
+ * does not change the file state, so it can be called concurrently
+ * with writes to the same file. The caller must make sure that the file
+ * is not closed during the call.
+ *
+ * Parameters :
+ *
+ *	bfile - in, use
+ *		pointer to SsBFileT
+ *
+ * Return value :
+ *
+ *      TRUE when OK
+ *      FALSE on error
+ *
+ * Limitations  :
+ *
+ * Globals used :
+ *
+ *      errno
+ */
+bool SsBSync(bfile)
+        SsBFileT *bfile;
+{
+        int rc;
+
+        ss_dassert(!(bfile->flags & SS_BF_READONLY));
+
+        if (bfile->flags & (SS_BF_DISKLESS | SS_BF_NOFLUSH)) {
+            return TRUE;
+        }
+        ss_pprintf_2(("SsBSync(\"%.80s\")\n", bfile->pathname));
+        SS_PMON_ADD(SS_PMON_FILEFLUSH);
+
+#ifdef SS_LINUX
+        rc = fdatasync(bfile->fd);
+#else
+        rc = fsync(bfile->fd);
+#endif
+        if (rc != 0) {
+            SsErrorMessage(FIL_MSG_FILEFLUSH_FAILED_DS,
+                errno, bfile->pathname);
+            return (FALSE);
+        }
+        return (TRUE);
+}
+#endif /* SS_BSYNC_AVAILABLE */
 
 static off_t SsBSizeAsOffT(
         SsBFileT *bfile)
@@ -3019,9 +3085,521 @@ SsBFlushTypeT SsBSetFlushType(
 
 #ifdef MME_CP_FIX
 
+/*#***********************************************************************\
+ *
+ *		SsFileListIOReqSync
+ *
+ * Executes one list I/O request using synchronous page I/O.
+ *
+ * Parameters :
+ *
+ *	req - in out, use
+ *		list I/O request, lio_naterr is set
+ *
+ * Return value :
+ *
+ *      TRUE    - success
+ *      FALSE   - failure
+ *
+ * Comments :
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+static bool SsFileListIOReqSync(SsLIOReqT* req)
+{
+        switch (req->lio_reqtype) {
+            case SS_LIO_WRITE:
+                if (SsBWritePages(
+                        req->lio_bfile,
+                        req->lio_pageaddr,
+                        req->lio_pagesize,
+                        req->lio_data,
+                        req->lio_npages))
+                {
+                    req->lio_naterr = 0;
+                    return (TRUE);
+                }
+                break;
+            case SS_LIO_READ:
+                if (SsBReadPages(
+                        req->lio_bfile,
+                        req->lio_pageaddr,
+                        req->lio_pagesize,
+                        req->lio_data,
+                        req->lio_npages) == (int)req->lio_npages)
+                {
+                    req->lio_naterr = 0;
+                    return (TRUE);
+                }
+                break;
+            default:
+                ss_rc_error(req->lio_reqtype);
+        }
+        req->lio_naterr = SsBErrno(req->lio_bfile);
+        if (req->lio_naterr == 0) {
+            req->lio_naterr = EIO;
+        }
+        return (FALSE);
+}
+
+#ifdef SS_NATIVE_IOURING_AVAILABLE
+
+/* io_uring based list I/O. Requests are submitted through a shared
+ * memory ring so that up to SSFILE_RING_DEPTH requests are in flight
+ * with a single system call and completions are reaped in batches.
+ * Rings are kept in a free list and taken by the calling thread for
+ * the duration of one SsFileListIO call. If the kernel does not
+ * support io_uring the native list I/O below is used.
+ */
+
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup     425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter     426
+#endif
+
+#define SSFILE_RING_DEPTH       64
+#define SSFILE_RING_MAXBUSY     100     /* max EAGAIN/EBUSY retries */
+
+typedef struct SsFileRingStruct SsFileRingT;
+
+struct SsFileRingStruct {
+        int                     r_fd;
+        uint                    r_depth;        /* max requests in flight */
+        void*                   r_sqmap;
+        size_t                  r_sqmapsize;
+        volatile unsigned*      r_sqhead;
+        volatile unsigned*      r_sqtail;
+        unsigned                r_sqmask;
+        unsigned*               r_sqarray;
+        struct io_uring_sqe*    r_sqes;
+        size_t                  r_sqessize;
+        void*                   r_cqmap;
+        size_t                  r_cqmapsize;
+        volatile unsigned*      r_cqhead;
+        volatile unsigned*      r_cqtail;
+        unsigned                r_cqmask;
+        struct io_uring_cqe*    r_cqes;
+        SsFileRingT*            r_next;         /* free list link */
+};
+
+static SsSemT*      ssfile_ringsem = NULL;
+static SsFileRingT* ssfile_ringfreelist = NULL;
+static bool         ssfile_ringenabled = FALSE;
+
+/*#***********************************************************************\
+ *
+ *		SsFileRingDone
+ *
+ * Releases an io_uring instance.
+ *
+ * Parameters :
+ *
+ *	ring - in, take
+ *		ring
+ *
+ * Return value :
+ *
+ * Comments :
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+static void SsFileRingDone(SsFileRingT* ring)
+{
+        if (ring->r_cqmap != NULL) {
+            munmap(ring->r_cqmap, ring->r_cqmapsize);
+        }
+        if (ring->r_sqes != NULL) {
+            munmap(ring->r_sqes, ring->r_sqessize);
+        }
+        if (ring->r_sqmap != NULL) {
+            munmap(ring->r_sqmap, ring->r_sqmapsize);
+        }
+        close(ring->r_fd);
+        SsMemFree(ring);
+}
+
+/*#***********************************************************************\
+ *
+ *		SsFileRingMap
+ *
+ * Maps one io_uring memory area.
+ *
+ * Parameters :
+ *
+ *	fd - in
+ *		ring file descriptor
+ *
+ *	size - in
+ *		area size
+ *
+ *	offset - in
+ *		area offset (IORING_OFF_*)
+ *
+ * Return value :
+ *
+ *      pointer to mapped area or NULL
+ *
+ * Comments :
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+static void* SsFileRingMap(int fd, size_t size, off_t offset)
+{
+        void* p;
+
+        p = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                 MAP_SHARED | MAP_POPULATE, fd, offset);
+        if (p == MAP_FAILED) {
+            return (NULL);
+        }
+        return (p);
+}
+
+/*#***********************************************************************\
+ *
+ *		SsFileRingInit
+ *
+ * Creates an io_uring instance.
+ *
+ * Parameters :
+ *
+ *	depth - in
+ *		number of submission queue entries
+ *
+ * Return value - give :
+ *
+ *      new ring or NULL if io_uring is not available
+ *
+ * Comments :
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+static SsFileRingT* SsFileRingInit(uint depth)
+{
+        struct io_uring_params params;
+        SsFileRingT* ring;
+        char* p;
+        int fd;
+
+        memset(&params, 0, sizeof(params));
+        fd = (int)syscall(__NR_io_uring_setup, depth, &params);
+        if (fd < 0) {
+            ss_dprintf_1(("SsFileRingInit:io_uring_setup failed, errno=%d\n", errno));
+            return (NULL);
+        }
+#ifdef IORING_FEAT_RW_CUR_POS
+        if (!(params.features & IORING_FEAT_RW_CUR_POS)) {
+            /* Kernels older than 5.6 do not have IORING_OP_READ and
+             * IORING_OP_WRITE.
+             */
+            ss_dprintf_1(("SsFileRingInit:no read and write opcodes\n"));
+            close(fd);
+            return (NULL);
+        }
+#endif /* IORING_FEAT_RW_CUR_POS */
+        ring = SsMemCalloc(1, sizeof(SsFileRingT));
+        ring->r_fd = fd;
+        ring->r_depth = params.sq_entries;
+
+        ring->r_sqmapsize = params.sq_off.array
+                          + params.sq_entries * sizeof(unsigned);
+        ring->r_sqmap = SsFileRingMap(fd, ring->r_sqmapsize, IORING_OFF_SQ_RING);
+        ring->r_sqessize = params.sq_entries * sizeof(struct io_uring_sqe);
+        ring->r_sqes = SsFileRingMap(fd, ring->r_sqessize, IORING_OFF_SQES);
+        ring->r_cqmapsize = params.cq_off.cqes
+                          + params.cq_entries * sizeof(struct io_uring_cqe);
+        ring->r_cqmap = SsFileRingMap(fd, ring->r_cqmapsize, IORING_OFF_CQ_RING);
+        if (ring->r_sqmap == NULL || ring->r_sqes == NULL || ring->r_cqmap == NULL) {
+            SsFileRingDone(ring);
+            return (NULL);
+        }
+
+        p = ring->r_sqmap;
+        ring->r_sqhead = (unsigned*)(p + params.sq_off.head);
+        ring->r_sqtail = (unsigned*)(p + params.sq_off.tail);
+        ring->r_sqmask = *(unsigned*)(p + params.sq_off.ring_mask);
+        ring->r_sqarray = (unsigned*)(p + params.sq_off.array);
+
+        p = ring->r_cqmap;
+        ring->r_cqhead = (unsigned*)(p + params.cq_off.head);
+        ring->r_cqtail = (unsigned*)(p + params.cq_off.tail);
+        ring->r_cqmask = *(unsigned*)(p + params.cq_off.ring_mask);
+        ring->r_cqes = (struct io_uring_cqe*)(p + params.cq_off.cqes);
+
+        ss_dprintf_1(("SsFileRingInit:depth=%u\n", ring->r_depth));
+        return (ring);
+}
+
+/*#***********************************************************************\
+ *
+ *		SsFileRingListIO
+ *
+ * Executes list I/O requests using io_uring. On return lio_naterr is
+ * zero for requests that completed successfully. Other requests failed,
+ * transferred less than requested or were never submitted, and must be
+ * retried with synchronous I/O. No request is in flight on return, even
+ * if the ring failed, so the request buffers can be reused.
+ *
+ * Parameters :
+ *
+ *	ring - in out, use
+ *		ring
+ *
+ *	req_array - in out, use
+ *		requests
+ *
+ *	nreq - in
+ *		number of requests
+ *
+ *	p_ringok - out
+ *		set to FALSE if the ring is not usable any more
+ *
+ *	p_disable - out
+ *		set to TRUE if io_uring is not supported and should not
+ *          be used any more
+ *
+ * Return value :
+ *
+ * Comments :
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+static void SsFileRingListIO(
+        SsFileRingT* ring,
+        SsLIOReqT req_array[/*nreq*/],
+        size_t nreq,
+        bool* p_ringok,
+        bool* p_disable)
+{
+        size_t nsubmitted = 0;
+        uint ninflight = 0;
+        unsigned tail;
+        unsigned head;
+        unsigned tosubmit;
+        unsigned waitnr;
+        uint nbusy = 0;
+        size_t i;
+        int rc;
+        int err;
+
+        *p_ringok = TRUE;
+        *p_disable = FALSE;
+
+        for (i = 0; i < nreq; i++) {
+            /* Not yet done, cleared when the request completes. */
+            req_array[i].lio_naterr = EAGAIN;
+        }
+
+        while (ninflight > 0 || (*p_ringok && nsubmitted < nreq)) {
+            if (*p_ringok) {
+                /* Fill the submission queue. */
+                tail = *ring->r_sqtail;
+                while (nsubmitted < nreq && ninflight < ring->r_depth) {
+                    SsLIOReqT* req;
+                    struct io_uring_sqe* sqe;
+                    unsigned idx;
+
+                    req = &req_array[nsubmitted];
+                    idx = tail & ring->r_sqmask;
+                    sqe = &ring->r_sqes[idx];
+                    memset(sqe, 0, sizeof(*sqe));
+                    sqe->opcode = req->lio_reqtype == SS_LIO_WRITE
+                                    ? IORING_OP_WRITE
+                                    : IORING_OP_READ;
+                    sqe->fd = req->lio_bfile->fd;
+                    sqe->addr = (unsigned long)req->lio_data;
+                    sqe->len = (unsigned)(req->lio_pagesize * req->lio_npages);
+                    sqe->off = (unsigned long long)req->lio_pageaddr
+                             * req->lio_pagesize;
+                    sqe->user_data = nsubmitted;
+                    ring->r_sqarray[idx] = idx;
+                    tail++;
+                    nsubmitted++;
+                    ninflight++;
+                }
+                SsMemoryBarrier();
+                *ring->r_sqtail = tail;
+                SsMemoryBarrier();
+                tosubmit = tail - *ring->r_sqhead;
+                /* When everything is submitted wait for all of it. */
+                waitnr = nsubmitted == nreq ? ninflight : 1;
+                rc = (int)syscall(
+                            __NR_io_uring_enter,
+                            ring->r_fd,
+                            tosubmit,
+                            waitnr,
+                            IORING_ENTER_GETEVENTS,
+                            NULL,
+                            0);
+                err = rc < 0 ? errno : 0;
+                if (err == EAGAIN || err == EBUSY) {
+                    /* The kernel is short of resources or the completion
+                     * queue is full. Completions are reaped below and the
+                     * submit is retried, but only a limited number of
+                     * times before falling back to synchronous I/O.
+                     */
+                    nbusy++;
+                    if (nbusy < SSFILE_RING_MAXBUSY) {
+                        SsThrSleep(1);
+                    }
+                } else if (rc >= 0) {
+                    nbusy = 0;
+                }
+                if (rc < 0
+                    && err != EINTR
+                    && ((err != EAGAIN && err != EBUSY)
+                        || nbusy >= SSFILE_RING_MAXBUSY))
+                {
+                    unsigned nunconsumed;
+
+                    ss_dprintf_1(("SsFileRingListIO:io_uring_enter failed, errno=%d\n", err));
+                    *p_ringok = FALSE;
+                    if (err == ENOSYS || err == EOPNOTSUPP || err == EPERM) {
+                        *p_disable = TRUE;
+                    }
+                    /* Take back the entries the kernel did not consume.
+                     * They are the last ones filled and stay marked as
+                     * not done. Entries already consumed are drained
+                     * below before returning.
+                     */
+                    SsMemoryBarrier();
+                    nunconsumed = tail - *ring->r_sqhead;
+                    *ring->r_sqtail = *ring->r_sqhead;
+                    SsMemoryBarrier();
+                    nsubmitted -= nunconsumed;
+                    ninflight -= nunconsumed;
+                }
+            } else {
+                /* Drain requests still in flight so that the kernel
+                 * does not touch the buffers after we return.
+                 */
+                rc = (int)syscall(
+                            __NR_io_uring_enter,
+                            ring->r_fd,
+                            0,
+                            ninflight,
+                            IORING_ENTER_GETEVENTS,
+                            NULL,
+                            0);
+                if (rc < 0 && errno != EINTR) {
+                    /* Completions are still posted to the mapped
+                     * queue, poll it.
+                     */
+                    SsThrSleep(1);
+                }
+            }
+
+            /* Reap all available completions. */
+            head = *ring->r_cqhead;
+            tail = *ring->r_cqtail;
+            SsMemoryBarrier();
+            while (head != tail) {
+                struct io_uring_cqe* cqe;
+                SsLIOReqT* req;
+
+                cqe = &ring->r_cqes[head & ring->r_cqmask];
+                req = &req_array[cqe->user_data];
+                if (cqe->res
+                    == (int)(req->lio_pagesize * req->lio_npages))
+                {
+                    req->lio_naterr = 0;
+                } else {
+                    /* Error or short transfer, retried by the caller. */
+                    req->lio_naterr = cqe->res < 0 ? -cqe->res : EIO;
+                }
+                head++;
+                ninflight--;
+            }
+            SsMemoryBarrier();
+            *ring->r_cqhead = head;
+        }
+}
+
+/*#***********************************************************************\
+ *
+ *		SsFileRingGet
+ *
+ * Gets a ring from the free list or creates a new one.
+ *
+ * Parameters :
+ *
+ * Return value - give :
+ *
+ *      ring or NULL if io_uring is not in use
+ *
+ * Comments :
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+static SsFileRingT* SsFileRingGet(void)
+{
+        SsFileRingT* ring;
+
+        if (!ssfile_ringenabled) {
+            return (NULL);
+        }
+        SsSemEnter(ssfile_ringsem);
+        ring = ssfile_ringfreelist;
+        if (ring != NULL) {
+            ssfile_ringfreelist = ring->r_next;
+        }
+        SsSemExit(ssfile_ringsem);
+        if (ring == NULL) {
+            ring = SsFileRingInit(SSFILE_RING_DEPTH);
+            if (ring == NULL) {
+                /* No kernel support, use native list I/O from now on. */
+                ssfile_ringenabled = FALSE;
+            }
+        }
+        return (ring);
+}
+
+/*#***********************************************************************\
+ *
+ *		SsFileRingPut
+ *
+ * Returns a ring to the free list.
+ *
+ * Parameters :
+ *
+ *	ring - in, take
+ *		ring
+ *
+ * Return value :
+ *
+ * Comments :
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+static void SsFileRingPut(SsFileRingT* ring)
+{
+        SsSemEnter(ssfile_ringsem);
+        ring->r_next = ssfile_ringfreelist;
+        ssfile_ringfreelist = ring;
+        SsSemExit(ssfile_ringsem);
+}
+
+#endif /* SS_NATIVE_IOURING_AVAILABLE */
+
 #if defined(SS_NATIVE_LISTIO_AVAILABLE)
 
-bool SsFileListIO(
+static bool SsFileListIOLocal(
         SsLIOReqT req_array[/*nreq*/],
         size_t nreq)
 {
@@ -3143,7 +3721,7 @@ bool SsFileListIO(
 
 #else /* SS_NATIVE_LISTIO_AVAILABLE */
 
-bool SsFileListIO(
+static bool SsFileListIOLocal(
         SsLIOReqT req_array[/*nreq*/],
         size_t nreq)
 {
@@ -3151,48 +3729,155 @@ bool SsFileListIO(
         size_t i;
 
         for (i = 0; i < nreq; i++) {
-            switch (req_array[i].lio_reqtype) {
-                case SS_LIO_WRITE: {
-                    bool succp2;
-                    succp2 = SsBWritePages(
-                            req_array[i].lio_bfile,
-                            req_array[i].lio_pageaddr,
-                            req_array[i].lio_pagesize,
-                            req_array[i].lio_data,
-                            req_array[i].lio_npages);
-                    if (succp2) {
-                        /* req_array[i].lio_npagesprocessed =
-                           req_array[i].lio_npages; */
-                        req_array[i].lio_naterr = 0;
-                    } else {
-                        succp = FALSE;
-                        /* req_array[i].lio_npagesprocessed = 0; */
-                        req_array[i].lio_naterr =
-                            SsBErrno(req_array[i].lio_bfile);
-                    }
-                    break;
+            if (!SsFileListIOReqSync(&req_array[i])) {
+                succp = FALSE;
+            }
+        }
+        return (succp);
+}
+#endif /* SS_NATIVE_LISTIO_AVAILABLE */
+
+#if defined(SS_NATIVE_LISTIO_AVAILABLE) || !defined(SS_NATIVE_WRITEV_AVAILABLE)
+
+/*##**********************************************************************\
+ *
+ *		SsFileListIO
+ *
+ * Executes a list of page read and write requests. All requests are
+ * started before waiting for any of them. io_uring is used when it is
+ * enabled and supported by the kernel, otherwise native list I/O.
+ *
+ * Parameters :
+ *
+ *	req_array - in out, use
+ *		requests, lio_naterr is set for every request
+ *
+ *	nreq - in
+ *		number of requests
+ *
+ * Return value :
+ *
+ *      TRUE    - all requests succeeded
+ *      FALSE   - at least one request failed
+ *
+ * Comments :
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+bool SsFileListIO(
+        SsLIOReqT req_array[/*nreq*/],
+        size_t nreq)
+{
+#ifdef SS_NATIVE_IOURING_AVAILABLE
+        SsFileRingT* ring;
+        bool ringok;
+        bool succp;
+        bool disable;
+        size_t i;
+
+        for (i = 0; i < nreq; i++) {
+            if (req_array[i].lio_bfile->flags & SS_BF_DISKLESS) {
+                return (SsFileListIOLocal(req_array, nreq));
+            }
+        }
+        ring = SsFileRingGet();
+        if (ring != NULL) {
+            SsFileRingListIO(ring, req_array, nreq, &ringok, &disable);
+            if (ringok) {
+                SsFileRingPut(ring);
+            } else {
+                SsFileRingDone(ring);
+                if (disable) {
+                    ssfile_ringenabled = FALSE;
                 }
-                case SS_LIO_READ: {
-                    int npages_read;
-                    npages_read =
-                        SsBWritePages(
-                                req_array[i].lio_bfile,
-                                req_array[i].lio_pageaddr,
-                                req_array[i].lio_pagesize,
-                                req_array[i].lio_data,
-                                req_array[i].lio_npages);
-                    if (npages_read != (int)req_array[i].lio_npages) {
+            }
+            /* Nothing is in flight any more, retry failed requests
+             * with synchronous I/O.
+             */
+            succp = TRUE;
+            for (i = 0; i < nreq; i++) {
+                if (req_array[i].lio_naterr != 0) {
+                    if (!SsFileListIOReqSync(&req_array[i])) {
                         succp = FALSE;
                     }
-                    break;
                 }
-                default:
-                    ss_rc_error(req_array[i].lio_reqtype);
             }
+            return (succp);
         }
-        return (succp);
+#endif /* SS_NATIVE_IOURING_AVAILABLE */
+        return (SsFileListIOLocal(req_array, nreq));
 }
-#endif /* SS_NATIVE_LISTIO_AVAILABLE */
+
+#endif /* SS_NATIVE_LISTIO_AVAILABLE || !SS_NATIVE_WRITEV_AVAILABLE */
+
+/*##**********************************************************************\
+ *
+ *		SsFileListIOSetUring
+ *
+ * Enables or disables io_uring for SsFileListIO. Disabled by default.
+ * Must not be called concurrently with SsFileListIO.
+ *
+ * Parameters :
+ *
+ *	enable - in
+ *		TRUE to use io_uring when the kernel supports it
+ *
+ * Return value :
+ *
+ * Comments :
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+void SsFileListIOSetUring(bool enable)
+{
+#ifdef SS_NATIVE_IOURING_AVAILABLE
+        if (enable && ssfile_ringsem == NULL) {
+            ssfile_ringsem = SsSemCreateLocal(SS_SEMNUM_SS_FILERING);
+        }
+        ssfile_ringenabled = enable;
+#else /* SS_NATIVE_IOURING_AVAILABLE */
+        SS_NOTUSED(enable);
+#endif /* SS_NATIVE_IOURING_AVAILABLE */
+}
+
+/*##**********************************************************************\
+ *
+ *		SsFileListIOGlobalDone
+ *
+ * Releases resources cached by SsFileListIO. Must not be called
+ * concurrently with SsFileListIO.
+ *
+ * Parameters :
+ *
+ * Return value :
+ *
+ * Comments :
+ *
+ * Globals used :
+ *
+ * See also :
+ */
+void SsFileListIOGlobalDone(void)
+{
+#ifdef SS_NATIVE_IOURING_AVAILABLE
+        SsFileRingT* ring;
+
+        ssfile_ringenabled = FALSE;
+        while ((ring = ssfile_ringfreelist) != NULL) {
+            ssfile_ringfreelist = ring->r_next;
+            SsFileRingDone(ring);
+        }
+        if (ssfile_ringsem != NULL) {
+            SsSemFree(ssfile_ringsem);
+            ssfile_ringsem = NULL;
+        }
+#endif /* SS_NATIVE_IOURING_AVAILABLE */
+}
+
 #endif /* MME_CP_FIX */
 
 /* EOF */
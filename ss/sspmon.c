@@ -76,6 +76,8 @@ ss_pmon_name_t ss_pmon_names[SS_PMON_MAXVALUES+1] = {
         { "Cache write",        SS_PMONTYPE_COUNTER }, /* SS_PMON_CACHEFILEWRITE */
         { "Cache prefetch",     SS_PMONTYPE_COUNTER }, /* SS_PMON_CACHEPREFETCH, */
         { "Cache prefetch wait",SS_PMONTYPE_COUNTER }, /* SS_PMON_CACHEPREFETCHWAIT, */
+        { "Cache prefetch used",SS_PMONTYPE_COUNTER }, /* SS_PMON_CACHEPREFETCHUSED */
+        { "Cache prefetch wasted", SS_PMONTYPE_COUNTER }, /* SS_PMON_CACHEPREFETCHWASTED */
         { "Cache preflush",     SS_PMONTYPE_COUNTER }, /* SS_PMON_CACHEPREFLUSH, */
         { "Cache LRU write",    SS_PMONTYPE_COUNTER }, /* SS_PMON_CACHELRUWRITE */
         { "Cache slot wait",    SS_PMONTYPE_COUNTER }, /* SS_PMON_CACHESLOTWAIT */
@@ -167,6 +169,8 @@ ss_pmon_name_t ss_pmon_names[SS_PMON_MAXVALUES+1] = {
         { "Log flush (L)",    SS_PMONTYPE_COUNTER }, /* SS_PMON_LOGFLUSHES_LOGICAL */
         { "Log flush (P)",    SS_PMONTYPE_COUNTER }, /* SS_PMON_LOGFLUSHES_PHYSICAL */
         { "Log grpcommwkup",  SS_PMONTYPE_COUNTER }, /* SS_PMON_LOGGROUPCOMMIT_WAKEUPS */
+        { "Log grpcomm leader", SS_PMONTYPE_COUNTER }, /* SS_PMON_LOGGROUPCOMMIT_LEADER */
+        { "Log grpcomm follower",SS_PMONTYPE_COUNTER }, /* SS_PMON_LOGGROUPCOMMIT_FOLLOWER */
         { "Log flush full",   SS_PMONTYPE_COUNTER }, /* SS_PMON_LOGFLUSHES_FULLPAGES */
         { "Log wait flush",   SS_PMONTYPE_COUNTER }, /* SS_PMON_LOGWAITFLUSH */
         { "Log writeq full rec",SS_PMONTYPE_COUNTER }, /* SS_PMON_LOGMAXWRITEQUEUERECORDS */
@@ -213,6 +217,8 @@ ss_pmon_name_t ss_pmon_names[SS_PMON_MAXVALUES+1] = {
         { "Lock ok",            SS_PMONTYPE_COUNTER }, /* SS_PMON_DBE_LOCK_OK */
         { "Lock timeout",       SS_PMONTYPE_COUNTER }, /* SS_PMON_DBE_LOCK_TIMEOUT */
         { "Lock deadlock",      SS_PMONTYPE_COUNTER }, /* SS_PMON_DBE_LOCK_DEADLOCK */
+        { "Lock deadlock check",SS_PMONTYPE_COUNTER }, /* SS_PMON_DBE_LOCK_DEADLOCKCHECK */
+        { "Lock deadlock msec", SS_PMONTYPE_COUNTER }, /* SS_PMON_DBE_LOCK_DEADLOCKCHECKTIME */
         { "Lock wait",          SS_PMONTYPE_COUNTER }, /* SS_PMON_DBE_LOCK_WAIT */
         { "Lock count",         SS_PMONTYPE_VALUE },   /* SS_PMON_DBE_LOCK_COUNT */
         { "MME cur num of locks",        SS_PMONTYPE_VALUE }, /* SS_PMON_MME_NLOCKS */
@@ -272,6 +278,18 @@ ss_pmon_name_t ss_pmon_names[SS_PMON_MAXVALUES+1] = {
         { "Storage gate wait",          SS_PMONTYPE_COUNTER }, /* SS_PMON_STORAGEGATE_WAIT */
         { "Bonsai Gate wait",           SS_PMONTYPE_COUNTER }, /* SS_PMON_BONSAIGATE_WAIT */
         { "Gate wait",                  SS_PMONTYPE_COUNTER }, /* SS_PMON_GATE_WAIT */
+        { "Sorter spill write bytes",   SS_PMONTYPE_COUNTER }, /* SS_PMON_SORTER_SPILLWRITE */
+        { "Sorter spill read bytes",    SS_PMONTYPE_COUNTER }, /* SS_PMON_SORTER_SPILLREAD */
+        { "Sorter spill file I/O",      SS_PMONTYPE_COUNTER }, /* SS_PMON_SORTER_SPILLIO */
+        { "Db near alloc",              SS_PMONTYPE_COUNTER }, /* SS_PMON_DBNEARALLOC */
+        { "Db near alloc miss",         SS_PMONTYPE_COUNTER }, /* SS_PMON_DBFARALLOC */
+        { "Db defrag page move",        SS_PMONTYPE_COUNTER }, /* SS_PMON_DBDEFRAGMOVE */
+        { "Db file shrink",             SS_PMONTYPE_COUNTER }, /* SS_PMON_DBSHRINK */
+        { "Cond push",                  SS_PMONTYPE_COUNTER }, /* SS_PMON_CONDPUSH */
+        { "Key filter reject",          SS_PMONTYPE_COUNTER }, /* SS_PMON_KEYFILTER */
+        { "Data search prefetch",       SS_PMONTYPE_COUNTER }, /* SS_PMON_DATASEA_PREFETCH */
+        { "Trx check alloc",            SS_PMONTYPE_COUNTER }, /* SS_PMON_TRXCHKALLOC */
+        { "Trx check reuse",            SS_PMONTYPE_COUNTER }, /* SS_PMON_TRXCHKREUSE */
         { "",                           SS_PMONTYPE_VALUE   }  /* SS_PMON_MAXVALUES */
 };
 
@@ -74,6 +74,17 @@ Example:
 The queueing is done so that each operation has a queueing ticket.
 This ticket object is a local variable in the su_gate_enter_xxxx() routines.
 
+Big reader mode:
+
+A gate that is entered in shared mode on almost every operation and
+only rarely in exclusive mode can be switched to big reader mode with
+su_gate_setbigreader. Shared mode accesses are then counted in
+SU_GATE_NSHARDS separate shards selected by the thread id, each on its
+own cache lines, and the gate mutex is not touched. Exclusive mode
+first enters the gate normally, then blocks all shards and waits until
+the shared accesses in every shard have exited. Shared requests that
+find their shard blocked wait in the normal gate queue.
+
 Limitations:
 -----------
 
@@ -138,6 +149,21 @@ struct su_queue_ticket_st {
         su_qticket_t*   t_next;     /* next req in queue */
 };
 
+/* Number of shards in big reader mode. */
+#define SU_GATE_NSHARDS     32
+
+/* Shared access counter of one shard in big reader mode. Padded so that
+   two shards never share a cache line. */
+typedef union {
+        struct {
+            SsFlatMutexT    s_mutex;
+            int             s_nshared;  /* # of shared mode accesses */
+            int             s_nblocked; /* # of exclusive requests blocking
+                                           this shard */
+        } sh;
+        char                sh_pad[128];
+} su_gate_shard_t;
+
 struct su_gate_st {
         int             g_nwait;
         int             g_nshared;      /* # of shared mode accesses */
@@ -147,6 +173,8 @@ struct su_gate_st {
         su_qticket_t*   g_queue_first;  /* ptr to first ticket in queue */
         su_qticket_t*   g_queue_last;   /* ptr to last ticket in queue */
         su_meslist_t    g_meslist;
+        su_gate_shard_t* g_shards;      /* shards in big reader mode, or NULL */
+        volatile unsigned g_bigxthread; /* exclusive thread + 1 in big reader mode */
         ss_profile(SsSemDbgT* g_semdbg;)
         ss_semnum_t             g_sem_num;       /* Order number in hierarchy */
         ss_debug(bool           g_semnum_checkonlyp;)
@@ -224,6 +252,8 @@ static su_gate_t* gate_init(
         SsFlatMutexInit(&(gate->g_mutex), SS_SEMNUM_NOTUSED); /* No number possible/easy. */
         gate->g_queue_first = NULL;
         gate->g_queue_last = NULL;
+        gate->g_shards = NULL;
+        gate->g_bigxthread = 0;
         ss_profile(gate->g_semdbg = NULL;)
         ss_debug(gate->g_exclusivethread = 0;)
         ss_debug(gate->g_sharedthreads = NULL;)
@@ -323,16 +353,25 @@ void su_gate_done(su_gate_t* gate)
                 su_list_done(gate->g_sharedthreads);
             }
         })
+        if (gate->g_shards != NULL) {
+            int i;
+            for (i = 0; i < SU_GATE_NSHARDS; i++) {
+                ss_rc_dassert(gate->g_shards[i].sh.s_nshared == 0, gate->g_sem_num);
+                ss_rc_dassert(gate->g_shards[i].sh.s_nblocked == 0, gate->g_sem_num);
+                SsFlatMutexDone(gate->g_shards[i].sh.s_mutex);
+            }
+            SsMemFree(gate->g_shards);
+        }
         SsFlatMutexDone(gate->g_mutex);
         su_meslist_done(&gate->g_meslist);
         SsMemFree(gate);
 }
 
-/*##**********************************************************************\
+/*#***********************************************************************\
  * 
- *		su_gate_enter_shared
+ *		gate_enter_shared
  * 
- * Enters the gated section in shared mode
+ * Enters the gated section in shared mode through the gate queue
  * 
  * Parameters : 
  * 
@@ -345,15 +384,10 @@ void su_gate_done(su_gate_t* gate)
  * 
  * Globals used : 
  */
-void su_gate_enter_shared(su_gate_t* gate)
+static void gate_enter_shared(su_gate_t* gate)
 {
         su_qticket_t ticket;
      
-        ss_dprintf_1(("su_gate_enter_shared(%s)\n",
-                      gate->g_name));
-        ss_dassert(gate != NULL);
-        ss_dassert(!su_gate_thread_is_shared(gate)
-                   && (gate->g_maxexclusive != 1 || !su_gate_thread_is_exclusive(gate)));
         SsFlatMutexLock(gate->g_mutex);
 
 #ifdef SS_DEBUG
@@ -417,15 +451,13 @@ void su_gate_enter_shared(su_gate_t* gate)
         })
 
         SsFlatMutexUnlock(gate->g_mutex);
-        ss_dprintf_1(("su_gate_enter_shared(%s): gate entered.\n",
-                      gate->g_name));
 }
 
-/*##**********************************************************************\
+/*#***********************************************************************\
  * 
- *		su_gate_enter_exclusive
+ *		gate_enter_exclusive
  * 
- * Enters the gated section in exclusive mode
+ * Enters the gated section in exclusive mode through the gate queue
  * 
  * Parameters : 
  * 
@@ -438,14 +470,10 @@ void su_gate_enter_shared(su_gate_t* gate)
  * 
  * Globals used : 
  */
-void su_gate_enter_exclusive(su_gate_t* gate)
+static void gate_enter_exclusive(su_gate_t* gate)
 {
         su_qticket_t ticket;
 
-        ss_dprintf_1(("su_gate_enter_exclusive(%s)\n",
-                      gate->g_name));
-        ss_dassert(gate != NULL);
-
         SsFlatMutexLock(gate->g_mutex);
 
 #ifdef SS_DEBUG
@@ -507,16 +535,14 @@ void su_gate_enter_exclusive(su_gate_t* gate)
         })
         
         SsFlatMutexUnlock(gate->g_mutex);
-        ss_dprintf_1(("su_gate_enter_exclusive(%s): gate entered, gate->g_nexclusive=%d.\n",
-                      gate->g_name, gate->g_nexclusive));
 }
 
-/*##**********************************************************************\
+/*#***********************************************************************\
  * 
- *		su_gate_exit
+ *		gate_exit
  * 
- * Exits the gated section. This function serves both shared and exclusive
- * access modes.
+ * Exits the gated section entered through the gate queue. This function
+ * serves both shared and exclusive access modes.
  * 
  * Parameters : 
  * 
@@ -529,13 +555,10 @@ void su_gate_enter_exclusive(su_gate_t* gate)
  * 
  * Globals used : 
  */
-void su_gate_exit(su_gate_t* gate)
+static void gate_exit(su_gate_t* gate)
 {
         su_qticket_t* p_ticket;
 
-        ss_dprintf_1(("su_gate_exit(%s)\n", gate->g_name));
-        ss_dassert(gate != NULL);
-
         SsFlatMutexLock(gate->g_mutex);
 #ifdef SS_DEBUG
         if (gate->g_sem_num != SS_SEMNUM_NOTUSED &&
@@ -621,6 +644,325 @@ void su_gate_exit(su_gate_t* gate)
         SsFlatMutexUnlock(gate->g_mutex);
 }
 
+#ifdef SS_DEBUG
+
+/*#***********************************************************************\
+ * 
+ *		gate_bigreader_trackenter
+ * 
+ * Debug bookkeeping for a shared mode enter in big reader mode. Does
+ * the same checks as the queue based enter.
+ * 
+ * Parameters : 
+ * 
+ *	gate - in out, use
+ *		pointer to gate object
+ *		
+ * Return value : 
+ * 
+ * Limitations  : 
+ * 
+ * Globals used : 
+ */
+static void gate_bigreader_trackenter(su_gate_t* gate)
+{
+        if (gate->g_sem_num != SS_SEMNUM_NOTUSED) {
+            if (gate->g_semnum_checkonlyp) {
+                SsSemStkEnterCheck(gate->g_sem_num);
+            } else {
+                SsSemStkEnter(gate->g_sem_num);
+            }
+        }
+        if (gate->g_sharedthreads != NULL) {
+            SsFlatMutexLock(gate->g_mutex);
+            su_list_insertlast(
+                    gate->g_sharedthreads,
+                    su_gate_shareinfo_init());
+            SsFlatMutexUnlock(gate->g_mutex);
+        }
+}
+
+/*#***********************************************************************\
+ * 
+ *		gate_bigreader_trackexit
+ * 
+ * Debug bookkeeping for a shared mode exit in big reader mode.
+ * 
+ * Parameters : 
+ * 
+ *	gate - in out, use
+ *		pointer to gate object
+ *		
+ * Return value : 
+ * 
+ * Limitations  : 
+ * 
+ * Globals used : 
+ */
+static void gate_bigreader_trackexit(su_gate_t* gate)
+{
+        if (gate->g_sem_num != SS_SEMNUM_NOTUSED &&
+            !gate->g_semnum_checkonlyp) {
+            SsSemStkExit(gate->g_sem_num);
+        }
+        if (gate->g_sharedthreads != NULL) {
+            su_list_node_t* n;
+            su_gate_shareinfo_t* si;
+            bool foundp = FALSE;
+            SsFlatMutexLock(gate->g_mutex);
+            su_list_do_get(gate->g_sharedthreads, n, si) {
+                if (si->si_thrid == SsThrGetNativeId()) {
+                    su_list_remove(gate->g_sharedthreads, n);
+                    foundp = TRUE;
+                    break;
+                }
+            }
+            SsFlatMutexUnlock(gate->g_mutex);
+            ss_dassert(foundp);
+        }
+}
+
+#endif /* SS_DEBUG */
+
+/*#***********************************************************************\
+ * 
+ *		gate_bigreader_enter_shared
+ * 
+ * Enters the gated section in shared mode in big reader mode. Only the
+ * shard of the current thread is updated unless an exclusive request
+ * has blocked the shard. In that case the request waits in the gate
+ * queue until the exclusive access has ended and then tries again.
+ * 
+ * Parameters : 
+ * 
+ *	gate - in out, use
+ *		pointer to gate object
+ *		
+ * Return value : 
+ * 
+ * Limitations  : 
+ * 
+ * Globals used : 
+ */
+static void gate_bigreader_enter_shared(su_gate_t* gate)
+{
+        su_gate_shard_t* shard;
+
+        shard = &gate->g_shards[SsThrGetid() % SU_GATE_NSHARDS];
+
+        for (;;) {
+            SsFlatMutexLock(shard->sh.s_mutex);
+            if (shard->sh.s_nblocked == 0) {
+                shard->sh.s_nshared++;
+                SsFlatMutexUnlock(shard->sh.s_mutex);
+                break;
+            }
+            SsFlatMutexUnlock(shard->sh.s_mutex);
+
+            gate_enter_shared(gate);
+            gate_exit(gate);
+        }
+        ss_debug(gate_bigreader_trackenter(gate);)
+}
+
+/*#***********************************************************************\
+ * 
+ *		gate_bigreader_enter_exclusive
+ * 
+ * Enters the gated section in exclusive mode in big reader mode. After
+ * getting the gate normally all shards are blocked and the shared mode
+ * accesses already counted in them are drained.
+ * 
+ * Parameters : 
+ * 
+ *	gate - in out, use
+ *		pointer to gate object
+ *		
+ * Return value : 
+ * 
+ * Limitations  : 
+ * 
+ * Globals used : 
+ */
+static void gate_bigreader_enter_exclusive(su_gate_t* gate)
+{
+        int i;
+        int nshared;
+
+        gate_enter_exclusive(gate);
+
+        for (i = 0; i < SU_GATE_NSHARDS; i++) {
+            SsFlatMutexLock(gate->g_shards[i].sh.s_mutex);
+            gate->g_shards[i].sh.s_nblocked++;
+            SsFlatMutexUnlock(gate->g_shards[i].sh.s_mutex);
+        }
+        for (i = 0; i < SU_GATE_NSHARDS; i++) {
+            for (;;) {
+                SsFlatMutexLock(gate->g_shards[i].sh.s_mutex);
+                nshared = gate->g_shards[i].sh.s_nshared;
+                SsFlatMutexUnlock(gate->g_shards[i].sh.s_mutex);
+                if (nshared == 0) {
+                    break;
+                }
+                SsThrSleep(1);
+            }
+        }
+        gate->g_bigxthread = SsThrGetNativeId() + 1;
+}
+
+/*#***********************************************************************\
+ * 
+ *		gate_bigreader_exit
+ * 
+ * Exits the gated section in big reader mode. This function serves both
+ * shared and exclusive access modes.
+ * 
+ * Parameters : 
+ * 
+ *	gate - in out, use
+ *		pointer to gate object
+ *		
+ * Return value : 
+ * 
+ * Limitations  : 
+ * 
+ * Globals used : 
+ */
+static void gate_bigreader_exit(su_gate_t* gate)
+{
+        int i;
+        int shardno;
+        bool foundp = FALSE;
+
+        if (gate->g_bigxthread == SsThrGetNativeId() + 1) {
+            /* Only the exclusive thread itself can see its own id here. */
+            gate->g_bigxthread = 0;
+            for (i = 0; i < SU_GATE_NSHARDS; i++) {
+                SsFlatMutexLock(gate->g_shards[i].sh.s_mutex);
+                ss_dassert(gate->g_shards[i].sh.s_nblocked > 0);
+                gate->g_shards[i].sh.s_nblocked--;
+                SsFlatMutexUnlock(gate->g_shards[i].sh.s_mutex);
+            }
+            gate_exit(gate);
+            return;
+        }
+
+        ss_debug(gate_bigreader_trackexit(gate);)
+
+        /* Shared exit. The counters only need to add up to the number of
+           shared accesses, so if the gate is exited in a different thread
+           than it was entered some other shard is decremented. */
+        shardno = SsThrGetid() % SU_GATE_NSHARDS;
+        for (i = 0; i < SU_GATE_NSHARDS && !foundp; i++) {
+            su_gate_shard_t* shard;
+
+            shard = &gate->g_shards[(shardno + i) % SU_GATE_NSHARDS];
+            SsFlatMutexLock(shard->sh.s_mutex);
+            if (shard->sh.s_nshared > 0) {
+                shard->sh.s_nshared--;
+                foundp = TRUE;
+            }
+            SsFlatMutexUnlock(shard->sh.s_mutex);
+        }
+        ss_assert(foundp);
+}
+
+/*##**********************************************************************\
+ * 
+ *		su_gate_enter_shared
+ * 
+ * Enters the gated section in shared mode
+ * 
+ * Parameters : 
+ * 
+ *	gate - in out, use
+ *		pointer to gate object
+ *		
+ * Return value : 
+ * 
+ * Limitations  : 
+ * 
+ * Globals used : 
+ */
+void su_gate_enter_shared(su_gate_t* gate)
+{
+        ss_dprintf_1(("su_gate_enter_shared(%s)\n",
+                      gate->g_name));
+        ss_dassert(gate != NULL);
+        ss_dassert(!su_gate_thread_is_shared(gate)
+                   && (gate->g_maxexclusive != 1 || !su_gate_thread_is_exclusive(gate)));
+
+        if (gate->g_shards != NULL) {
+            gate_bigreader_enter_shared(gate);
+        } else {
+            gate_enter_shared(gate);
+        }
+        ss_dprintf_1(("su_gate_enter_shared(%s): gate entered.\n",
+                      gate->g_name));
+}
+
+/*##**********************************************************************\
+ * 
+ *		su_gate_enter_exclusive
+ * 
+ * Enters the gated section in exclusive mode
+ * 
+ * Parameters : 
+ * 
+ *	gate - in out, use
+ *		pointer to gate object
+ *		
+ * Return value : 
+ * 
+ * Limitations  : 
+ * 
+ * Globals used : 
+ */
+void su_gate_enter_exclusive(su_gate_t* gate)
+{
+        ss_dprintf_1(("su_gate_enter_exclusive(%s)\n",
+                      gate->g_name));
+        ss_dassert(gate != NULL);
+
+        if (gate->g_shards != NULL) {
+            gate_bigreader_enter_exclusive(gate);
+        } else {
+            gate_enter_exclusive(gate);
+        }
+        ss_dprintf_1(("su_gate_enter_exclusive(%s): gate entered, gate->g_nexclusive=%d.\n",
+                      gate->g_name, gate->g_nexclusive));
+}
+
+/*##**********************************************************************\
+ * 
+ *		su_gate_exit
+ * 
+ * Exits the gated section. This function serves both shared and exclusive
+ * access modes.
+ * 
+ * Parameters : 
+ * 
+ *	gate - in out, use
+ *		pointer to gate object
+ *		
+ * Return value : 
+ * 
+ * Limitations  : 
+ * 
+ * Globals used : 
+ */
+void su_gate_exit(su_gate_t* gate)
+{
+        ss_dprintf_1(("su_gate_exit(%s)\n", gate->g_name));
+        ss_dassert(gate != NULL);
+
+        if (gate->g_shards != NULL) {
+            gate_bigreader_exit(gate);
+        } else {
+            gate_exit(gate);
+        }
+}
+
 /*##**********************************************************************\
  * 
  *		su_gate_ninqueue
@@ -676,6 +1018,45 @@ void su_gate_setmaxexclusive(su_gate_t* gate, int maxexclusive)
         }
 }
 
+/*##**********************************************************************\
+ * 
+ *		su_gate_setbigreader
+ * 
+ * Switches the gate to big reader mode where shared mode accesses do
+ * not use the gate mutex. Exclusive mode gets more expensive, so this
+ * is meant for gates that are very rarely entered in exclusive mode.
+ * Must be called before the gate is used. Only one exclusive access
+ * is allowed in big reader mode.
+ * 
+ * Parameters : 
+ * 
+ *	gate - in, use
+ *		gate object
+ *		
+ * Return value : 
+ * 
+ * Comments : 
+ * 
+ * Globals used : 
+ * 
+ * See also : 
+ */
+void su_gate_setbigreader(su_gate_t* gate)
+{
+        int i;
+
+        ss_dassert(gate->g_shards == NULL);
+        ss_dassert(gate->g_nshared == 0 && gate->g_nexclusive == 0);
+        ss_dassert(gate->g_maxexclusive == 1);
+
+        gate->g_shards = SsMemAlloc(SU_GATE_NSHARDS * sizeof(su_gate_shard_t));
+        for (i = 0; i < SU_GATE_NSHARDS; i++) {
+            SsFlatMutexInit(&gate->g_shards[i].sh.s_mutex, SS_SEMNUM_NOTUSED);
+            gate->g_shards[i].sh.s_nshared = 0;
+            gate->g_shards[i].sh.s_nblocked = 0;
+        }
+}
+
 #ifdef SS_DEBUG
 
 /*##**********************************************************************\
@@ -395,6 +395,10 @@ with the largest FileSpec_n definition(s) should be missing.\n" },
     "ERROR! Failed to reorganize the database file! Check errors from file ssdebug.log." },
 { DBE_MSG_SHRINK_STARTED,                       SU_RCTYPE_MSG,  "DBE_MSG_SHRINK_STARTED",
   "Starting to reorganize and compact the database file." },
+{ DBE_MSG_RECOVERY_PROGRESS_UUU,                SU_RCTYPE_MSG,  "DBE_MSG_RECOVERY_PROGRESS_UUU",
+    "Recovery: %lu log records read, %lu tuple operations applied, %lu log records/s" },
+{ DBE_MSG_RECOVERY_WORKERS_D,                   SU_RCTYPE_MSG,  "DBE_MSG_RECOVERY_WORKERS_D",
+    "Recovery uses %d parallel apply threads" },
 { DBE_MSG_STARTING_DATABASE_RECREATE,       SU_RCTYPE_MSG,  "DBE_MSG_STARTING_DATABASE_RECREATE",
   "Starting to recreate the database (delete old database and create a new one)." },
 { DBE_MSG_DATABASE_DELETE_OK,                   SU_RCTYPE_MSG,  "DBE_MSG_DATABASE_DELETE_OK",
@@ -160,6 +160,7 @@ const char* su_regis_simple_register[] = {
     "General.FastDeadlockDetect",
     "General.DeadlockDetectMaxDepth",
     "General.DeadlockDetectMaxLocks",
+    "General.DeadlockDetectInterval",
     "General.LongSequentialSearchLimit",
     "General.MaxOpenFiles",
     "General.MergeInterval",
@@ -167,6 +168,7 @@ const char* su_regis_simple_register[] = {
     "General.MinMergeTime",
     "General.StartupForceMerge",
     "General.MaxMergeTasks",
+    "General.RecoveryThreads",
     "General.UserMerge",
     "General.MaxMergeParts",
     "General.MaxUserMergeSteps",
@@ -187,6 +189,7 @@ const char* su_regis_simple_register[] = {
     "General.TableLockWaitTimeOut",
     "General.TransactionEarlyValidate",
     "General.TransactionHashSize",
+    "General.UseIOUring",
     "General.UseIOThreadsOnlyDeprecated",
     "General.UseNewTransWaitReadLevel",
     "General.UseRelaxedReadLevel",
@@ -250,6 +253,9 @@ const char* su_regis_simple_register[] = {
 
     "IndexFile.BlockSize",
     "IndexFile.CacheSize",
+    "IndexFile.CacheLRUPartitions",
+    "IndexFile.CacheReplacementPolicy",
+    "IndexFile.CacheProbationTime",
     "IndexFile.CleanPageSearchLimit",
 #ifdef IO_OPT
     "IndexFile.DirectIO",
@@ -327,6 +333,8 @@ const char* su_regis_simple_register[] = {
     "Sorter.MaxFilesTotal",
     "Sorter.MaxMemPerSort",
     "Sorter.MaxRowsPerStep",
+    "Sorter.SequentialIOSize",
+    "Sorter.SortThreads",
     "Sorter.SorterEnabled",
 #if 0
     "Sorter.TmpDir_1",
@@ -2705,6 +2705,7 @@ su_ret_t su_svf_listio(
         size_t nreq)
 {
         su_ret_t rc = 0;
+        su_ret_t iorc = SU_SUCCESS; /* first failed request */
         vfil_t *vfp;
         uint f_idx;             /* file index in svf->svf_vfp_arr */
         size_t req_idx = 0;
@@ -2722,6 +2723,7 @@ su_ret_t su_svf_listio(
              req_idx++)
         {
             uint n_in_batch = 0;
+            size_t first_idx = req_idx;
 
             /***** MUTEXBEGIN *****/
             SsSemEnter(svf->svf_mutex);
@@ -2837,6 +2839,19 @@ su_ret_t su_svf_listio(
                 }
                 SsFileListIO(lioreq_array, n_in_batch);
                 su_vfh_endaccess(vfp->vf_hp, pfhp);
+                for (i = 0; i < n_in_batch; i++) {
+                    su_ret_t lr_rc = SU_SUCCESS;
+
+                    if (lioreq_array[i].lio_naterr != 0) {
+                        lr_rc = lioreq_array[i].lio_reqtype == SS_LIO_READ
+                                    ? SU_ERR_FILE_READ_FAILURE
+                                    : SU_ERR_FILE_WRITE_FAILURE;
+                        if (iorc == SU_SUCCESS) {
+                            iorc = lr_rc;
+                        }
+                    }
+                    req_array[first_idx + i].lr_rc = lr_rc;
+                }
             }
 
             if (svf->svf_cipher != NULL) {
@@ -2866,7 +2881,9 @@ su_ret_t su_svf_listio(
         if (write_buffers != write_preallocbuffers) {
             SsMemFree(write_buffers);
         }
-
+        if (rc == SU_SUCCESS) {
+            rc = iorc;
+        }
         return (rc);
 }
 
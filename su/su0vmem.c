@@ -33,6 +33,7 @@
 #include <ssmem.h>
 #include <ssfile.h>
 #include <sscacmem.h>
+#include <sspmon.h>
 
 #include "su0parr.h"
 #include "su0vfil.h"
@@ -41,6 +42,14 @@
 
 #define VMEM_CHECK  8675
 
+/* Modes of the sequential I/O extent buffer.
+*/
+typedef enum {
+        VMEM_SEQ_EMPTY,     /* Buffer contains no blocks. */
+        VMEM_SEQ_WRITE,     /* Buffer contains blocks not yet written. */
+        VMEM_SEQ_READ       /* Buffer contains blocks read ahead. */
+} vmem_seqmode_t;
+
 typedef struct slot_st slot_t;
 
 /* Virtual memory block control structure.
@@ -85,6 +94,14 @@ struct su_vmem_st {
         getnewfname_callback_t* vmem_getnewfname_callback;
         releasefname_callback_t* vmem_releasefname_callback;
         void*           vmem_callback_ctx; /* callback context */
+        SsCacMemT*      vmem_seqcacmem; /* Extent buffer memory. */
+        char*           vmem_seqbuf;    /* Extent buffer, NULL if not used. */
+        uint            vmem_seqnblocks;/* Extent buffer size in blocks. */
+        vmem_seqmode_t  vmem_seqmode;   /* Extent buffer contents. */
+        vmem_addr_t     vmem_seqaddr;   /* Address of the first block in
+                                           the extent buffer. */
+        uint            vmem_seqn;      /* Number of blocks in the extent
+                                           buffer. */
 };
 
 #define HASH_INDEX(hash, addr) \
@@ -335,18 +352,24 @@ static void lru_remove(slot_t* s)
 
 /*#**********************************************************************\
  * 
- *		slot_write
+ *		vmem_filewrite
  * 
- * Writes slot data into vmem file. This write function is unconditional,
- * it does not check the slot_dirty flag.
+ * Writes consecutive blocks into vmem file. If the vmem file runs out
+ * of space a new physical file is added using the callback interface.
  * 
  * Parameters : 
  * 
  *	vmem - in, use
  *		vmem pointer
  *
- *	s - in, use
- *		slot the data of which is written
+ *	addr - in
+ *		address of the first block
+ *
+ *	data - in, use
+ *		block data
+ *
+ *	nblocks - in
+ *		number of blocks in data
  *
  * Return value : 
  *      TRUE when successful
@@ -356,22 +379,58 @@ static void lru_remove(slot_t* s)
  * 
  * Globals used : 
  */
-static bool slot_write(su_vmem_t* vmem, slot_t* s)
+static bool vmem_filewrite(
+        su_vmem_t* vmem,
+        vmem_addr_t addr,
+        char* data,
+        uint nblocks)
 {
         bool retry;
         bool succp = TRUE;
         su_ret_t rc;
+        uint i;
         
-        ss_dprintf_3(("slot_write:addr = %ld, vmem size = %ld, file size = %ld\n",
-                      s->slot_addr,
+        ss_dprintf_3(("vmem_filewrite:addr = %ld, nblocks = %d, vmem size = %ld, file size = %ld\n",
+                      addr,
+                      nblocks,
                       vmem->vmem_logicalsize,
                       su_svf_getsize(vmem->vmem_file)));
 
-        ss_dassert(s->slot_dirty);
-        ss_dassert(s->slot_addr < vmem->vmem_logicalsize);
+        ss_dassert(nblocks > 0);
+        ss_dassert(addr + nblocks <= vmem->vmem_logicalsize);
 
-        if (vmem->vmem_info != NULL) {
-            vmem->vmem_info->vmemi_nwrite++;
+        if (nblocks > 1) {
+            rc = su_svf_write(vmem->vmem_file,
+                              addr,
+                              data,
+                              nblocks * vmem->vmem_blocksize);
+            if (rc == SU_SUCCESS) {
+                SS_PMON_ADD(SS_PMON_SORTER_SPILLIO);
+                SS_PMON_ADD_N(SS_PMON_SORTER_SPILLWRITE,
+                              nblocks * vmem->vmem_blocksize);
+                if (addr + nblocks > vmem->vmem_physicalsize) {
+                    vmem->vmem_physicalsize = addr + nblocks;
+                }
+                return (TRUE);
+            }
+            if (rc != SU_ERR_FILE_WRITE_CFG_EXCEEDED) {
+                ss_dprintf_1(("vmem_filewrite failure rc = %d\n", (int)rc));
+                return (FALSE);
+            }
+            /* The extent does not fit into the current physical files,
+             * write it block by block to get new files added.
+             */
+            for (i = 0; i < nblocks; i++) {
+                succp = vmem_filewrite(
+                            vmem,
+                            addr + i,
+                            data + i * vmem->vmem_blocksize,
+                            1);
+                if (!succp) {
+                    break;
+                }
+            }
+            return (succp);
         }
         for (retry = FALSE; ; retry = TRUE) {
             uint num;
@@ -380,26 +439,26 @@ static bool slot_write(su_vmem_t* vmem, slot_t* s)
             long maxsize;
             
             rc = su_svf_write(vmem->vmem_file,
-                              s->slot_addr,
-                              s->slot_data,
+                              addr,
+                              data,
                               vmem->vmem_blocksize);
             if (rc != SU_ERR_FILE_WRITE_CFG_EXCEEDED || retry) {
                 break;
             } /* else CFG exceeded; try to add new file */
-            ss_dprintf_1(("vmem slot_write: CFG exceeded, try to add new file\n"));
+            ss_dprintf_1(("vmem_filewrite: CFG exceeded, try to add new file\n"));
             num = su_pa_nelems(vmem->vmem_fnamearr);
             fname =
                 vmem->vmem_getnewfname_callback(vmem->vmem_callback_ctx,
                                                 num);
             if (fname == NULL) {
-                ss_dprintf_1(("vmem slot_write: new file not gotten\n"));
+                ss_dprintf_1(("vmem_filewrite: new file not gotten\n"));
                 succp = FALSE;
                 break;
             }
             if (SsFExist(fname)) {
                 SsFRemove(fname);
             }
-            ss_dprintf_1(("vmem slot_write: new file: %s\n", fname));
+            ss_dprintf_1(("vmem_filewrite: new file: %s\n", fname));
             {
                 ss_int8_t maxsize_i8;
                 
@@ -424,12 +483,264 @@ static bool slot_write(su_vmem_t* vmem, slot_t* s)
             su_pa_insertat(vmem->vmem_fnamearr, num, fname);
         } 
         if (rc != SU_SUCCESS) {
-            ss_dprintf_1(("vmem slot_write failure rc = %d\n", (int)rc));
+            ss_dprintf_1(("vmem_filewrite failure rc = %d\n", (int)rc));
             succp = FALSE;
         } else if (succp) {
-            if (s->slot_addr >= vmem->vmem_physicalsize) {
-                vmem->vmem_physicalsize = s->slot_addr + 1;
+            SS_PMON_ADD(SS_PMON_SORTER_SPILLIO);
+            SS_PMON_ADD_N(SS_PMON_SORTER_SPILLWRITE, vmem->vmem_blocksize);
+            if (addr >= vmem->vmem_physicalsize) {
+                vmem->vmem_physicalsize = addr + 1;
+            }
+        }
+        return (succp);
+}
+
+/*#**********************************************************************\
+ * 
+ *		seqbuf_flush
+ * 
+ * Writes the blocks pending in the extent buffer into vmem file with
+ * one write and empties the buffer.
+ * 
+ * Parameters : 
+ * 
+ *	vmem - in, use
+ *		vmem pointer
+ *
+ * Return value : 
+ *      TRUE when successful
+ *      FALSE when failure
+ * 
+ * Limitations  : 
+ * 
+ * Globals used : 
+ */
+static bool seqbuf_flush(su_vmem_t* vmem)
+{
+        bool succp = TRUE;
+
+        if (vmem->vmem_seqmode == VMEM_SEQ_WRITE) {
+            ss_dassert(vmem->vmem_seqn > 0);
+            succp = vmem_filewrite(
+                        vmem,
+                        vmem->vmem_seqaddr,
+                        vmem->vmem_seqbuf,
+                        vmem->vmem_seqn);
+        }
+        vmem->vmem_seqmode = VMEM_SEQ_EMPTY;
+        vmem->vmem_seqn = 0;
+        return (succp);
+}
+
+/*#**********************************************************************\
+ * 
+ *		seqbuf_write
+ * 
+ * Writes a block through the extent buffer. Consecutive blocks are
+ * collected into the buffer and written when the buffer becomes full
+ * or a block outside the extent is written.
+ * 
+ * Parameters : 
+ * 
+ *	vmem - in, use
+ *		vmem pointer
+ *
+ *	addr - in
+ *		block address
+ *
+ *	data - in, use
+ *		block data
+ *
+ * Return value : 
+ *      TRUE when successful
+ *      FALSE when failure
+ * 
+ * Limitations  : 
+ * 
+ * Globals used : 
+ */
+static bool seqbuf_write(su_vmem_t* vmem, vmem_addr_t addr, char* data)
+{
+        ss_dassert(vmem->vmem_seqbuf != NULL);
+
+        if (vmem->vmem_seqmode == VMEM_SEQ_WRITE) {
+            if (addr >= vmem->vmem_seqaddr
+            &&  addr < vmem->vmem_seqaddr + vmem->vmem_seqn)
+            {
+                /* Block is rewritten before the extent is flushed. */
+                memcpy(vmem->vmem_seqbuf +
+                        (addr - vmem->vmem_seqaddr) * vmem->vmem_blocksize,
+                       data,
+                       vmem->vmem_blocksize);
+                return (TRUE);
+            }
+            if (addr == vmem->vmem_seqaddr + vmem->vmem_seqn
+            &&  vmem->vmem_seqn < vmem->vmem_seqnblocks)
+            {
+                memcpy(vmem->vmem_seqbuf +
+                        vmem->vmem_seqn * vmem->vmem_blocksize,
+                       data,
+                       vmem->vmem_blocksize);
+                vmem->vmem_seqn++;
+                return (TRUE);
             }
+        }
+        /* Blocks read ahead may become stale, so also the read mode
+         * buffer is emptied.
+         */
+        if (!seqbuf_flush(vmem)) {
+            return (FALSE);
+        }
+        memcpy(vmem->vmem_seqbuf, data, vmem->vmem_blocksize);
+        vmem->vmem_seqmode = VMEM_SEQ_WRITE;
+        vmem->vmem_seqaddr = addr;
+        vmem->vmem_seqn = 1;
+        return (TRUE);
+}
+
+/*#**********************************************************************\
+ * 
+ *		seqbuf_read
+ * 
+ * Reads a block through the extent buffer. If the block is not in the
+ * buffer, an extent starting from the block is read ahead into the buffer.
+ * 
+ * Parameters : 
+ * 
+ *	vmem - in, use
+ *		vmem pointer
+ *
+ *	addr - in
+ *		block address, must be within the physical vmem size
+ *
+ *	data - out, use
+ *		buffer into where the block is copied
+ *
+ * Return value : 
+ *      TRUE when successful
+ *      FALSE when failure
+ * 
+ * Limitations  : 
+ * 
+ * Globals used : 
+ */
+static bool seqbuf_read(su_vmem_t* vmem, vmem_addr_t addr, char* data)
+{
+        ss_dassert(vmem->vmem_seqbuf != NULL);
+        ss_dassert(vmem->vmem_seqmode != VMEM_SEQ_WRITE);
+        ss_dassert(addr < vmem->vmem_physicalsize);
+
+        if (vmem->vmem_seqmode != VMEM_SEQ_READ
+        ||  addr < vmem->vmem_seqaddr
+        ||  addr >= vmem->vmem_seqaddr + vmem->vmem_seqn)
+        {
+            su_ret_t rc;
+            size_t sizeread;
+            uint n;
+
+            n = vmem->vmem_seqnblocks;
+            if (vmem->vmem_physicalsize - addr < n) {
+                n = (uint)(vmem->vmem_physicalsize - addr);
+            }
+            rc = su_svf_read(
+                    vmem->vmem_file,
+                    addr,
+                    vmem->vmem_seqbuf,
+                    n * vmem->vmem_blocksize,
+                    &sizeread);
+            if (rc != SU_SUCCESS || sizeread != n * vmem->vmem_blocksize) {
+                vmem->vmem_seqmode = VMEM_SEQ_EMPTY;
+                vmem->vmem_seqn = 0;
+                return (FALSE);
+            }
+            SS_PMON_ADD(SS_PMON_SORTER_SPILLIO);
+            SS_PMON_ADD_N(SS_PMON_SORTER_SPILLREAD, sizeread);
+            vmem->vmem_seqmode = VMEM_SEQ_READ;
+            vmem->vmem_seqaddr = addr;
+            vmem->vmem_seqn = n;
+        }
+        memcpy(data,
+               vmem->vmem_seqbuf +
+                (addr - vmem->vmem_seqaddr) * vmem->vmem_blocksize,
+               vmem->vmem_blocksize);
+        return (TRUE);
+}
+
+/*#**********************************************************************\
+ * 
+ *		seqbuf_free
+ * 
+ * Releases the extent buffer. Pending blocks must have been flushed.
+ * 
+ * Parameters : 
+ * 
+ *	vmem - in, use
+ *		vmem pointer
+ *
+ * Return value : 
+ * 
+ * Limitations  : 
+ * 
+ * Globals used : 
+ */
+static void seqbuf_free(su_vmem_t* vmem)
+{
+        ss_dassert(vmem->vmem_seqmode != VMEM_SEQ_WRITE);
+
+        if (vmem->vmem_seqcacmem != NULL) {
+            SsCacMemFree(vmem->vmem_seqcacmem, vmem->vmem_seqbuf);
+            SsCacMemDone(vmem->vmem_seqcacmem);
+            vmem->vmem_seqcacmem = NULL;
+        }
+        vmem->vmem_seqbuf = NULL;
+        vmem->vmem_seqnblocks = 0;
+        vmem->vmem_seqmode = VMEM_SEQ_EMPTY;
+        vmem->vmem_seqn = 0;
+}
+
+/*#**********************************************************************\
+ * 
+ *		slot_write
+ * 
+ * Writes slot data into vmem file. This write function is unconditional,
+ * it does not check the slot_dirty flag.
+ * 
+ * Parameters : 
+ * 
+ *	vmem - in, use
+ *		vmem pointer
+ *
+ *	s - in, use
+ *		slot the data of which is written
+ *
+ * Return value : 
+ *      TRUE when successful
+ *      FALSE when failure
+ * 
+ * Limitations  : 
+ * 
+ * Globals used : 
+ */
+static bool slot_write(su_vmem_t* vmem, slot_t* s)
+{
+        bool succp;
+        
+        ss_dprintf_3(("slot_write:addr = %ld, vmem size = %ld\n",
+                      s->slot_addr,
+                      vmem->vmem_logicalsize));
+
+        ss_dassert(s->slot_dirty);
+        ss_dassert(s->slot_addr < vmem->vmem_logicalsize);
+
+        if (vmem->vmem_info != NULL) {
+            vmem->vmem_info->vmemi_nwrite++;
+        }
+        if (vmem->vmem_seqbuf != NULL) {
+            succp = seqbuf_write(vmem, s->slot_addr, s->slot_data);
+        } else {
+            succp = vmem_filewrite(vmem, s->slot_addr, s->slot_data, 1);
+        }
+        if (succp) {
             s->slot_dirty = 0;
         }
         return (succp);
@@ -479,8 +790,16 @@ static bool slot_reach(su_vmem_t* vmem, slot_t* s, vmem_addr_t addr, bool readp)
         if (s->slot_addr != SU_DADDR_NULL) {
             hash_remove(&vmem->vmem_hash, s);
         }
+        if (readp && vmem->vmem_seqmode == VMEM_SEQ_WRITE) {
+            /* Pending blocks may be read back. */
+            succp = seqbuf_flush(vmem);
+        }
 
-        if (readp && addr < vmem->vmem_physicalsize) {
+        if (succp && readp && addr < vmem->vmem_physicalsize
+        &&  vmem->vmem_seqbuf != NULL)
+        {
+            succp = seqbuf_read(vmem, addr, s->slot_data);
+        } else if (succp && readp && addr < vmem->vmem_physicalsize) {
             su_ret_t rc;
             size_t sizeread;
 
@@ -492,6 +811,9 @@ static bool slot_reach(su_vmem_t* vmem, slot_t* s, vmem_addr_t addr, bool readp)
                     &sizeread);
             if (rc != SU_SUCCESS || sizeread != vmem->vmem_blocksize) {
                 succp = FALSE;
+            } else {
+                SS_PMON_ADD(SS_PMON_SORTER_SPILLIO);
+                SS_PMON_ADD_N(SS_PMON_SORTER_SPILLREAD, sizeread);
             }
         }
         if (succp) {  
@@ -643,6 +965,12 @@ su_vmem_t* su_vmem_open(
             = su_svf_getsize(vmem->vmem_file);
 
         vmem->vmem_info = NULL;
+        vmem->vmem_seqcacmem = NULL;
+        vmem->vmem_seqbuf = NULL;
+        vmem->vmem_seqnblocks = 0;
+        vmem->vmem_seqmode = VMEM_SEQ_EMPTY;
+        vmem->vmem_seqaddr = SU_DADDR_NULL;
+        vmem->vmem_seqn = 0;
 
         vmem->vmem_lruhead = SsMemAlloc(sizeof(slot_t));
         ss_assert(vmem->vmem_lruhead != NULL);
@@ -731,6 +1059,9 @@ void su_vmem_delete(su_vmem_t* vmem)
         ss_dprintf_1(("su_vmem_delete:%d\n", (int)vmem));
         ss_dassert(vmem->vmem_check == VMEM_CHECK);
 
+        /* The file is removed, pending blocks need not be written. */
+        vmem->vmem_seqmode = VMEM_SEQ_EMPTY;
+        seqbuf_free(vmem);
         su_svf_done(vmem->vmem_file);
         su_pa_do_get(vmem->vmem_fnamearr, i, fname) {
             SsFRemove(fname);
@@ -814,6 +1145,8 @@ void su_vmem_rewrite(su_vmem_t* vmem)
             ss_dassert(s->slot_nreach == 0);
             s = s->slot_next;
         }
+        vmem->vmem_seqmode = VMEM_SEQ_EMPTY;
+        vmem->vmem_seqn = 0;
         vmem->vmem_logicalsize = 0L;
         vmem->vmem_physicalsize = 0L;
         info = vmem->vmem_info;
@@ -883,6 +1216,8 @@ void su_vmem_removebuffers(su_vmem_t* vmem)
             }
             s = s->slot_next;
         }
+        seqbuf_flush(vmem);
+        seqbuf_free(vmem);
 
         while (vmem->vmem_lruhead->slot_next != vmem->vmem_lruhead) {
             s = vmem->vmem_lruhead->slot_next;
@@ -981,6 +1316,57 @@ void su_vmem_addbuffers(
         }
 }
 
+/*##**********************************************************************\
+ * 
+ *		su_vmem_setseqbuf
+ * 
+ * Sets the size of the extent buffer used for sequential file I/O.
+ * When the buffer is used, consecutive blocks are written to the file
+ * with one write call and blocks are read ahead from the file an extent
+ * at a time. This is intended for vmem objects that are mostly written
+ * and read sequentially, like the sort runs of the external sorter.
+ * The buffer is released by su_vmem_removebuffers.
+ * 
+ * Parameters : 
+ * 
+ *	vmem - in out, use
+ *		vmem pointer
+ *		
+ *	nblocks - in
+ *		extent buffer size in blocks, values less than two disable
+ *          the buffer
+ *		
+ * Return value : 
+ * 
+ * Comments : 
+ * 
+ * Globals used : 
+ * 
+ * See also : 
+ */
+void su_vmem_setseqbuf(
+        su_vmem_t* vmem,
+        uint nblocks)
+{
+        ss_dprintf_1(("su_vmem_setseqbuf:%d, nblocks=%d\n", (int)vmem, nblocks));
+        ss_dassert(vmem->vmem_check == VMEM_CHECK);
+
+        if (vmem->vmem_seqbuf != NULL) {
+            seqbuf_flush(vmem);
+            seqbuf_free(vmem);
+        }
+        if (nblocks < 2) {
+            return;
+        }
+        vmem->vmem_seqcacmem = SsCacMemInit(
+                                    nblocks * vmem->vmem_blocksize,
+                                    1);
+        vmem->vmem_seqbuf = SsCacMemAlloc(vmem->vmem_seqcacmem);
+        vmem->vmem_seqnblocks = nblocks;
+        vmem->vmem_seqmode = VMEM_SEQ_EMPTY;
+        vmem->vmem_seqn = 0;
+}
+
 /*##**********************************************************************\
  * 
  *		su_vmem_sizeinblocks
@@ -1219,6 +1605,9 @@ bool su_vmem_syncsizeifneeded(su_vmem_t* vmem)
                     }
                     s = s->slot_next;
                 }
+                if (!seqbuf_flush(vmem)) {
+                    return (FALSE);
+                }
                 /* Fall to the
                  * if vmem->vmem_physicalsize != vmem->vmem_logicalsize)
                  * test
@@ -5314,6 +5314,8 @@ void tb_database_pmonupdate_nomutex(
         /* File size info. */
         SS_PMON_SET(SS_PMON_DBSIZE, dbs.dbst_ind_filesize);
         SS_PMON_SET(SS_PMON_DBFREESIZE, dbs.dbst_ind_freesize);
+        SS_PMON_SET(SS_PMON_DBNEARALLOC, dbs.dbst_ind_nearalloccnt);
+        SS_PMON_SET(SS_PMON_DBFARALLOC, dbs.dbst_ind_faralloccnt);
         SS_PMON_SET(SS_PMON_LOGSIZE, dbs.dbst_log_filesize);
 
         /* Memory info. */
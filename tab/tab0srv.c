@@ -52,7 +52,8 @@ bool mainserver_isserving(void);
 
 #define CHK_LW(lw)  ss_dassert(SS_CHKPTR(lw) && (lw)->lw_chk == TBCHK_SRVLOCKWAIT)
 
-#define SRV_MAXTHR  7
+#define SRV_MAXMERGEEXTRATHR    32
+#define SRV_MAXTHR              (3 + SRV_MAXMERGEEXTRATHR)
 
 typedef enum {
         TB_SRV_MERGE_RUN,
@@ -85,6 +86,7 @@ typedef struct {
 static bool              srv_shutdown = FALSE;
 static int               srv_maxthr = SRV_MAXTHR;
 static int               srv_first_merge_extra_thr = 0;
+static int               srv_nmergetasks = 1;
 static su_list_t*        srv_tasklist;
 static SsSemT*           srv_tasklistmutex;
 static SsMesT*           srv_taskmes;
@@ -281,6 +283,11 @@ static void SS_CALLBACK tb_srv_merge_thread(void* param)
                     lastmergetime = SsTime(NULL);
                     ti->ti_running = TRUE;
                     dbe_db_mergestart(cd, db);
+                    /* Tell the merge how many dedicated workers share
+                     * the key range parts so user threads do not steal
+                     * parts the workers can handle.
+                     */
+                    dbe_db_setnmergetasks(db, srv_nmergetasks);
                     srv_mergeactive = TRUE;
                     for (i = srv_first_merge_extra_thr; i < srv_maxthr; i++) {
                         if (srv_thrinfo[i].ti_alive) {
@@ -414,6 +421,53 @@ void tb_srv_done(void)
         tb_done();
 }
 
+/*#***********************************************************************\
+ * 
+ *		srv_getnmergeextrathr
+ * 
+ * Returns the number of extra merge threads started in addition to
+ * the main merge thread. Each thread merges its own key range part of
+ * the Bonsai-tree, so by default one merge task per processor is used.
+ * 
+ * Parameters : 
+ * 
+ * Return value : 
+ * 
+ *      number of extra merge threads
+ * 
+ * Comments : 
+ * 
+ * Globals used : 
+ * 
+ *      dbe_cfg_mergecleanup
+ *      dbe_cfg_maxmergetasks
+ * 
+ * See also : 
+ */
+static int srv_getnmergeextrathr(void)
+{
+        int nmergetasks;
+
+        if (dbe_cfg_mergecleanup) {
+            return(3); /* One server thread, three merge threads. */
+        }
+        nmergetasks = dbe_cfg_maxmergetasks;
+        if (nmergetasks <= 0) {
+            nmergetasks = SsEnvNumProcessors();
+        }
+        if (nmergetasks > dbe_cfg_maxmergeparts) {
+            /* No use for more tasks than there are parts. */
+            nmergetasks = dbe_cfg_maxmergeparts;
+        }
+        nmergetasks--; /* Main merge thread is one of the tasks. */
+        if (nmergetasks < 0) {
+            nmergetasks = 0;
+        } else if (nmergetasks > SRV_MAXMERGEEXTRATHR) {
+            nmergetasks = SRV_MAXMERGEEXTRATHR;
+        }
+        return(nmergetasks);
+}
+
 bool tb_srv_start(tb_database_t* tdb)
 {
         int i;
@@ -423,16 +477,16 @@ bool tb_srv_start(tb_database_t* tdb)
 
         ss_pprintf_1(("tb_srv_start\n"));
 
-        if (dbe_cfg_mergecleanup) {
-            maxmergethreads = 3; /* One server thread, three merge threads. */
-        } else {
-            maxmergethreads = SRV_MAXTHR;
-        }
+        maxmergethreads = srv_getnmergeextrathr();
 
         srv_shutdown = FALSE;
         srv_mergeactive = FALSE;
 
-        for (i = 0; i < SRV_MAXTHR; i++) {
+        srv_first_merge_extra_thr = 3;
+        srv_maxthr = srv_first_merge_extra_thr + maxmergethreads;
+        ss_dassert(srv_maxthr <= SRV_MAXTHR);
+
+        for (i = 0; i < srv_maxthr; i++) {
             srv_thrinfo[i].ti_mes = SsMesCreateLocal();
             srv_thrinfo[i].ti_tbcon = tb_sysconnect_init(tdb);
             ss_assert(srv_thrinfo[i].ti_tbcon != NULL);
@@ -459,10 +513,9 @@ bool tb_srv_start(tb_database_t* tdb)
         srv_tasklistmutex = SsSemCreateLocal(SS_SEMNUM_TAB_SRVTASKLIST);
         srv_taskmes = srv_thrinfo[2].ti_mes;
 
-        srv_first_merge_extra_thr = 3;
         for (i = srv_first_merge_extra_thr; i < SRV_MAXTHR && maxmergethreads > 0; i++, maxmergethreads--) {
             if (dbe_cfg_mergecleanup) {
-                switch (i) {
+                switch (i - srv_first_merge_extra_thr + 1) {
                     case 1:
                         srv_thrinfo[i].ti_mergetype = TB_SRV_MERGE_FULL;
                         break;    
@@ -485,7 +538,9 @@ bool tb_srv_start(tb_database_t* tdb)
                         1024*1024,
                         &srv_thrinfo[i]);
         }
-        srv_maxthr = i;
+        ss_dassert(i == srv_maxthr);
+        srv_nmergetasks = 1 + (srv_maxthr - srv_first_merge_extra_thr);
+        ss_pprintf_1(("tb_srv_start:nmergetasks=%d\n", srv_nmergetasks));
         for (i = 0; i < srv_maxthr; i++) {
             succp = SsThrEnableBool(thr[i]);
             if (!succp) {
@@ -535,7 +590,7 @@ void tb_srv_stop(void)
              Bugzilla bug #516 (int).
             */
         } while (nalive > 0 /* && SsTime(NULL) < now + 10 */);
-        for (i = 0; i < SRV_MAXTHR; i++) {
+        for (i = 0; i < srv_maxthr; i++) {
             tb_sysconnect_done(srv_thrinfo[i].ti_tbcon);
             SsMesFree(srv_thrinfo[i].ti_mes);
         }
@@ -72,6 +72,7 @@ Example:
 #include "xs0acnd.h"
 #include "xs0error.h"
 #include "xs0mgr.h"
+#include "xs1pres.h"
 
 #define XS_POOLPERCENT_MAX 50
 #define XS_POOLPERCENT_MIN 10
@@ -133,6 +134,7 @@ xs_mgr_t* xs_mgr_init(
         int openflags;
         int writeflushmode;
         bool filebuffering;
+        size_t seqiosize;
 
         ss_dassert(sortarraysize >= 100);
         cfg = xs_cfg_init(inifile);
@@ -172,8 +174,10 @@ xs_mgr_t* xs_mgr_init(
                 XS_POOLPERCENT_MIN,
                 XS_POOLPERCENT_MAX);
         }
+        xs_cfg_sortthreads(cfg, &xs_presorter_nthreads);
         xs_cfg_getwriteflushmode(cfg, &writeflushmode);
         xs_cfg_getfilebuffering(cfg, &filebuffering);
+        xs_cfg_seqiosize(cfg, &seqiosize);
         openflags = SS_BF_SEQUENTIAL | SS_BF_EXCLUSIVE;
         if (!filebuffering) {
             openflags |= SS_BF_NOBUFFERING;
@@ -223,7 +227,8 @@ xs_mgr_t* xs_mgr_init(
                 maxfiles,
                 xsmgr->m_memmgr,
                 (ulong)dbe_db_getcreatime(xsmgr->m_db),
-                openflags);
+                openflags,
+                seqiosize);
         i = 1;
         do {
             succp = xs_tfmgr_adddir(xsmgr->m_tfmgr, tfdirname, tfdirsize);
@@ -78,6 +78,8 @@ Example:
 #define XS_DEFBLOCKSIZE         0 /* 0 means same block size as in db file */
 #define XS_DEFFILEBUFFERING     TRUE
 #define XS_DEFSORTERENABLED     TRUE
+#define XS_DEFSORTTHREADS       0 /* 0 means number of processors */
+#define XS_DEFSEQIOSIZE         (256 * 1024L)
 #define XS_DEFTMPDIR            "."
 
 #define XS_DEFWRITEFLUSHMODE SS_BFLUSH_NORMAL
@@ -128,6 +130,16 @@ SU_XS_SECTION, SU_XS_SORTERENABLED, NULL, 0, 0.0, XS_DEFSORTERENABLED,
 conf_param_rwstartup_set_cb, NULL, SU_PARAM_TYPE_BOOL, SU_PARAM_AM_RWSTARTUP,
 "Enables external sorter"
 },
+{
+SU_XS_SECTION, SU_XS_SORTTHREADS, NULL, XS_DEFSORTTHREADS, 0.0, 0,
+conf_param_rwstartup_set_cb, NULL, SU_PARAM_TYPE_LONG, SU_PARAM_AM_RWSTARTUP,
+"Number of threads used to sort presort buffers (0 = number of processors)"
+},
+{
+SU_XS_SECTION, SU_XS_SEQIOSIZE, NULL, XS_DEFSEQIOSIZE, 0.0, 0,
+conf_param_rwstartup_set_cb, NULL, SU_PARAM_TYPE_LONG, SU_PARAM_AM_RWSTARTUP,
+"Size in bytes of the extents used to write and read sort runs (0 = one block at a time)"
+},
 {
         NULL, NULL, NULL, 0, 0.0, 0, NULL, NULL, 0, 0, NULL
 }
@@ -622,6 +634,98 @@ bool xs_cfg_maxrowsperstep(
         return (found);       
 }
 
+/*##**********************************************************************\
+ * 
+ *		xs_cfg_sortthreads
+ * 
+ * Gets the number of threads used to sort the presort buffers of one
+ * sort. Value 0 means the number of processors.
+ * 
+ * Parameters : 
+ * 
+ *	cfg - in, use
+ *		cfg object
+ *		
+ *	p_nthreads - out
+ *		number of sort threads
+ *		
+ * Return value : 
+ *      TRUE if the parameter was found from the inifile
+ * 
+ * Comments : 
+ * 
+ * Globals used : 
+ * 
+ * See also : 
+ */
+bool xs_cfg_sortthreads(
+        xs_cfg_t* cfg,
+        uint* p_nthreads)
+{
+        long l;
+        bool found;
+
+        ss_dassert(p_nthreads != NULL);
+        ss_dassert(cfg != NULL);
+
+        found = su_inifile_getlong(
+                    cfg->xc_inifile,
+                    SU_XS_SECTION,
+                    SU_XS_SORTTHREADS,
+                    &l);
+        if (!found || l < 0) {
+            l = XS_DEFSORTTHREADS;
+        }
+        *p_nthreads = (uint)l;
+        return (found);       
+}
+
+/*##**********************************************************************\
+ * 
+ *		xs_cfg_seqiosize
+ * 
+ * Gets the size of the extents in which sort runs are written to and
+ * read from the temporary files.
+ * 
+ * Parameters : 
+ * 
+ *	cfg - in, use
+ *		cfg object
+ *		
+ *	p_seqiosize - out
+ *		extent size in bytes, 0 means block at a time
+ *		
+ * Return value : 
+ *      TRUE if the parameter was found from the inifile
+ * 
+ * Comments : 
+ * 
+ * Globals used : 
+ * 
+ * See also : 
+ */
+bool xs_cfg_seqiosize(
+        xs_cfg_t* cfg,
+        size_t* p_seqiosize)
+{
+        long l;
+        bool found;
+
+        ss_dassert(p_seqiosize != NULL);
+        ss_dassert(cfg != NULL);
+
+        found = su_inifile_getlong(
+                    cfg->xc_inifile,
+                    SU_XS_SECTION,
+                    SU_XS_SEQIOSIZE,
+                    &l);
+        if (!found || l < 0) {
+            l = XS_DEFSEQIOSIZE;
+        }
+        *p_seqiosize = (size_t)l;
+        return (found);       
+}
+
 bool xs_cfg_getwriteflushmode(
         xs_cfg_t* cfg,
         int* p_writeflushmode)
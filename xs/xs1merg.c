@@ -61,7 +61,6 @@ Example:
 #include <ssmem.h>
 #include <ssdebug.h>
 
-#include <su0bsrch.h>
 #include <su0parr.h>
 #include <su0error.h>
 
@@ -86,15 +85,27 @@ typedef enum {
 } mergestatus_t;
 
 typedef struct mgitemstruct {
-        int     mgi_stream_index;
         void*   mgi_data;
         size_t  mgi_datalen;
+        bool    mgi_valid;
 } mgitem_t;
 
+/* Merge tuple list is a tournament (loser) tree over the read streams.
+ * Leaf i holds the current tuple of read stream i. Internal node p
+ * (1 <= p < mgtl_size) holds the leaf that lost the match at that
+ * node, node 0 holds the overall winner. Children of node p are
+ * 2p and 2p+1, leaf i is at position mgtl_size + i. After the winner
+ * is consumed only the path from its leaf to the root is replayed,
+ * so selecting the next tuple takes log2(nstreams) comparisons
+ * without moving or allocating items.
+ */
 typedef struct {
-        mgitem_t** mgtl_array;
-        uint mgtl_size;
-        uint mgtl_1st;
+        mgitem_t*   mgtl_leaves;
+        int*        mgtl_tree;
+        int*        mgtl_win;       /* work array used in build */
+        uint        mgtl_size;
+        int         mgtl_replay;    /* leaf to replay before next select */
+        bool        mgtl_built;
 } mgtuplelist_t;
 
 struct xs_merge_st {
@@ -108,8 +119,6 @@ struct xs_merge_st {
         uint              mg_stepsizerows;
 };
 
-static int  mgi_cmp(void* key, void* mgi, void* ctx);
-
 static int  merge_nextrun(xs_merge_t* mg);
 
 static int  mgtl_initialize(xs_merge_t* mg);
@@ -118,6 +127,10 @@ static int  mgtl_addfromstream(xs_merge_t* mg, xs_stream_t* readstream, int stre
 static void mgtl_add(xs_merge_t* mg, void* data, size_t datalen, int stream_index);
 static int  mgtl_select(xs_merge_t* mg, void** p_data, size_t* p_datalen);
 
+static bool mgtl_less(xs_merge_t* mg, int a, int b);
+static void mgtl_build(xs_merge_t* mg);
+static void mgtl_replay(xs_merge_t* mg, int leaf);
+
 static mgtuplelist_t* mgtl_init(uint nstreams);
 static void mgtl_done(mgtuplelist_t* tuplelist);
 
@@ -430,35 +443,169 @@ static int merge_nextrun(
         }
 }
 
-static int mgi_cmp(void* key, void* mgi, void* ctx)
-{
-        int cmp;
-
-        cmp = (((xs_merge_t*)ctx)->mg_comp_fp)(
-                    &key,
-                    &(*(mgitem_t**)mgi)->mgi_data,
-                    ((xs_merge_t*)ctx)->mg_comp_context);
-        return (cmp);
-}
-
 static mgtuplelist_t* mgtl_init(uint nstreams)
 {
         mgtuplelist_t* tuplelist;
+        uint i;
+
+        ss_dassert(nstreams > 0);
 
         tuplelist = SSMEM_NEW(mgtuplelist_t);
-        tuplelist->mgtl_array = SsMemAlloc(sizeof(mgitem_t*) * nstreams);
-        tuplelist->mgtl_1st = 
-            tuplelist->mgtl_size =
-                nstreams;
+        tuplelist->mgtl_leaves = SsMemAlloc(sizeof(mgitem_t) * nstreams);
+        tuplelist->mgtl_tree = SsMemAlloc(sizeof(int) * nstreams);
+        tuplelist->mgtl_win = SsMemAlloc(sizeof(int) * 2 * nstreams);
+        tuplelist->mgtl_size = nstreams;
+        tuplelist->mgtl_replay = -1;
+        tuplelist->mgtl_built = FALSE;
+        for (i = 0; i < nstreams; i++) {
+            tuplelist->mgtl_leaves[i].mgi_data = NULL;
+            tuplelist->mgtl_leaves[i].mgi_datalen = 0;
+            tuplelist->mgtl_leaves[i].mgi_valid = FALSE;
+        }
         return (tuplelist);
 }
 
 static void mgtl_done(mgtuplelist_t* tuplelist)
 {
-        SsMemFree(tuplelist->mgtl_array);
+        SsMemFree(tuplelist->mgtl_leaves);
+        SsMemFree(tuplelist->mgtl_tree);
+        SsMemFree(tuplelist->mgtl_win);
         SsMemFree(tuplelist);
 }
 
+/*#***********************************************************************\
+ * 
+ *		mgtl_less
+ * 
+ * Compares the current tuples of two leaves. An empty leaf (stream
+ * at end of run) is greater than any tuple. Equal tuples are ordered
+ * by stream index.
+ * 
+ * Parameters : 
+ * 
+ *	mg - in, use
+ *		merge object
+ *		
+ *	a - in
+ *		leaf index
+ *		
+ *	b - in
+ *		leaf index
+ *		
+ * Return value : 
+ *      TRUE if leaf a comes before leaf b
+ * 
+ * Comments : 
+ * 
+ * Globals used : 
+ * 
+ * See also : 
+ */
+static bool mgtl_less(xs_merge_t* mg, int a, int b)
+{
+        mgitem_t* ia = &mg->mg_tuplelist->mgtl_leaves[a];
+        mgitem_t* ib = &mg->mg_tuplelist->mgtl_leaves[b];
+        int cmp;
+
+        if (!ia->mgi_valid) {
+            return (FALSE);
+        }
+        if (!ib->mgi_valid) {
+            return (TRUE);
+        }
+        cmp = (mg->mg_comp_fp)(
+                    &ia->mgi_data,
+                    &ib->mgi_data,
+                    mg->mg_comp_context);
+        if (cmp != 0) {
+            return (cmp < 0);
+        }
+        return (a < b);
+}
+
+/*#***********************************************************************\
+ * 
+ *		mgtl_build
+ * 
+ * Builds the loser tree from the current leaves.
+ * 
+ * Parameters : 
+ * 
+ *	mg - in out, use
+ *		merge object
+ *		
+ * Return value : 
+ * 
+ * Comments : 
+ * 
+ * Globals used : 
+ * 
+ * See also : 
+ */
+static void mgtl_build(xs_merge_t* mg)
+{
+        mgtuplelist_t* tl = mg->mg_tuplelist;
+        int n = (int)tl->mgtl_size;
+        int p;
+        int a;
+        int b;
+
+        for (p = 0; p < n; p++) {
+            tl->mgtl_win[n + p] = p;
+        }
+        for (p = n - 1; p >= 1; p--) {
+            a = tl->mgtl_win[2 * p];
+            b = tl->mgtl_win[2 * p + 1];
+            if (mgtl_less(mg, a, b)) {
+                tl->mgtl_win[p] = a;
+                tl->mgtl_tree[p] = b;
+            } else {
+                tl->mgtl_win[p] = b;
+                tl->mgtl_tree[p] = a;
+            }
+        }
+        tl->mgtl_tree[0] = (n == 1) ? 0 : tl->mgtl_win[1];
+}
+
+/*#***********************************************************************\
+ * 
+ *		mgtl_replay
+ * 
+ * Replays the matches from a changed leaf to the root.
+ * 
+ * Parameters : 
+ * 
+ *	mg - in out, use
+ *		merge object
+ *		
+ *	leaf - in
+ *		leaf index whose tuple changed
+ *		
+ * Return value : 
+ * 
+ * Comments : 
+ * 
+ * Globals used : 
+ * 
+ * See also : 
+ */
+static void mgtl_replay(xs_merge_t* mg, int leaf)
+{
+        mgtuplelist_t* tl = mg->mg_tuplelist;
+        int w = leaf;
+        int p;
+        int tmp;
+
+        for (p = ((int)tl->mgtl_size + leaf) / 2; p >= 1; p /= 2) {
+            if (mgtl_less(mg, tl->mgtl_tree[p], w)) {
+                tmp = tl->mgtl_tree[p];
+                tl->mgtl_tree[p] = w;
+                w = tmp;
+            }
+        }
+        tl->mgtl_tree[0] = w;
+}
+
 /*#***********************************************************************\
  * 
  *		mgtl_initialize
@@ -488,7 +635,9 @@ static int mgtl_initialize(
         xs_stream_t* readstream;
 
         ss_dprintf_1(("mgtl_initialize\n"));
-        ss_dassert(mg->mg_tuplelist->mgtl_1st == mg->mg_tuplelist->mgtl_size);
+
+        mg->mg_tuplelist->mgtl_built = FALSE;
+        mg->mg_tuplelist->mgtl_replay = -1;
 
         su_pa_do_get(mg->mg_readstream_pa, i, readstream) {
 
@@ -574,9 +723,8 @@ static int mgtl_addfromstream(
  * 
  *		mgtl_add
  * 
- * Adds a new item into merge tuplelist.
- * The stream index is stored because it is the information returned
- * when the first item is selected by mgtl_select.
+ * Sets the current tuple of a stream into its leaf in the merge
+ * tuplelist. The tree is updated at the next mgtl_select.
  * 
  */
 static void mgtl_add(
@@ -585,46 +733,18 @@ static void mgtl_add(
             size_t datalen,
             int stream_index
 ) {
-
-        mgitem_t* p_newmgitem;
-        mgitem_t** pp_mgitem;
-        size_t pos;
+        mgitem_t* mgitem;
 
         ss_dassert(data != NULL);
         ss_dassert(datalen != 0);
         ss_dassert(stream_index >= 0);
+        ss_dassert((uint)stream_index < mg->mg_tuplelist->mgtl_size);
 
-        p_newmgitem = SSMEM_NEW(mgitem_t);
-        p_newmgitem->mgi_data = data;
-        p_newmgitem->mgi_datalen = datalen;
-        p_newmgitem->mgi_stream_index = stream_index;
-
-        ss_dassert(mg->mg_tuplelist->mgtl_1st > 0);
-        if (mg->mg_tuplelist->mgtl_1st >= mg->mg_tuplelist->mgtl_size) {
-            ss_dassert(mg->mg_tuplelist->mgtl_1st == mg->mg_tuplelist->mgtl_size);
-            mg->mg_tuplelist->mgtl_1st--;
-            mg->mg_tuplelist->mgtl_array[mg->mg_tuplelist->mgtl_1st] =
-                p_newmgitem;
-        } else {
-            (void)su_bsearch_ctx(
-                    data,
-                    mg->mg_tuplelist->mgtl_array + mg->mg_tuplelist->mgtl_1st,
-                    mg->mg_tuplelist->mgtl_size - mg->mg_tuplelist->mgtl_1st,
-                    sizeof(mgitem_t*),
-                    (su_bsearch_ctxcmpfuncptr_t)mgi_cmp,
-                    mg,
-                    (void**)&pp_mgitem);
-            pos = pp_mgitem - mg->mg_tuplelist->mgtl_array;
-            if (pos > mg->mg_tuplelist->mgtl_1st) {
-                memmove(
-                    mg->mg_tuplelist->mgtl_array + mg->mg_tuplelist->mgtl_1st - 1,
-                    mg->mg_tuplelist->mgtl_array + mg->mg_tuplelist->mgtl_1st,
-                    sizeof(mgitem_t*) * (pos - mg->mg_tuplelist->mgtl_1st));
-            }
-            mg->mg_tuplelist->mgtl_1st--;
-            pp_mgitem--;
-            *pp_mgitem = p_newmgitem;
-        }
+        mgitem = &mg->mg_tuplelist->mgtl_leaves[stream_index];
+        ss_dassert(!mgitem->mgi_valid);
+        mgitem->mgi_data = data;
+        mgitem->mgi_datalen = datalen;
+        mgitem->mgi_valid = TRUE;
 }
 
 
@@ -633,7 +753,9 @@ static void mgtl_add(
  *		mgtl_select
  * 
  *  Returns the stream index of first tuple in mergelist.
- *  Removes the corresponding tuple from list and frees the memory. 
+ *  Removes the corresponding tuple from the list. The leaf of the
+ *  returned stream is replayed at the next call, after the caller
+ *  has added the next tuple from the stream.
  * 
  * Parameters : 
  * 
@@ -662,22 +784,31 @@ static int  mgtl_select(
         void** p_data,
         size_t* p_datalen
 ) {
-        mgitem_t* p_mgitem;
-        int       retval = -1;
-
-        ss_dprintf_3(("mgtl_select:mgtl_1st=%d < mgtl_size=%d\n",
-            mg->mg_tuplelist->mgtl_1st, mg->mg_tuplelist->mgtl_size));
-
-        if (mg->mg_tuplelist->mgtl_1st < mg->mg_tuplelist->mgtl_size) {
-            p_mgitem = mg->mg_tuplelist->mgtl_array[
-                            mg->mg_tuplelist->mgtl_1st];
-            mg->mg_tuplelist->mgtl_1st++;
-            retval = p_mgitem->mgi_stream_index;
-            *p_data = p_mgitem->mgi_data;
-            *p_datalen = p_mgitem->mgi_datalen;
-            SsMemFree(p_mgitem);
+        mgtuplelist_t* tl = mg->mg_tuplelist;
+        mgitem_t* mgitem;
+        int winner;
+
+        if (!tl->mgtl_built) {
+            mgtl_build(mg);
+            tl->mgtl_built = TRUE;
+        } else if (tl->mgtl_replay >= 0) {
+            mgtl_replay(mg, tl->mgtl_replay);
+        }
+        tl->mgtl_replay = -1;
+
+        winner = tl->mgtl_tree[0];
+        mgitem = &tl->mgtl_leaves[winner];
+
+        ss_dprintf_3(("mgtl_select:winner=%d, valid=%d\n", winner, mgitem->mgi_valid));
+
+        if (!mgitem->mgi_valid) {
+            return(-1);
         }
-        return(retval);
+        *p_data = mgitem->mgi_data;
+        *p_datalen = mgitem->mgi_datalen;
+        mgitem->mgi_valid = FALSE;
+        tl->mgtl_replay = winner;
+        return(winner);
 }
 
 /*##**********************************************************************\
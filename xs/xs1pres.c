@@ -48,6 +48,11 @@ Preconditions:
 Multithread considerations:
 --------------------------
 
+When xs_presorter_nthreads allows more than one thread, a large presort
+buffer is split into equal parts at flush. Worker threads sort the parts
+in parallel and the parts are merged into one run while writing to the
+stream. The workers are started at the first parallel flush and they
+only touch their own part of the tuple pointer array.
 
 Example:
 -------
@@ -59,12 +64,16 @@ Example:
 #include <ssc.h>
 #include <ssdebug.h>
 #include <sslimits.h>
+#include <sssem.h>
+#include <ssthread.h>
+#include <ssenv.h>
 
 #include <su0error.h>
 #include <su0parr.h>
 #include "xs2tupl.h"
 #include "xs0qsort.h"
 #include "xs2cmp.h"
+#include <uti0vcmp.h>
 #include "xs1pres.h"
 #include "xs0type.h"
 
@@ -82,6 +91,38 @@ Example:
 
 #endif /* 0 */
 
+/* Max number of threads sorting one presort buffer. */
+#define PS_MAXTHREADS       8
+
+/* Min number of tuples per thread before the buffer is sorted in
+ * parallel.
+ */
+#define PS_MINPARTUPLES     4096
+
+typedef struct {
+        xs_presorter_t*     pw_presorter;
+        SsMesT*             pw_startmes;
+        size_t              pw_start;
+        size_t              pw_n;
+        bool                pw_threadp;
+} ps_worker_t;
+
+/* Sort item with a fixed width prefix of the first ORDER BY column.
+ * The prefix bytes are stored as two big-endian 32-bit words, with
+ * descending order pre-inverted, so that comparing the words gives
+ * the same order as vtpl_condcompare for the first column whenever
+ * the prefixes differ. Full comparison is needed only on ties.
+ */
+typedef struct {
+        ss_uint4_t          si_prefix[2];
+        vtpl_t*             si_vtpl;
+} ps_sortitem_t;
+
+/* Number of threads used to sort one presort buffer, 0 means the
+ * number of processors. Set from the Sorter section of the inifile.
+ */
+uint xs_presorter_nthreads = 1;
+
 struct xs_presorter_st {
         xs_streamarr_t*     ps_streamarr;
         char**              ps_bufarr;
@@ -102,9 +143,488 @@ struct xs_presorter_st {
         su_pa_t*            ps_tuplearray;
         xs_mem_t*           ps_memmgr;
         xs_qcomparefp_t     ps_comp_fp;
+
+        /* Prefix key sort. */
+        bool                ps_prefixp;
+        bool                ps_prefixdesc;
+        ps_sortitem_t*      ps_sortitems;
+        size_t              ps_sortitemsize;
+        void**              ps_sortarr;
+
+        /* Parallel sort of the presort buffer. */
+        uint                ps_nthreads;
+        uint                ps_nworkers;
+        ps_worker_t*        ps_workers;
+        SsSemT*             ps_sem;
+        SsMesT*             ps_donemes;
+        uint                ps_nbusy;
+        bool                ps_stop;
 };
 
 
+/*#***********************************************************************\
+ * 
+ *		presorter_makeprefix
+ * 
+ * Builds the prefix of the first ORDER BY column of a tuple. Bytes
+ * after the end of the column are padded so that a shorter value
+ * sorts before a longer value with the same start, as in
+ * vtpl_condcompare.
+ * 
+ * Parameters : 
+ * 
+ *	presorter - in, use
+ *		pointer to presorter
+ *		
+ *	vtpl - in, use
+ *		tuple
+ *		
+ *	prefix - out
+ *		prefix words
+ *		
+ * Return value : 
+ * 
+ * Comments : 
+ * 
+ * Globals used : 
+ * 
+ * See also : 
+ */
+static void presorter_makeprefix(
+        xs_presorter_t* presorter,
+        vtpl_t* vtpl,
+        ss_uint4_t* prefix)
+{
+        va_t* va;
+        ss_byte_t* p;
+        va_index_t l;
+        va_index_t i;
+        ss_byte_t b;
+        ss_byte_t pad;
+        ss_uint4_t w[2];
+
+        va = (va_t*)va_getdata((va_t*)vtpl, &l);
+        p = (ss_byte_t*)va_getdata(va, &l);
+
+        pad = presorter->ps_prefixdesc ? 0xff : 0x00;
+        w[0] = w[1] = 0;
+        for (i = 0; i < 8; i++) {
+            if (i < l) {
+                b = presorter->ps_prefixdesc ? (ss_byte_t)~p[i] : p[i];
+            } else {
+                b = pad;
+            }
+            w[i / 4] = (w[i / 4] << 8) | b;
+        }
+        prefix[0] = w[0];
+        prefix[1] = w[1];
+}
+
+/*#***********************************************************************\
+ * 
+ *		presorter_prefixcmp
+ * 
+ * Compares two sort items, first using the prefix words and then
+ * the full tuples if the prefixes are equal.
+ * 
+ * Parameters : 
+ * 
+ *	si1 - in, use
+ *		sort item
+ *		
+ *	si2 - in, use
+ *		sort item
+ *		
+ *	presorter - in, use
+ *		pointer to presorter
+ *		
+ * Return value : 
+ *      < 0, == 0 or > 0 like vtpl_condcompare
+ * 
+ * Comments : 
+ * 
+ * Globals used : 
+ * 
+ * See also : 
+ */
+static int presorter_prefixcmp(
+        ps_sortitem_t* si1,
+        ps_sortitem_t* si2,
+        xs_presorter_t* presorter)
+{
+        if (si1->si_prefix[0] != si2->si_prefix[0]) {
+            return (si1->si_prefix[0] < si2->si_prefix[0] ? -1 : 1);
+        }
+        if (si1->si_prefix[1] != si2->si_prefix[1]) {
+            return (si1->si_prefix[1] < si2->si_prefix[1] ? -1 : 1);
+        }
+        return ((*presorter->ps_comp_fp)(
+                    &si1->si_vtpl,
+                    &si2->si_vtpl,
+                    presorter->ps_cmpcondarr));
+}
+
+/*#***********************************************************************\
+ * 
+ *		presorter_cmpat
+ * 
+ * Compares two tuples in the sort array by index.
+ * 
+ * Parameters : 
+ * 
+ *	presorter - in, use
+ *		pointer to presorter
+ *		
+ *	i1 - in
+ *		index of first tuple
+ *		
+ *	i2 - in
+ *		index of second tuple
+ *		
+ * Return value : 
+ *      < 0, == 0 or > 0
+ * 
+ * Comments : 
+ * 
+ * Globals used : 
+ * 
+ * See also : 
+ */
+static int presorter_cmpat(
+        xs_presorter_t* presorter,
+        size_t i1,
+        size_t i2)
+{
+        if (presorter->ps_prefixp) {
+            return (presorter_prefixcmp(
+                        &presorter->ps_sortitems[i1],
+                        &presorter->ps_sortitems[i2],
+                        presorter));
+        } else {
+            return ((*presorter->ps_comp_fp)(
+                        &presorter->ps_sortarr[i1],
+                        &presorter->ps_sortarr[i2],
+                        presorter->ps_cmpcondarr));
+        }
+}
+
+/*#***********************************************************************\
+ * 
+ *		presorter_sortpart
+ * 
+ * Sorts a part of the tuple pointer array. With prefix keys the
+ * sort items of the part are built and sorted, and the sorted
+ * order is copied back to the tuple pointer array.
+ * 
+ * Parameters : 
+ * 
+ *	presorter - in out, use
+ *		pointer to presorter
+ *		
+ *	start - in
+ *		start index of the part
+ *		
+ *	n - in
+ *		number of tuples in the part
+ *		
+ * Return value : 
+ * 
+ * Comments : 
+ * 
+ *      Can be called from several threads at the same time for
+ *      different parts.
+ * 
+ * Globals used : 
+ * 
+ * See also : 
+ */
+static void presorter_sortpart(
+        xs_presorter_t* presorter,
+        size_t start,
+        size_t n)
+{
+        void** arr = presorter->ps_sortarr + start;
+        ps_sortitem_t* items;
+        size_t i;
+
+        if (!presorter->ps_prefixp) {
+            xs_qsort(
+                arr,
+                n,
+                sizeof(void*),
+                presorter->ps_comp_fp,
+                presorter->ps_cmpcondarr);
+            return;
+        }
+        items = presorter->ps_sortitems + start;
+        for (i = 0; i < n; i++) {
+            items[i].si_vtpl = arr[i];
+            presorter_makeprefix(presorter, arr[i], items[i].si_prefix);
+        }
+        xs_qsort(
+            items,
+            n,
+            sizeof(ps_sortitem_t),
+            (xs_qcomparefp_t)presorter_prefixcmp,
+            presorter);
+        for (i = 0; i < n; i++) {
+            arr[i] = items[i].si_vtpl;
+        }
+}
+
+/*#***********************************************************************\
+ * 
+ *		presorter_workerthread
+ * 
+ * Worker thread that sorts one part of the presort buffer each time
+ * it is started.
+ * 
+ * Parameters : 
+ * 
+ *	data - in, use
+ *		worker object
+ *		
+ * Return value : 
+ * 
+ * Comments : 
+ * 
+ * Globals used : 
+ * 
+ * See also : 
+ */
+static void SS_CALLBACK presorter_workerthread(void* data)
+{
+        ps_worker_t* w = data;
+        xs_presorter_t* presorter = w->pw_presorter;
+
+        for (;;) {
+            SsMesWait(w->pw_startmes);
+            if (presorter->ps_stop) {
+                break;
+            }
+            presorter_sortpart(presorter, w->pw_start, w->pw_n);
+            SsSemEnter(presorter->ps_sem);
+            ss_dassert(presorter->ps_nbusy > 0);
+            presorter->ps_nbusy--;
+            if (presorter->ps_nbusy == 0) {
+                SsMesSend(presorter->ps_donemes);
+            }
+            SsSemExit(presorter->ps_sem);
+        }
+
+        SsSemEnter(presorter->ps_sem);
+        w->pw_threadp = FALSE;
+        SsMesSend(presorter->ps_donemes);
+        SsSemExit(presorter->ps_sem);
+
+#if (defined(SS_MYSQL) || defined(SS_MYSQL_AC)) && defined(MYSQL_DYNAMIC_PLUGIN)
+        return;
+#else
+        SsThrExit();
+#endif
+}
+
+/*#***********************************************************************\
+ * 
+ *		presorter_startworkers
+ * 
+ * Starts the worker threads for parallel presort. Called at the first
+ * flush that is large enough to be sorted in parallel.
+ * 
+ * Parameters : 
+ * 
+ *	presorter - in out, use
+ *		pointer to presorter
+ *		
+ * Return value : 
+ * 
+ * Comments : 
+ * 
+ * Globals used : 
+ * 
+ * See also : 
+ */
+static void presorter_startworkers(
+        xs_presorter_t* presorter)
+{
+        uint i;
+
+        ss_dassert(presorter->ps_workers == NULL);
+        ss_dassert(presorter->ps_nthreads > 1);
+
+        presorter->ps_sem = SsSemCreateLocal(SS_SEMNUM_XS_PRESORT);
+        presorter->ps_donemes = SsMesCreateLocal();
+        presorter->ps_workers = SsMemAlloc(
+                                    sizeof(ps_worker_t) *
+                                    (presorter->ps_nthreads - 1));
+
+        for (i = 0; i < presorter->ps_nthreads - 1; i++) {
+            ps_worker_t* w = &presorter->ps_workers[i];
+            SsThreadT* thr;
+
+            w->pw_presorter = presorter;
+            w->pw_startmes = SsMesCreateLocal();
+            w->pw_start = 0;
+            w->pw_n = 0;
+            w->pw_threadp = TRUE;
+            presorter->ps_nworkers++;
+
+            thr = SsThrInitParam(
+                    presorter_workerthread,
+                    "presorter_workerthread",
+                    64 * 1024,
+                    w);
+            SsThrEnable(thr);
+            SsThrDone(thr);
+        }
+        ss_dprintf_1(("presorter_startworkers:%d workers\n", presorter->ps_nworkers));
+}
+
+/*#***********************************************************************\
+ * 
+ *		presorter_stopworkers
+ * 
+ * Stops the worker threads and waits until they have exited.
+ * 
+ * Parameters : 
+ * 
+ *	presorter - in out, use
+ *		pointer to presorter
+ *		
+ * Return value : 
+ * 
+ * Comments : 
+ * 
+ * Globals used : 
+ * 
+ * See also : 
+ */
+static void presorter_stopworkers(
+        xs_presorter_t* presorter)
+{
+        uint i;
+
+        ss_dassert(presorter->ps_nbusy == 0);
+
+        presorter->ps_stop = TRUE;
+
+        for (i = 0; i < presorter->ps_nworkers; i++) {
+            ps_worker_t* w = &presorter->ps_workers[i];
+
+            SsMesSend(w->pw_startmes);
+            SsSemEnter(presorter->ps_sem);
+            while (w->pw_threadp) {
+                SsSemExit(presorter->ps_sem);
+                SsMesWait(presorter->ps_donemes);
+                SsSemEnter(presorter->ps_sem);
+            }
+            SsSemExit(presorter->ps_sem);
+            SsMesFree(w->pw_startmes);
+        }
+        SsMemFree(presorter->ps_workers);
+        presorter->ps_workers = NULL;
+        presorter->ps_nworkers = 0;
+        SsMesFree(presorter->ps_donemes);
+        SsSemFree(presorter->ps_sem);
+}
+
+/*#***********************************************************************\
+ * 
+ *		presorter_parsort
+ * 
+ * Sorts the tuple pointer array ps_sortarr in nparts parts. Parts 1..nparts-1
+ * are sorted by worker threads and part 0 by the calling thread.
+ * 
+ * Parameters : 
+ * 
+ *	presorter - in out, use
+ *		pointer to presorter
+ *		
+ *	partstart - in, use
+ *		start index of each part, partstart[nparts] is the
+ *          number of tuples
+ *		
+ *	nparts - in
+ *		number of parts
+ *		
+ * Return value : 
+ * 
+ * Comments : 
+ * 
+ * Globals used : 
+ * 
+ * See also : 
+ */
+static void presorter_parsort(
+        xs_presorter_t* presorter,
+        size_t* partstart,
+        uint nparts)
+{
+        uint i;
+
+        ss_dassert(nparts - 1 <= presorter->ps_nworkers);
+
+        SsSemEnter(presorter->ps_sem);
+        presorter->ps_nbusy = nparts - 1;
+        SsSemExit(presorter->ps_sem);
+
+        for (i = 1; i < nparts; i++) {
+            ps_worker_t* w = &presorter->ps_workers[i - 1];
+
+            w->pw_start = partstart[i];
+            w->pw_n = partstart[i + 1] - partstart[i];
+            SsMesSend(w->pw_startmes);
+        }
+
+        presorter_sortpart(presorter, 0, partstart[1]);
+
+        SsSemEnter(presorter->ps_sem);
+        while (presorter->ps_nbusy > 0) {
+            SsSemExit(presorter->ps_sem);
+            SsMesWait(presorter->ps_donemes);
+            SsSemEnter(presorter->ps_sem);
+        }
+        SsSemExit(presorter->ps_sem);
+}
+
+/*#***********************************************************************\
+ * 
+ *		presorter_append
+ * 
+ * Appends a tuple to the output stream.
+ * 
+ * Parameters : 
+ * 
+ *	stream - in out, use
+ *		output stream
+ *		
+ *	vtpl - in, use
+ *		tuple
+ *		
+ *      p_errh - out, give
+ *          error handle
+ *
+ * Return value : 
+ *      TRUE when successful
+ *      FALSE when failed
+ * 
+ * Comments : 
+ * 
+ * Globals used : 
+ * 
+ * See also : 
+ */
+static bool presorter_append(
+        xs_stream_t* stream,
+        vtpl_t* vtpl,
+        rs_err_t** p_errh)
+{
+        vtpl_index_t vtpl_size;
+
+        vtpl_size = vtpl_grosslen(vtpl) + va_lenlen((va_t*)vtpl);
+        return (xs_stream_append(stream, vtpl, vtpl_size, p_errh));
+}
+
 /*##**********************************************************************\
  * 
  *		xs_presorter_init
@@ -161,6 +681,8 @@ xs_presorter_t* xs_presorter_init(
         xs_presorter_t* presorter;
 
         presorter = SSMEM_NEW(xs_presorter_t);
+        presorter->ps_workers = NULL;
+        presorter->ps_sortitems = NULL;
         presorter->ps_memmgr = memmgr;
         presorter->ps_streamarr = streamarr;
         presorter->ps_nbuf = nbuf;
@@ -199,6 +721,35 @@ xs_presorter_t* xs_presorter_init(
         presorter->ps_ntuples = 0;
         presorter->ps_comp_fp = comp_fp;
 
+        presorter->ps_nthreads = xs_presorter_nthreads;
+        if (presorter->ps_nthreads == 0) {
+            presorter->ps_nthreads = SsEnvNumProcessors();
+        }
+        if (presorter->ps_nthreads > PS_MAXTHREADS) {
+            presorter->ps_nthreads = PS_MAXTHREADS;
+        }
+        /* The prefix key gives the same order as vtpl_condcompare
+         * only for the SQL compare function. NULLs to start in
+         * descending order are not inverted by it, so those sorts
+         * use the full compare.
+         */
+        presorter->ps_prefixp =
+            comp_fp == (xs_qcomparefp_t)xs_qsort_cmp
+            && cmpcondarr != NULL
+            && cmpcondarr[0] > 0
+            && cmpcondarr[1] != VTPL_CMP_DESC_NC_START;
+        presorter->ps_prefixdesc =
+            presorter->ps_prefixp && cmpcondarr[1] == VTPL_CMP_DESC;
+        presorter->ps_sortitems = NULL;
+        presorter->ps_sortitemsize = 0;
+        presorter->ps_sortarr = NULL;
+        presorter->ps_nworkers = 0;
+        presorter->ps_workers = NULL;
+        presorter->ps_sem = NULL;
+        presorter->ps_donemes = NULL;
+        presorter->ps_nbusy = 0;
+        presorter->ps_stop = FALSE;
+
         ss_dassert(presorter != NULL);
         ss_dassert(presorter->ps_bufarr != NULL);
         ss_dassert(presorter->ps_anomap != NULL);
@@ -238,6 +789,9 @@ void xs_presorter_done(
         ss_dassert(presorter->ps_bufarr != NULL);
         ss_dassert(presorter->ps_tuplearray != NULL);
 
+        if (presorter->ps_workers != NULL) {
+            presorter_stopworkers(presorter);
+        }
         succp = xs_mem_reserveonfree(
                     presorter->ps_memmgr,
                     presorter->ps_nbuf);
@@ -245,6 +799,9 @@ void xs_presorter_done(
         for (i = 0; i < presorter->ps_nbuf; i++) {
             xs_mem_free(presorter->ps_memmgr, presorter->ps_hmemarr[i]);
         }
+        if (presorter->ps_sortitems != NULL) {
+            SsMemFree(presorter->ps_sortitems);
+        }
         SsMemFree(presorter->ps_hmemarr);
         SsMemFree(presorter->ps_bufarr);
         su_pa_done(presorter->ps_tuplearray);
@@ -284,7 +841,10 @@ bool xs_presorter_flush(
         vtpl_t* vtpl;
         bool succp = TRUE;
         xs_stream_t* stream;
-        vtpl_index_t vtpl_size;
+        void** arr;
+        uint nparts;
+        size_t partstart[PS_MAXTHREADS + 1];
+        size_t partpos[PS_MAXTHREADS];
 
         ss_dassert(presorter != NULL);
         ss_dassert(presorter->ps_bufarr != NULL);
@@ -296,25 +856,76 @@ bool xs_presorter_flush(
         if (presorter->ps_ntuples == 0) {
             return (TRUE);
         }
-        if (presorter->ps_ntuples > 1) {
-            xs_qsort(
-                su_pa_datastart(presorter->ps_tuplearray),
-                presorter->ps_ntuples,
-                sizeof(void*),
-                presorter->ps_comp_fp,
-                presorter->ps_cmpcondarr);
+        arr = su_pa_datastart(presorter->ps_tuplearray);
+        presorter->ps_sortarr = arr;
+        if (presorter->ps_prefixp
+            && presorter->ps_sortitemsize < presorter->ps_ntuples)
+        {
+            if (presorter->ps_sortitems != NULL) {
+                SsMemFree(presorter->ps_sortitems);
+            }
+            presorter->ps_sortitemsize = presorter->ps_ntuples;
+            presorter->ps_sortitems = SsMemAlloc(
+                                        sizeof(ps_sortitem_t) *
+                                        presorter->ps_sortitemsize);
+        }
+
+        nparts = presorter->ps_ntuples / PS_MINPARTUPLES;
+        if (nparts > presorter->ps_nthreads) {
+            nparts = presorter->ps_nthreads;
+        }
+        if (nparts > 1 && presorter->ps_workers == NULL) {
+            presorter_startworkers(presorter);
+        }
+        if (nparts > presorter->ps_nworkers + 1) {
+            nparts = presorter->ps_nworkers + 1;
+        }
+
+        if (nparts > 1) {
+            for (i = 0; i < nparts; i++) {
+                partstart[i] = (size_t)((ulong)presorter->ps_ntuples * i / nparts);
+                partpos[i] = partstart[i];
+            }
+            partstart[nparts] = presorter->ps_ntuples;
+            presorter_parsort(presorter, partstart, nparts);
+        } else if (presorter->ps_ntuples > 1) {
+            presorter_sortpart(presorter, 0, presorter->ps_ntuples);
         }
         stream = xs_streamarr_nextstream(presorter->ps_streamarr);
         if (stream == NULL) {
             succp = FALSE;
+        } else if (nparts > 1) {
+            /* Merge the sorted parts into one run. The number of
+             * parts is small, so the smallest head is found by
+             * a linear scan.
+             */
+            for (;;) {
+                int minpart = -1;
+
+                for (i = 0; i < nparts; i++) {
+                    if (partpos[i] < partstart[i + 1]
+                        && (minpart < 0
+                            || presorter_cmpat(
+                                    presorter,
+                                    partpos[i],
+                                    partpos[minpart]) < 0))
+                    {
+                        minpart = i;
+                    }
+                }
+                if (minpart < 0) {
+                    break;
+                }
+                vtpl = arr[partpos[minpart]];
+                partpos[minpart]++;
+                succp = presorter_append(stream, vtpl, p_errh);
+                if (!succp) {
+                    break;
+                }
+            }
         } else {
             su_pa_do_get(presorter->ps_tuplearray, i, vtpl) {
-                vtpl_size = vtpl_grosslen(vtpl) + va_lenlen((va_t*)vtpl);
-                succp = xs_stream_append(
-                            stream,
-                            vtpl,
-                            vtpl_size,
-                            p_errh);
+                succp = presorter_append(stream, vtpl, p_errh);
                 if (!succp) {
                     break;
                 }
@@ -88,6 +88,7 @@ struct xs_tfdir_st {
 struct xs_tfmgr_st {
         size_t      tfm_blocksize;
         int         tfm_openflags;
+        uint        tfm_seqnblocks; /* extent size in blocks */
         su_bmap_t*  tfm_bitmap;/* [tfm_maxfiles] */
         ulong       tfm_maxfiles;
         su_pa_t*    tfm_tfdirs;
@@ -905,6 +906,7 @@ bool xs_tf_open(xs_tf_t* tf)
         ss_dassert(hmem != NULL);
 
         su_vmem_addbuffers(tf->tf_file, 1, &p);
+        su_vmem_setseqbuf(tf->tf_file, tf->tf_tfmgr->tfm_seqnblocks);
         su_pa_insertat(tf->tf_hmemarr, 0, hmem);
         ss_dassert(su_pa_nelems(tf->tf_hmemarr) == 1);
 
@@ -1553,6 +1555,13 @@ bool xs_tf_opencursor(xs_tf_t* tf)
  *      dbid - in
  *          database id #
  *
+ *      openflags - in
+ *          file open flags ored together from SS_BF_XXX
+ *
+ *      seqiosize - in
+ *          size in bytes of the extents in which the temporary files
+ *          are written and read, 0 means one block at a time
+ *
  * Return value - give :
  *      created tfmgr object
  * 
@@ -1566,7 +1575,8 @@ xs_tfmgr_t* xs_tfmgr_init(
         ulong maxfiles,
         xs_mem_t* memmgr,
         ulong dbid,
-        int openflags)
+        int openflags,
+        size_t seqiosize)
 {
         xs_tfmgr_t* tfmgr;
 
@@ -1574,6 +1584,7 @@ xs_tfmgr_t* xs_tfmgr_init(
         tfmgr = SSMEM_NEW(xs_tfmgr_t);
         tfmgr->tfm_blocksize = xs_mem_getblocksize(memmgr);
         tfmgr->tfm_openflags = openflags;
+        tfmgr->tfm_seqnblocks = (uint)(seqiosize / tfmgr->tfm_blocksize);
         tfmgr->tfm_maxfiles = maxfiles;
         tfmgr->tfm_bitmap = SU_BMAP_INIT(tfmgr->tfm_maxfiles, FALSE);
         tfmgr->tfm_tfdirs = su_pa_init();